@@ -0,0 +1,21 @@
+/**
+ * @file auto_tune.hpp
+ *
+ * Include only the optimizers of
+ * ensmallen_bits/auto_tune/auto_tune.hpp and what they depend on,
+ * instead of all of ensmallen.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_INCLUDE_AUTO_TUNE_HPP
+#define ENSMALLEN_INCLUDE_AUTO_TUNE_HPP
+
+#include "core.hpp"
+#include "../ensmallen_bits/auto_tune/auto_tune.hpp"
+
+#include "../ensmallen_bits/extern_templates.hpp"
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file bobyqa.hpp
+ *
+ * Include only the optimizers of ensmallen_bits/bobyqa/bobyqa.hpp and what they
+ * depend on, instead of all of ensmallen.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_INCLUDE_BOBYQA_HPP
+#define ENSMALLEN_INCLUDE_BOBYQA_HPP
+
+#include "core.hpp"
+#include "../ensmallen_bits/bobyqa/bobyqa.hpp"
+
+#include "../ensmallen_bits/extern_templates.hpp"
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file cne.hpp
+ *
+ * Include only the optimizers of ensmallen_bits/cne/cne.hpp and what they
+ * depend on, instead of all of ensmallen.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_INCLUDE_CNE_HPP
+#define ENSMALLEN_INCLUDE_CNE_HPP
+
+#include "core.hpp"
+#include "../ensmallen_bits/cne/cne.hpp"
+
+#include "../ensmallen_bits/extern_templates.hpp"
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file core.hpp
+ *
+ * The part of ensmallen that every optimizer needs: configuration, logging,
+ * callbacks and the function type machinery.  Include this (through one of the
+ * per-optimizer headers in this directory) instead of ensmallen.hpp to only
+ * compile the optimizers that are used.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CORE_HPP
+#define ENSMALLEN_CORE_HPP
+
+// certain compilers are way behind the curve
+#if (defined(_MSVC_LANG) && (_MSVC_LANG >= 201402L))
+  #undef  ARMA_USE_CXX11
+  #define ARMA_USE_CXX11
+#endif
+
+#include <armadillo>
+
+#if !defined(ARMA_USE_CXX11)
+  // armadillo automatically enables ARMA_USE_CXX11
+  // when a C++11/C++14/C++17/etc compiler is detected
+  #error "please enable C++11/C++14 mode in your compiler"
+#endif
+
+#if ((ARMA_VERSION_MAJOR < 8) || ((ARMA_VERSION_MAJOR == 8) && (ARMA_VERSION_MINOR < 400)))
+  #error "need Armadillo version 8.400 or later"
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <climits>
+#include <cfloat>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <iostream>
+#include <string>
+#include <sstream>
+
+// On Visual Studio, disable C4519 (default arguments for function templates)
+// since it's by default an error, which doesn't even make any sense because
+// it's part of the C++11 standard.
+#ifdef _MSC_VER
+  #pragma warning(disable : 4519)
+#endif
+
+#include "../ensmallen_bits/config.hpp"
+#include "../ensmallen_bits/ens_version.hpp"
+#include "../ensmallen_bits/log.hpp" // TODO: should move to another place
+
+#include "../ensmallen_bits/utility/any.hpp"
+#include "../ensmallen_bits/utility/arma_traits.hpp"
+#include "../ensmallen_bits/utility/fused_updates.hpp"
+
+// Callbacks.
+#include "../ensmallen_bits/callbacks/callbacks.hpp"
+#include "../ensmallen_bits/callbacks/early_stop_at_min_loss.hpp"
+#include "../ensmallen_bits/callbacks/early_stop_at_validation_loss.hpp"
+#include "../ensmallen_bits/callbacks/print_loss.hpp"
+#include "../ensmallen_bits/callbacks/progress_bar.hpp"
+#include "../ensmallen_bits/callbacks/store_best_coordinates.hpp"
+#include "../ensmallen_bits/callbacks/timer_stop.hpp"
+
+#include "../ensmallen_bits/function.hpp"
+#include "../ensmallen_bits/function/memoized_function.hpp"
+#include "../ensmallen_bits/function/numerical_gradient_function.hpp"
+#include "../ensmallen_bits/function/function_base.hpp"
+
+#endif
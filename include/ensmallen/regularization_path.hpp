@@ -0,0 +1,20 @@
+/**
+ * @file regularization_path.hpp
+ *
+ * Include only the regularization path driver (with L-BFGS) and what it
+ * depends on, instead of all of ensmallen.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_INCLUDE_REGULARIZATION_PATH_HPP
+#define ENSMALLEN_INCLUDE_REGULARIZATION_PATH_HPP
+
+#include "core.hpp"
+#include "../ensmallen_bits/regularization_path/regularization_path.hpp"
+
+#include "../ensmallen_bits/extern_templates.hpp"
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file swats.hpp
+ *
+ * Include only the optimizers of ensmallen_bits/swats/swats.hpp and what they
+ * depend on, instead of all of ensmallen.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_INCLUDE_SWATS_HPP
+#define ENSMALLEN_INCLUDE_SWATS_HPP
+
+#include "core.hpp"
+#include "../ensmallen_bits/swats/swats.hpp"
+
+#include "../ensmallen_bits/extern_templates.hpp"
+
+#endif
@@ -3,8 +3,8 @@
  * @author Ryan Curtin
  *
  * Definition of AugLagrangian class, which implements the Augmented Lagrangian
- * optimization method (also called the 'method of multipliers'.  This class
- * uses the L-BFGS optimizer.
+ * optimization method (also called the 'method of multipliers'.  By default
+ * this class uses the L-BFGS optimizer for the inner problems.
  *
  * ensmallen is free software; you may redistribute it and/or modify it under
  * the terms of the 3-clause BSD license.  You should have received a copy of
@@ -18,6 +18,7 @@
 #include <ensmallen_bits/lbfgs/lbfgs.hpp>
 
 #include "aug_lagrangian_function.hpp"
+#include "aug_lagrangian_separable_function.hpp"
 
 namespace ens {
 
@@ -29,12 +30,23 @@ namespace ens {
  * AugLagrangian can optimize constrained functions.  For more details, see the
  * documentation on function types included with this distribution or on the
  * ensmallen website.
+ *
+ * Each iteration minimizes the augmented Lagrangian with the inner optimizer.
+ * If the constrained function is also separable (it has NumFunctions() and the
+ * separable Evaluate() and Gradient() overloads), the augmented Lagrangian is
+ * wrapped in an AugLagrangianSeparableFunction, so that stochastic and
+ * variance-reduced optimizers such as SGD, Adam or SVRG can be used as the
+ * inner optimizer.  In that case the constraint terms can be amortized: they
+ * are then only recomputed every constraintInterval batches.
+ *
+ * @tparam InnerOptimizerType Optimizer for the inner (unconstrained) problems.
  */
-class AugLagrangian
+template<typename InnerOptimizerType>
+class AugLagrangianType
 {
  public:
   /**
-   * Initialize the Augmented Lagrangian with the default L-BFGS optimizer.
+   * Initialize the Augmented Lagrangian with the given inner optimizer.
    * @param penaltyThresholdFactor When the penalty threshold is updated set
    *    the penalty threshold to the penalty multplied by this factor. The
    *    default value of 0.25 is is taken from Burer and Monteiro (2002).
@@ -42,11 +54,17 @@ class AugLagrangian
    *    value. The default value of 10 is taken from Burer and Monteiro (2002).
    * @param maxIterations Maximum number of iterations of the Augmented
    *     Lagrangian algorithm.  0 indicates no maximum.
+   * @param innerOptimizer Optimizer for the inner problems.
+   * @param constraintInterval Number of batches between two evaluations of the
+   *     constraint terms, for separable functions (1 evaluates them for every
+   *     batch).
    */
-  AugLagrangian(const size_t maxIterations = 1000,
-                const double penaltyThresholdFactor = 0.25,
-                const double sigmaUpdateFactor = 10.0,
-                const L_BFGS& lbfgs = L_BFGS());
+  AugLagrangianType(const size_t maxIterations = 1000,
+                    const double penaltyThresholdFactor = 0.25,
+                    const double sigmaUpdateFactor = 10.0,
+                    const InnerOptimizerType& innerOptimizer =
+                        InnerOptimizerType(),
+                    const size_t constraintInterval = 1);
 
   /**
    * Optimize the function.  The value '1' is used for the initial value of each
@@ -127,10 +145,22 @@ class AugLagrangian
         std::forward<CallbackTypes>(callbacks)...);
   }
 
-  //! Get the L-BFGS object used for the actual optimization.
-  const L_BFGS& LBFGS() const { return lbfgs; }
-  //! Modify the L-BFGS object used for the actual optimization.
-  L_BFGS& LBFGS() { return lbfgs; }
+  //! Get the inner optimizer.
+  const InnerOptimizerType& InnerOptimizer() const { return innerOptimizer; }
+  //! Modify the inner optimizer.
+  InnerOptimizerType& InnerOptimizer() { return innerOptimizer; }
+
+  //! Get the inner optimizer (for backwards compatibility, from when the inner
+  //! optimizer was always L-BFGS).
+  const InnerOptimizerType& LBFGS() const { return innerOptimizer; }
+  //! Modify the inner optimizer (for backwards compatibility, from when the
+  //! inner optimizer was always L-BFGS).
+  InnerOptimizerType& LBFGS() { return innerOptimizer; }
+
+  //! Get the number of batches between two evaluations of the constraints.
+  size_t ConstraintInterval() const { return constraintInterval; }
+  //! Modify the number of batches between two evaluations of the constraints.
+  size_t& ConstraintInterval() { return constraintInterval; }
 
   //! Get the Lagrange multipliers.
   const arma::vec& Lambda() const { return lambda; }
@@ -167,8 +197,11 @@ class AugLagrangian
   //! Parameter for updating sigma
   double sigmaUpdateFactor;
 
-  //! The L-BFGS optimizer that we will use.
-  L_BFGS lbfgs;
+  //! The optimizer for the inner problems.
+  InnerOptimizerType innerOptimizer;
+
+  //! The number of batches between two evaluations of the constraints.
+  size_t constraintInterval;
 
   //! Controls early termination of the optimization process.
   bool terminate;
@@ -180,32 +213,40 @@ class AugLagrangian
   double sigma;
 
   /**
-   * Internal optimization function: given an initialized AugLagrangianFunction,
-   * perform the optimization itself.
+   * Internal optimization function: given an initialized AugLagrangianFunction
+   * (or AugLagrangianSeparableFunction), perform the optimization itself.
    */
   template<typename LagrangianFunctionType,
+           typename AugLagrangianFunctionType,
            typename MatType,
            typename GradType,
            typename... CallbackTypes>
-  typename std::enable_if<IsArmaType<GradType>::value, bool>::type
-  Optimize(AugLagrangianFunction<LagrangianFunctionType>& augfunc,
-           MatType& coordinates,
-           CallbackTypes&&... callbacks);
-
-  //! Forward the MatType as GradType.
-  template<typename LagrangianFunctionType,
-           typename MatType,
-           typename... CallbackTypes>
-  bool Optimize(AugLagrangianFunction<LagrangianFunctionType>& function,
-                MatType& coordinates,
-                CallbackTypes&&... callbacks)
+  bool OptimizeInternal(AugLagrangianFunctionType& augfunc,
+                        MatType& coordinates,
+                        CallbackTypes&&... callbacks);
+
+  //! Set the constraint interval of a separable augmented Lagrangian function.
+  template<typename LagrangianFunctionType>
+  static void SetConstraintInterval(
+      AugLagrangianSeparableFunction<LagrangianFunctionType>& augfunc,
+      const size_t interval)
   {
-    return Optimize<LagrangianFunctionType, MatType, MatType,
-        CallbackTypes...>(function, coordinates,
-        std::forward<CallbackTypes>(callbacks)...);
+    augfunc.ConstraintInterval() = interval;
   }
+
+  //! Other augmented Lagrangian functions have no constraint interval.
+  template<typename LagrangianFunctionType>
+  static void SetConstraintInterval(
+      AugLagrangianFunction<LagrangianFunctionType>& /* augfunc */,
+      const size_t /* interval */) { }
 };
 
+/**
+ * The default Augmented Lagrangian optimizer, which solves the inner problems
+ * with L-BFGS.
+ */
+using AugLagrangian = AugLagrangianType<L_BFGS>;
+
 } // namespace ens
 
 #include "aug_lagrangian_impl.hpp"
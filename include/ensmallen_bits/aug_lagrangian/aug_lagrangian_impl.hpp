@@ -16,72 +16,90 @@
 #include <ensmallen_bits/lbfgs/lbfgs.hpp>
 #include <ensmallen_bits/function.hpp>
 #include "aug_lagrangian_function.hpp"
+#include "aug_lagrangian_separable_function.hpp"
 
 namespace ens {
 
-inline AugLagrangian::AugLagrangian(const size_t maxIterations,
-                                    const double penaltyThresholdFactor,
-                                    const double sigmaUpdateFactor,
-                                    const L_BFGS& lbfgs) :
+template<typename InnerOptimizerType>
+AugLagrangianType<InnerOptimizerType>::AugLagrangianType(
+    const size_t maxIterations,
+    const double penaltyThresholdFactor,
+    const double sigmaUpdateFactor,
+    const InnerOptimizerType& innerOptimizer,
+    const size_t constraintInterval) :
     maxIterations(maxIterations),
     penaltyThresholdFactor(penaltyThresholdFactor),
     sigmaUpdateFactor(sigmaUpdateFactor),
-    lbfgs(lbfgs),
+    innerOptimizer(innerOptimizer),
+    constraintInterval(constraintInterval),
     terminate(false)
 {
 }
 
+template<typename InnerOptimizerType>
 template<typename LagrangianFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value, bool>::type
-AugLagrangian::Optimize(LagrangianFunctionType& function,
-                        MatType& coordinates,
-                        const arma::vec& initLambda,
-                        const double initSigma,
-                        CallbackTypes&&... callbacks)
+AugLagrangianType<InnerOptimizerType>::Optimize(
+    LagrangianFunctionType& function,
+    MatType& coordinates,
+    const arma::vec& initLambda,
+    const double initSigma,
+    CallbackTypes&&... callbacks)
 {
   lambda = initLambda;
   sigma = initSigma;
 
-  AugLagrangianFunction<LagrangianFunctionType> augfunc(function,
-      lambda, sigma);
-
-  return Optimize(augfunc, coordinates, callbacks...);
+  return Optimize<LagrangianFunctionType, MatType, GradType>(function,
+      coordinates, std::forward<CallbackTypes>(callbacks)...);
 }
 
+template<typename InnerOptimizerType>
 template<typename LagrangianFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
 typename std::enable_if<IsArmaType<GradType>::value, bool>::type
-AugLagrangian::Optimize(LagrangianFunctionType& function,
-                        MatType& coordinates,
-                        CallbackTypes&&... callbacks)
+AugLagrangianType<InnerOptimizerType>::Optimize(
+    LagrangianFunctionType& function,
+    MatType& coordinates,
+    CallbackTypes&&... callbacks)
 {
+  // Separable functions are wrapped so that they can be optimized with
+  // stochastic inner optimizers.
+  typedef typename AugLagrangianFunctionSelector<LagrangianFunctionType>::Type
+      AugLagrangianFunctionType;
+
   // If the user did not specify the right size for sigma and lambda, we will
   // use defaults.
   if (!lambda.is_empty())
   {
-    AugLagrangianFunction<LagrangianFunctionType> augfunc(function, lambda,
-        sigma);
-    return Optimize(augfunc, coordinates, callbacks...);
+    AugLagrangianFunctionType augfunc(function, lambda, sigma);
+    SetConstraintInterval(augfunc, constraintInterval);
+    return OptimizeInternal<LagrangianFunctionType, AugLagrangianFunctionType,
+        MatType, GradType>(augfunc, coordinates,
+        std::forward<CallbackTypes>(callbacks)...);
   }
   else
   {
-    AugLagrangianFunction<LagrangianFunctionType> augfunc(function);
-    return Optimize(augfunc, coordinates, callbacks...);
+    AugLagrangianFunctionType augfunc(function);
+    SetConstraintInterval(augfunc, constraintInterval);
+    return OptimizeInternal<LagrangianFunctionType, AugLagrangianFunctionType,
+        MatType, GradType>(augfunc, coordinates,
+        std::forward<CallbackTypes>(callbacks)...);
   }
 }
 
+template<typename InnerOptimizerType>
 template<typename LagrangianFunctionType,
+         typename AugLagrangianFunctionType,
          typename MatType,
          typename GradType,
          typename... CallbackTypes>
-typename std::enable_if<IsArmaType<GradType>::value, bool>::type
-AugLagrangian::Optimize(
-    AugLagrangianFunction<LagrangianFunctionType>& augfunc,
+bool AugLagrangianType<InnerOptimizerType>::OptimizeInternal(
+    AugLagrangianFunctionType& augfunc,
     MatType& coordinatesIn,
     CallbackTypes&&... callbacks)
 {
@@ -131,9 +149,7 @@ AugLagrangian::Optimize(
     Info << "AugLagrangian on iteration " << it
         << ", starting with objective "  << lastObjective << "." << std::endl;
 
-    if (!lbfgs.Optimize(augfunc, coordinates, callbacks...))
-      Info << "L-BFGS reported an error during optimization."
-          << std::endl;
+    innerOptimizer.Optimize(augfunc, coordinates, callbacks...);
 
     const ElemType objective = function.Evaluate(coordinates);
 
@@ -202,6 +218,11 @@ AugLagrangian::Optimize(
         callbacks...);
   }
 
+  // Keep the final multipliers and penalty so that the optimization can be
+  // warm started from them.
+  lambda = std::move(augfunc.Lambda());
+  sigma = augfunc.Sigma();
+
   Callback::EndOptimization(*this, function, coordinates, callbacks...);
   return false;
 }
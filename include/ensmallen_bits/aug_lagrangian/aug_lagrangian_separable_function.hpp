@@ -0,0 +1,183 @@
+/**
+ * @file aug_lagrangian_separable_function.hpp
+ *
+ * The augmented Lagrangian of a separable constrained function, as a separable
+ * function, for use with stochastic inner optimizers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_AUG_LAGRANGIAN_AUG_LAGRANGIAN_SEPARABLE_FUNCTION_HPP
+#define ENSMALLEN_AUG_LAGRANGIAN_AUG_LAGRANGIAN_SEPARABLE_FUNCTION_HPP
+
+#include "aug_lagrangian_function.hpp"
+
+namespace ens {
+
+/**
+ * This is a utility class used by AugLagrangian when the constrained function
+ * is also separable, i.e. when its objective is a sum f(x) = f_1(x) + ... +
+ * f_n(x) and it provides NumFunctions(), Shuffle(), and the separable
+ * Evaluate() and Gradient() overloads.  In addition to the full Evaluate() and
+ * Gradient() of AugLagrangianFunction, it provides the separable forms, so
+ * that the augmented Lagrangian can be minimized with SGD-type optimizers.
+ *
+ * The constraint terms of the augmented Lagrangian are not separable; each
+ * batch of size b receives the fraction b / n of them, so that the sum over
+ * one epoch is the full augmented Lagrangian.  Since the constraints may be as
+ * expensive as a full pass over the data, their value and gradient can be
+ * amortized: with constraintInterval = k > 1, they are only recomputed every k
+ * batches (and whenever the Lagrange multipliers or the penalty parameter
+ * change), and reused in between.
+ *
+ * @tparam LagrangianFunction Separable constrained function to be used.
+ */
+template<typename LagrangianFunction>
+class AugLagrangianSeparableFunction :
+    public AugLagrangianFunction<LagrangianFunction>
+{
+ public:
+  /**
+   * Initialize the AugLagrangianSeparableFunction with zero Lagrange
+   * multipliers and the default penalty parameter.
+   *
+   * @param function Lagrangian function.
+   * @param constraintInterval Number of batches between two evaluations of
+   *     the constraint terms.
+   */
+  AugLagrangianSeparableFunction(LagrangianFunction& function,
+                                 const size_t constraintInterval = 1);
+
+  /**
+   * Initialize the AugLagrangianSeparableFunction with the given Lagrange
+   * multipliers and penalty parameter.
+   *
+   * @param function Lagrangian function.
+   * @param lambda Initial Lagrange multipliers.
+   * @param sigma Initial penalty parameter.
+   * @param constraintInterval Number of batches between two evaluations of
+   *     the constraint terms.
+   */
+  AugLagrangianSeparableFunction(LagrangianFunction& function,
+                                 const arma::vec& lambda,
+                                 const double sigma,
+                                 const size_t constraintInterval = 1);
+
+  // The full forms of Evaluate() and Gradient().
+  using AugLagrangianFunction<LagrangianFunction>::Evaluate;
+  using AugLagrangianFunction<LagrangianFunction>::Gradient;
+
+  //! Return the number of separable functions.
+  size_t NumFunctions() const { return function.NumFunctions(); }
+
+  //! Shuffle the order of the separable functions.
+  void Shuffle() { function.Shuffle(); }
+
+  /**
+   * Evaluate the augmented Lagrangian on the given batch: the objective of the
+   * batch plus its share of the constraint terms.
+   *
+   * @param coordinates Coordinates to evaluate function at.
+   * @param begin Index of the first function of the batch.
+   * @param batchSize Number of functions in the batch.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates,
+                                       const size_t begin,
+                                       const size_t batchSize) const;
+
+  /**
+   * Evaluate the gradient of the augmented Lagrangian on the given batch.
+   *
+   * @param coordinates Coordinates to evaluate gradient at.
+   * @param begin Index of the first function of the batch.
+   * @param gradient Matrix to store gradient into.
+   * @param batchSize Number of functions in the batch.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize) const;
+
+  /**
+   * Evaluate the augmented Lagrangian and its gradient on the given batch.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   * @param begin Index of the first function of the batch.
+   * @param gradient Matrix to store gradient into.
+   * @param batchSize Number of functions in the batch.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(
+      const MatType& coordinates,
+      const size_t begin,
+      GradType& gradient,
+      const size_t batchSize) const;
+
+  //! Get the number of batches between two evaluations of the constraints.
+  size_t ConstraintInterval() const { return constraintInterval; }
+  //! Modify the number of batches between two evaluations of the constraints.
+  size_t& ConstraintInterval() { return constraintInterval; }
+
+ private:
+  /**
+   * Return the share of the constraint terms of a batch of the given size, and
+   * if gradient is not NULL, add the share of their gradient to it.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type BatchPenalty(const MatType& coordinates,
+                                           const size_t batchSize,
+                                           GradType* gradient) const;
+
+  /**
+   * Compute the constraint terms sum_i (-lambda_i c_i(x) + sigma / 2 c_i(x)^2)
+   * and, if gradient is not NULL, their gradient.
+   */
+  template<typename MatType, typename GradType>
+  double Penalty(const MatType& coordinates, GradType* gradient) const;
+
+  //! Return whether the cached constraint terms can be used.
+  bool CacheValid() const;
+
+  //! The Lagrangian function.
+  LagrangianFunction& function;
+
+  //! The number of batches between two evaluations of the constraints.
+  size_t constraintInterval;
+
+  //! Whether the cache holds constraint terms.
+  mutable bool cached;
+  //! The number of batch gradients since the cache was refreshed.
+  mutable size_t calls;
+  //! The cached constraint terms.
+  mutable double cachedPenalty;
+  //! The cached gradient of the constraint terms.
+  mutable arma::mat cachedGradient;
+  //! The Lagrange multipliers of the cached constraint terms.
+  mutable arma::vec cachedLambda;
+  //! The penalty parameter of the cached constraint terms.
+  mutable double cachedSigma;
+};
+
+/**
+ * Choose AugLagrangianSeparableFunction for separable constrained functions,
+ * and AugLagrangianFunction otherwise.
+ */
+template<typename LagrangianFunction>
+struct AugLagrangianFunctionSelector
+{
+  typedef typename std::conditional<
+      traits::HasNumFunctionsSignature<LagrangianFunction>::value,
+      AugLagrangianSeparableFunction<LagrangianFunction>,
+      AugLagrangianFunction<LagrangianFunction>>::type Type;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "aug_lagrangian_separable_function_impl.hpp"
+
+#endif
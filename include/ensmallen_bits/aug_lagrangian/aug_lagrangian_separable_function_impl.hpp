@@ -0,0 +1,174 @@
+/**
+ * @file aug_lagrangian_separable_function_impl.hpp
+ *
+ * Implementation of AugLagrangianSeparableFunction.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_AUG_LAGRANGIAN_AUG_LAGRANGIAN_SEPARABLE_FUNCTION_IMPL_HPP
+#define ENSMALLEN_AUG_LAGRANGIAN_AUG_LAGRANGIAN_SEPARABLE_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included.
+#include "aug_lagrangian_separable_function.hpp"
+
+namespace ens {
+
+template<typename LagrangianFunction>
+AugLagrangianSeparableFunction<LagrangianFunction>::
+AugLagrangianSeparableFunction(LagrangianFunction& function,
+                               const size_t constraintInterval) :
+    AugLagrangianFunction<LagrangianFunction>(function),
+    function(function),
+    constraintInterval(constraintInterval),
+    cached(false),
+    calls(0),
+    cachedPenalty(0.0),
+    cachedSigma(0.0)
+{
+  // Nothing else to do.
+}
+
+template<typename LagrangianFunction>
+AugLagrangianSeparableFunction<LagrangianFunction>::
+AugLagrangianSeparableFunction(LagrangianFunction& function,
+                               const arma::vec& lambda,
+                               const double sigma,
+                               const size_t constraintInterval) :
+    AugLagrangianFunction<LagrangianFunction>(function, lambda, sigma),
+    function(function),
+    constraintInterval(constraintInterval),
+    cached(false),
+    calls(0),
+    cachedPenalty(0.0),
+    cachedSigma(0.0)
+{
+  // Nothing else to do.
+}
+
+template<typename LagrangianFunction>
+template<typename MatType>
+typename MatType::elem_type
+AugLagrangianSeparableFunction<LagrangianFunction>::Evaluate(
+    const MatType& coordinates,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  return function.Evaluate(coordinates, begin, batchSize) +
+      BatchPenalty(coordinates, batchSize, (MatType*) NULL);
+}
+
+template<typename LagrangianFunction>
+template<typename MatType, typename GradType>
+void AugLagrangianSeparableFunction<LagrangianFunction>::Gradient(
+    const MatType& coordinates,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  function.Gradient(coordinates, begin, gradient, batchSize);
+  BatchPenalty(coordinates, batchSize, &gradient);
+}
+
+template<typename LagrangianFunction>
+template<typename MatType, typename GradType>
+typename MatType::elem_type
+AugLagrangianSeparableFunction<LagrangianFunction>::EvaluateWithGradient(
+    const MatType& coordinates,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  const typename MatType::elem_type objective =
+      function.Evaluate(coordinates, begin, batchSize);
+  function.Gradient(coordinates, begin, gradient, batchSize);
+  return objective + BatchPenalty(coordinates, batchSize, &gradient);
+}
+
+template<typename LagrangianFunction>
+template<typename MatType, typename GradType>
+typename MatType::elem_type
+AugLagrangianSeparableFunction<LagrangianFunction>::BatchPenalty(
+    const MatType& coordinates,
+    const size_t batchSize,
+    GradType* gradient) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType scale = ElemType(batchSize) / function.NumFunctions();
+
+  // Without amortization (or without a usable cache for an objective-only
+  // evaluation), compute the constraint terms directly.
+  if (constraintInterval <= 1 || (gradient == NULL && !CacheValid()))
+  {
+    GradType penaltyGradient;
+    const double penalty = Penalty(coordinates,
+        (gradient == NULL) ? NULL : &penaltyGradient);
+    if (gradient != NULL)
+      *gradient += scale * penaltyGradient;
+
+    return scale * ElemType(penalty);
+  }
+
+  if (gradient != NULL)
+  {
+    if (!CacheValid() || calls >= constraintInterval)
+    {
+      GradType penaltyGradient;
+      cachedPenalty = Penalty(coordinates, &penaltyGradient);
+      cachedGradient = arma::conv_to<arma::mat>::from(penaltyGradient);
+      cachedLambda = this->Lambda();
+      cachedSigma = this->Sigma();
+      cached = true;
+      calls = 0;
+    }
+    ++calls;
+
+    *gradient += scale * arma::conv_to<GradType>::from(cachedGradient);
+  }
+
+  return scale * ElemType(cachedPenalty);
+}
+
+template<typename LagrangianFunction>
+template<typename MatType, typename GradType>
+double AugLagrangianSeparableFunction<LagrangianFunction>::Penalty(
+    const MatType& coordinates,
+    GradType* gradient) const
+{
+  const arma::vec& lambda = this->Lambda();
+  const double sigma = this->Sigma();
+
+  if (gradient != NULL)
+    gradient->zeros(coordinates.n_rows, coordinates.n_cols);
+
+  double penalty = 0.0;
+  GradType constraintGradient; // Temporary for constraint gradients.
+  for (size_t i = 0; i < function.NumConstraints(); ++i)
+  {
+    const double constraint = function.EvaluateConstraint(i, coordinates);
+    penalty += -lambda[i] * constraint + sigma * std::pow(constraint, 2) / 2;
+
+    if (gradient != NULL)
+    {
+      function.GradientConstraint(i, coordinates, constraintGradient);
+      *gradient += (-lambda[i] + sigma * constraint) * constraintGradient;
+    }
+  }
+
+  return penalty;
+}
+
+template<typename LagrangianFunction>
+bool AugLagrangianSeparableFunction<LagrangianFunction>::CacheValid() const
+{
+  const arma::vec& lambda = this->Lambda();
+  return cached && cachedSigma == this->Sigma() &&
+      cachedLambda.n_elem == lambda.n_elem && arma::all(cachedLambda == lambda);
+}
+
+} // namespace ens
+
+#endif
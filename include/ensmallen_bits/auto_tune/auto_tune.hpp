@@ -0,0 +1,307 @@
+/**
+ * @file auto_tune.hpp
+ *
+ * AutoTune wraps an optimizer and picks its batch size and thread count by
+ * benchmarking a few candidate configurations on the function to optimize.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_AUTO_TUNE_AUTO_TUNE_HPP
+#define ENSMALLEN_AUTO_TUNE_AUTO_TUNE_HPP
+
+#include <ensmallen_bits/sgd/sgd.hpp>
+
+namespace ens {
+
+/**
+ * AutoTune wraps another optimizer and tunes the settings that only affect how
+ * fast the optimizer runs on this machine: the batch size (if the optimizer
+ * has BatchSize()) and the number of OpenMP threads.  Before the optimization,
+ * every combination of the candidate batch sizes and thread counts is run for
+ * a short warm-up from the starting point, on a copy of the wrapped optimizer,
+ * and is scored either by the decrease of the objective per second or by the
+ * number of iterations actually run per second.  The best combination is then used for the actual optimization.
+ * Afterwards (even if the wrapped optimizer throws), the batch size and the
+ * maximum number of iterations of the wrapped optimizer and the number of
+ * OpenMP threads are restored.
+ *
+ * The warm-up is bounded: each candidate runs for at most warmupIterations
+ * iterations of the wrapped optimizer, and no further candidates are tried
+ * once maxWarmupTime seconds have been spent.  If a cache file is given, the
+ * choice is appended to it, keyed by the optimizer type, the number of
+ * coordinates, the number of separable functions and the number of available
+ * threads; later runs with the same key read the choice back and skip the
+ * warm-up.
+ *
+ * The wrapped optimizer must have MaxIterations().  Without OpenMP, only the
+ * batch size is tuned.
+ *
+ * @code
+ * AutoTune<StandardSGD> optimizer(StandardSGD(0.01, 32, 100000));
+ * optimizer.CacheFile() = "autotune.txt";
+ * optimizer.Optimize(f, coordinates);
+ * std::cout << optimizer.BestBatchSize() << std::endl;
+ * @endcode
+ *
+ * @tparam OptimizerType Type of the wrapped optimizer.
+ */
+template<typename OptimizerType = StandardSGD>
+class AutoTune
+{
+ public:
+  /**
+   * Construct the AutoTune wrapper around the given optimizer.
+   *
+   * @param optimizer The optimizer to tune and run.
+   * @param batchSizes Candidate batch sizes; if empty, the powers of four from
+   *     1 to 1024 (and the optimizer's own batch size) that do not exceed the
+   *     number of separable functions are used.  Ignored if the optimizer has
+   *     no BatchSize().
+   * @param threadCounts Candidate numbers of threads; if empty, the powers of
+   *     two up to (and including) the number of available threads are used.
+   * @param warmupIterations Maximum number of iterations of the optimizer for
+   *     each candidate.
+   * @param maxWarmupTime Maximum total time of the warm-up, in seconds.
+   * @param objectiveDecrease If true, score the candidates by the decrease of
+   *     the objective per second; otherwise by the number of iterations
+   *     actually run per second.
+   * @param cacheFile File to record the choices in (empty for none).
+   */
+  AutoTune(const OptimizerType& optimizer = OptimizerType(),
+           const std::vector<size_t>& batchSizes = std::vector<size_t>(),
+           const std::vector<size_t>& threadCounts = std::vector<size_t>(),
+           const size_t warmupIterations = 1000,
+           const double maxWarmupTime = 5.0,
+           const bool objectiveDecrease = true,
+           const std::string& cacheFile = "");
+
+  /**
+   * Tune the optimizer on the given function, and then optimize the function
+   * with the best configuration.  The starting point is not changed during the
+   * warm-up.
+   *
+   * @tparam FunctionType Type of the function to optimize.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions, passed to the final optimization.
+   * @return Objective value of the final point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the wrapped optimizer.
+  const OptimizerType& Optimizer() const { return optimizer; }
+  //! Modify the wrapped optimizer.
+  OptimizerType& Optimizer() { return optimizer; }
+
+  //! Get the candidate batch sizes.
+  const std::vector<size_t>& BatchSizes() const { return batchSizes; }
+  //! Modify the candidate batch sizes.
+  std::vector<size_t>& BatchSizes() { return batchSizes; }
+
+  //! Get the candidate thread counts.
+  const std::vector<size_t>& ThreadCounts() const { return threadCounts; }
+  //! Modify the candidate thread counts.
+  std::vector<size_t>& ThreadCounts() { return threadCounts; }
+
+  //! Get the maximum number of warm-up iterations per candidate.
+  size_t WarmupIterations() const { return warmupIterations; }
+  //! Modify the maximum number of warm-up iterations per candidate.
+  size_t& WarmupIterations() { return warmupIterations; }
+
+  //! Get the maximum total warm-up time.
+  double MaxWarmupTime() const { return maxWarmupTime; }
+  //! Modify the maximum total warm-up time.
+  double& MaxWarmupTime() { return maxWarmupTime; }
+
+  //! Get whether candidates are scored by the objective decrease per second.
+  bool ObjectiveDecrease() const { return objectiveDecrease; }
+  //! Modify whether candidates are scored by the objective decrease per
+  //! second.
+  bool& ObjectiveDecrease() { return objectiveDecrease; }
+
+  //! Get the cache file.
+  const std::string& CacheFile() const { return cacheFile; }
+  //! Modify the cache file.
+  std::string& CacheFile() { return cacheFile; }
+
+  //! Get the batch size chosen by the last optimization (0 if the optimizer
+  //! has no batch size).
+  size_t BestBatchSize() const { return bestBatchSize; }
+
+  //! Get the thread count chosen by the last optimization.
+  size_t BestThreadCount() const { return bestThreadCount; }
+
+  //! Get whether the last choice was read from the cache file.
+  bool FromCache() const { return fromCache; }
+
+ private:
+  /**
+   * Restore the maximum number of iterations and the batch size of the
+   * optimizer, and the number of OpenMP threads, when it goes out of scope.
+   */
+  class SettingsGuard
+  {
+   public:
+    SettingsGuard(OptimizerType& optimizer) :
+        optimizer(optimizer),
+        maxIterations(optimizer.MaxIterations()),
+        batchSize(GetBatchSize(optimizer)),
+        threads(MaxThreads())
+    { /* Nothing to do. */ }
+
+    ~SettingsGuard()
+    {
+      optimizer.MaxIterations() = maxIterations;
+      SetBatchSize(optimizer, batchSize);
+      SetThreads(threads);
+    }
+
+   private:
+    SettingsGuard(const SettingsGuard&);
+    SettingsGuard& operator=(const SettingsGuard&);
+
+    OptimizerType& optimizer;
+    size_t maxIterations;
+    size_t batchSize;
+    size_t threads;
+  };
+
+  //! Count the steps taken by a warm-up trial.
+  class StepCounter
+  {
+   public:
+    StepCounter() : steps(0) { }
+
+    template<typename OptimizerT, typename FunctionType, typename MatType>
+    void StepTaken(OptimizerT& /* optimizer */,
+                   FunctionType& /* function */,
+                   MatType& /* coordinates */)
+    {
+      ++steps;
+    }
+
+    //! The number of steps taken.
+    size_t steps;
+  };
+
+  //! Run the warm-up and set bestBatchSize and bestThreadCount.
+  template<typename FunctionType, typename MatType>
+  void Tune(FunctionType& function, const MatType& iterate);
+
+  //! Build the cache key for the given problem.
+  std::string CacheKey(const size_t numCoordinates,
+                       const size_t numFunctions,
+                       const size_t maxThreads) const;
+
+  //! Look up the given key in the cache file; return whether it was found.
+  bool ReadCache(const std::string& key);
+
+  //! Append the current choice to the cache file.
+  void WriteCache(const std::string& key) const;
+
+  //! Return the number of available threads.
+  static size_t MaxThreads();
+
+  //! Set the number of threads used by OpenMP.
+  static void SetThreads(const size_t threads);
+
+  //! Return the batch size of the optimizer, if it has one.
+  template<typename T>
+  static typename std::enable_if<traits::HasBatchSizeSignature<T>::value,
+      size_t>::type
+  GetBatchSize(T& optimizer) { return optimizer.BatchSize(); }
+
+  template<typename T>
+  static typename std::enable_if<!traits::HasBatchSizeSignature<T>::value,
+      size_t>::type
+  GetBatchSize(T& /* optimizer */) { return 0; }
+
+  //! Set the batch size of the optimizer, if it has one.
+  template<typename T>
+  static typename std::enable_if<traits::HasBatchSizeSignature<T>::value,
+      void>::type
+  SetBatchSize(T& optimizer, const size_t batchSize)
+  {
+    optimizer.BatchSize() = batchSize;
+  }
+
+  template<typename T>
+  static typename std::enable_if<!traits::HasBatchSizeSignature<T>::value,
+      void>::type
+  SetBatchSize(T& /* optimizer */, const size_t /* batchSize */) { }
+
+  //! Return the number of separable functions (1 for other functions).
+  template<typename T>
+  static typename std::enable_if<traits::HasNumFunctionsSignature<T>::value,
+      size_t>::type
+  NumFunctions(T& function) { return function.NumFunctions(); }
+
+  template<typename T>
+  static typename std::enable_if<!traits::HasNumFunctionsSignature<T>::value,
+      size_t>::type
+  NumFunctions(T& /* function */) { return 1; }
+
+  //! Return the objective over all separable functions.
+  template<typename T, typename MatType>
+  static typename std::enable_if<traits::HasNumFunctionsSignature<T>::value,
+      typename MatType::elem_type>::type
+  FullObjective(T& function, const MatType& iterate)
+  {
+    return function.Evaluate(iterate, 0, function.NumFunctions());
+  }
+
+  template<typename T, typename MatType>
+  static typename std::enable_if<!traits::HasNumFunctionsSignature<T>::value,
+      typename MatType::elem_type>::type
+  FullObjective(T& function, const MatType& iterate)
+  {
+    return function.Evaluate(iterate);
+  }
+
+  //! The wrapped optimizer.
+  OptimizerType optimizer;
+
+  //! The candidate batch sizes.
+  std::vector<size_t> batchSizes;
+
+  //! The candidate thread counts.
+  std::vector<size_t> threadCounts;
+
+  //! The maximum number of warm-up iterations per candidate.
+  size_t warmupIterations;
+
+  //! The maximum total warm-up time.
+  double maxWarmupTime;
+
+  //! Whether candidates are scored by the objective decrease per second.
+  bool objectiveDecrease;
+
+  //! The file to record the choices in.
+  std::string cacheFile;
+
+  //! The batch size chosen by the last optimization.
+  size_t bestBatchSize;
+
+  //! The thread count chosen by the last optimization.
+  size_t bestThreadCount;
+
+  //! Whether the last choice was read from the cache file.
+  bool fromCache;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "auto_tune_impl.hpp"
+
+#endif
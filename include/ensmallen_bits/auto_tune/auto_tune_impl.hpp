@@ -0,0 +1,291 @@
+/**
+ * @file auto_tune_impl.hpp
+ *
+ * Implementation of the AutoTune optimizer wrapper.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_AUTO_TUNE_AUTO_TUNE_IMPL_HPP
+#define ENSMALLEN_AUTO_TUNE_AUTO_TUNE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "auto_tune.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <typeinfo>
+
+namespace ens {
+
+template<typename OptimizerType>
+AutoTune<OptimizerType>::AutoTune(
+    const OptimizerType& optimizer,
+    const std::vector<size_t>& batchSizes,
+    const std::vector<size_t>& threadCounts,
+    const size_t warmupIterations,
+    const double maxWarmupTime,
+    const bool objectiveDecrease,
+    const std::string& cacheFile) :
+    optimizer(optimizer),
+    batchSizes(batchSizes),
+    threadCounts(threadCounts),
+    warmupIterations(warmupIterations),
+    maxWarmupTime(maxWarmupTime),
+    objectiveDecrease(objectiveDecrease),
+    cacheFile(cacheFile),
+    bestBatchSize(0),
+    bestThreadCount(1),
+    fromCache(false)
+{ /* Nothing to do. */ }
+
+template<typename OptimizerType>
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type AutoTune<OptimizerType>::Optimize(
+    FunctionType& function,
+    MatType& iterate,
+    CallbackTypes&&... callbacks)
+{
+  static_assert(traits::HasMaxIterationsSignature<OptimizerType>::value,
+      "AutoTune: the optimizer must have MaxIterations()");
+
+  if (warmupIterations == 0)
+  {
+    throw std::invalid_argument("AutoTune::Optimize(): warmupIterations must "
+        "be positive");
+  }
+
+  const size_t maxThreads = MaxThreads();
+  const std::string key = CacheKey(iterate.n_elem, NumFunctions(function),
+      maxThreads);
+
+  fromCache = !cacheFile.empty() && ReadCache(key);
+  if (fromCache)
+  {
+    Info << "AutoTune: using batch size " << bestBatchSize << " and "
+        << bestThreadCount << " threads from " << cacheFile << "."
+        << std::endl;
+  }
+  else
+  {
+    Tune(function, iterate);
+    if (!cacheFile.empty())
+      WriteCache(key);
+  }
+
+  SettingsGuard guard(optimizer);
+  SetBatchSize(optimizer, bestBatchSize);
+  SetThreads(bestThreadCount);
+  return optimizer.Optimize(function, iterate,
+      std::forward<CallbackTypes>(callbacks)...);
+}
+
+template<typename OptimizerType>
+template<typename FunctionType, typename MatType>
+void AutoTune<OptimizerType>::Tune(FunctionType& function,
+                                   const MatType& iterate)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t numFunctions = NumFunctions(function);
+  const size_t maxThreads = MaxThreads();
+
+  // Collect the candidate batch sizes.
+  std::vector<size_t> batches;
+  const size_t originalBatchSize = GetBatchSize(optimizer);
+  if (!traits::HasBatchSizeSignature<OptimizerType>::value)
+  {
+    batches.push_back(0);
+  }
+  else if (!batchSizes.empty())
+  {
+    batches = batchSizes;
+  }
+  else
+  {
+    for (size_t b = 1; b <= 1024 && b <= numFunctions; b *= 4)
+      batches.push_back(b);
+    if (originalBatchSize <= numFunctions &&
+        std::find(batches.begin(), batches.end(), originalBatchSize) ==
+        batches.end())
+      batches.push_back(originalBatchSize);
+    if (batches.empty())
+      batches.push_back(originalBatchSize);
+  }
+
+  // Collect the candidate thread counts.
+  std::vector<size_t> threads;
+  #ifdef ENS_USE_OPENMP
+    threads = threadCounts;
+    if (threads.empty())
+    {
+      for (size_t t = 1; t < maxThreads; t *= 2)
+        threads.push_back(t);
+      threads.push_back(maxThreads);
+    }
+  #else
+    threads.push_back(1);
+  #endif
+
+  // The thread count is restored even if a trial throws.
+  SettingsGuard guard(optimizer);
+
+  const ElemType startObjective = objectiveDecrease ?
+      FullObjective(function, iterate) : ElemType(0);
+
+  double bestScore = -std::numeric_limits<double>::infinity();
+  bestBatchSize = batches[0];
+  bestThreadCount = threads[0];
+
+  arma::wall_clock totalTimer;
+  totalTimer.tic();
+  size_t tried = 0;
+  const size_t numCandidates = batches.size() * threads.size();
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    if (tried > 0 && totalTimer.toc() > maxWarmupTime)
+    {
+      Info << "AutoTune: warm-up time exhausted after " << tried << " of "
+          << numCandidates << " candidates." << std::endl;
+      break;
+    }
+
+    const size_t batchSize = batches[c / threads.size()];
+    const size_t threadCount = threads[c % threads.size()];
+
+    // Each trial runs on a copy of the optimizer, so that the state it leaves
+    // behind (e.g. a kept history or update policy) does not leak into the
+    // next trials or the actual optimization.
+    OptimizerType trial(optimizer);
+    trial.MaxIterations() = warmupIterations;
+    SetBatchSize(trial, batchSize);
+    SetThreads(threadCount);
+
+    MatType candidate(iterate);
+    StepCounter counter;
+    arma::wall_clock timer;
+    timer.tic();
+    trial.Optimize(function, candidate, counter);
+    const double time = std::max(timer.toc(), 1e-9);
+    ++tried;
+
+    double score;
+    if (objectiveDecrease)
+    {
+      score = double(startObjective - FullObjective(function, candidate)) /
+          time;
+    }
+    else
+    {
+      // A trial may stop before warmupIterations (e.g. when it converges), so
+      // count the iterations it actually ran.  For optimizers with a batch
+      // size, each step processes batchSize iterations.
+      score = double(counter.steps * std::max(batchSize, (size_t) 1)) / time;
+    }
+    if (std::isnan(score))
+      score = -std::numeric_limits<double>::infinity();
+
+    Info << "AutoTune: batch size " << batchSize << ", " << threadCount
+        << " threads: " << score << (objectiveDecrease ?
+        " objective decrease" : " iterations") << " per second." << std::endl;
+
+    if (score > bestScore)
+    {
+      bestScore = score;
+      bestBatchSize = batchSize;
+      bestThreadCount = threadCount;
+    }
+  }
+
+  Info << "AutoTune: chose batch size " << bestBatchSize << " and "
+      << bestThreadCount << " threads." << std::endl;
+}
+
+template<typename OptimizerType>
+std::string AutoTune<OptimizerType>::CacheKey(const size_t numCoordinates,
+                                              const size_t numFunctions,
+                                              const size_t maxThreads) const
+{
+  // Some compilers (like MSVC) put spaces in the type names, but the key is
+  // read back as a single whitespace-delimited token.
+  std::string name = typeid(OptimizerType).name();
+  for (size_t i = 0; i < name.size(); ++i)
+  {
+    if (std::isspace((unsigned char) name[i]))
+      name[i] = '_';
+  }
+
+  std::ostringstream oss;
+  oss << name << ":" << numCoordinates << ":" << numFunctions << ":"
+      << maxThreads;
+  return oss.str();
+}
+
+template<typename OptimizerType>
+bool AutoTune<OptimizerType>::ReadCache(const std::string& key)
+{
+  std::ifstream in(cacheFile.c_str());
+  if (!in)
+    return false;
+
+  // Later entries override earlier ones.
+  bool found = false;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream iss(line);
+    std::string entryKey;
+    size_t batchSize, threadCount;
+    if ((iss >> entryKey >> batchSize >> threadCount) && entryKey == key)
+    {
+      bestBatchSize = batchSize;
+      bestThreadCount = threadCount;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+template<typename OptimizerType>
+void AutoTune<OptimizerType>::WriteCache(const std::string& key) const
+{
+  std::ofstream out(cacheFile.c_str(), std::ios::app);
+  if (!out)
+  {
+    Warn << "AutoTune: cannot write to " << cacheFile << "; the choice is not "
+        << "recorded." << std::endl;
+    return;
+  }
+
+  out << key << " " << bestBatchSize << " " << bestThreadCount << std::endl;
+}
+
+template<typename OptimizerType>
+size_t AutoTune<OptimizerType>::MaxThreads()
+{
+  #ifdef ENS_USE_OPENMP
+    return (size_t) omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+template<typename OptimizerType>
+void AutoTune<OptimizerType>::SetThreads(const size_t threads)
+{
+  #ifdef ENS_USE_OPENMP
+    omp_set_num_threads((int) std::max(threads, (size_t) 1));
+  #else
+    (void) threads;
+  #endif
+}
+
+} // namespace ens
+
+#endif
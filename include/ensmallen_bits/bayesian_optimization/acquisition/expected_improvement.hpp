@@ -0,0 +1,84 @@
+/**
+ * @file expected_improvement.hpp
+ *
+ * Expected improvement acquisition function for Bayesian optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_ACQUISITION_EXPECTED_IMPROVEMENT_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_ACQUISITION_EXPECTED_IMPROVEMENT_HPP
+
+namespace ens {
+
+/**
+ * The expected improvement over the best observed value,
+ *
+ *   EI = (best - mean - xi) Phi(z) + stddev phi(z),
+ *   z = (best - mean - xi) / stddev,
+ *
+ * where Phi and phi are the standard normal distribution and density, and xi
+ * trades exploration for exploitation.
+ */
+class ExpectedImprovement
+{
+ public:
+  /**
+   * Construct the expected improvement acquisition function.
+   *
+   * @param xi Minimum improvement, in units of the standard deviation of the
+   *     observed values.
+   */
+  ExpectedImprovement(const double xi = 0.01) : xi(xi)
+  { /* Nothing to do. */ }
+
+  /**
+   * Compute the (non-negative) acquisition value and its derivatives with
+   * respect to the posterior mean and standard deviation.
+   *
+   * @param mean Posterior mean.
+   * @param stddev Posterior standard deviation.
+   * @param best Smallest observed value.
+   * @param dMean Will be set to the derivative with respect to the mean.
+   * @param dStddev Will be set to the derivative with respect to the standard
+   *     deviation.
+   * @return Acquisition value.
+   */
+  double Evaluate(const double mean,
+                  const double stddev,
+                  const double best,
+                  double& dMean,
+                  double& dStddev) const
+  {
+    const double improvement = best - mean - xi;
+    if (stddev <= 1e-12)
+    {
+      dMean = (improvement > 0.0) ? -1.0 : 0.0;
+      dStddev = 0.0;
+      return std::max(improvement, 0.0);
+    }
+
+    const double z = improvement / stddev;
+    const double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    const double pdf = std::exp(-0.5 * z * z) /
+        std::sqrt(2.0 * arma::datum::pi);
+    dMean = -cdf;
+    dStddev = pdf;
+    return improvement * cdf + stddev * pdf;
+  }
+
+  //! Get the minimum improvement.
+  double Xi() const { return xi; }
+  //! Modify the minimum improvement.
+  double& Xi() { return xi; }
+
+ private:
+  //! The minimum improvement.
+  double xi;
+};
+
+} // namespace ens
+
+#endif
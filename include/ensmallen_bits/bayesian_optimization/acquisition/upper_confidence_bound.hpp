@@ -0,0 +1,74 @@
+/**
+ * @file upper_confidence_bound.hpp
+ *
+ * Upper confidence bound acquisition function for Bayesian optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_ACQUISITION_UPPER_CONFIDENCE_BOUND_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_ACQUISITION_UPPER_CONFIDENCE_BOUND_HPP
+
+namespace ens {
+
+/**
+ * The upper confidence bound of the improvement over the best observed value,
+ * best - mean + kappa * stddev (the lower confidence bound of the function,
+ * since the function is minimized).  It is passed through a softplus so that
+ * it is positive, as needed for local penalization of batches.
+ */
+class UpperConfidenceBound
+{
+ public:
+  /**
+   * Construct the upper confidence bound acquisition function.
+   *
+   * @param kappa Weight of the standard deviation.
+   */
+  UpperConfidenceBound(const double kappa = 2.0) : kappa(kappa)
+  { /* Nothing to do. */ }
+
+  /**
+   * Compute the (positive) acquisition value and its derivatives with respect
+   * to the posterior mean and standard deviation.
+   *
+   * @param mean Posterior mean.
+   * @param stddev Posterior standard deviation.
+   * @param best Smallest observed value.
+   * @param dMean Will be set to the derivative with respect to the mean.
+   * @param dStddev Will be set to the derivative with respect to the standard
+   *     deviation.
+   * @return Acquisition value.
+   */
+  double Evaluate(const double mean,
+                  const double stddev,
+                  const double best,
+                  double& dMean,
+                  double& dStddev) const
+  {
+    const double bound = best - mean + kappa * stddev;
+
+    // softplus(b) = log(1 + exp(b)), computed without overflow.
+    const double value = std::max(bound, 0.0) +
+        std::log1p(std::exp(-std::abs(bound)));
+    const double sigmoid = 1.0 / (1.0 + std::exp(-bound));
+    dMean = -sigmoid;
+    dStddev = kappa * sigmoid;
+    return value;
+  }
+
+  //! Get the weight of the standard deviation.
+  double Kappa() const { return kappa; }
+  //! Modify the weight of the standard deviation.
+  double& Kappa() { return kappa; }
+
+ private:
+  //! The weight of the standard deviation.
+  double kappa;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,308 @@
+/**
+ * @file bayesian_optimization.hpp
+ *
+ * Bayesian optimization with a Gaussian process surrogate.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_BAYESIAN_OPTIMIZATION_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_BAYESIAN_OPTIMIZATION_HPP
+
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+#include <ensmallen_bits/random_search/samplers/latin_hypercube_sampler.hpp>
+
+#include "gaussian_process.hpp"
+#include "penalized_acquisition.hpp"
+#include "acquisition/expected_improvement.hpp"
+#include "acquisition/upper_confidence_bound.hpp"
+
+namespace ens {
+
+/**
+ * Bayesian optimization minimizes expensive functions over a box by fitting a
+ * Gaussian process to all evaluations so far, and evaluating next where an
+ * acquisition function of the posterior (by default the expected improvement)
+ * is largest.  It needs no gradient, and usually far fewer evaluations than
+ * grid, random or evolutionary search.
+ *
+ * The Gaussian process is updated incrementally: each new point extends the
+ * Cholesky factor of the kernel matrix by one row, in O(n^2) for n points.
+ * The acquisition function is maximized by L_BFGS from several starting
+ * points, chosen as the best of a set of random candidates.
+ *
+ * With batchSize > 1, each iteration proposes a batch of points by local
+ * penalization: after a point is chosen, the acquisition function is damped
+ * around it, and the next point is chosen from the penalized function.  If
+ * ensmallen is compiled with OpenMP, the points of a batch (and the initial
+ * design) are evaluated in parallel, so the function's Evaluate() must then be
+ * safe to call concurrently.
+ *
+ * As for GridSearch, some dimensions may be categorical: such a dimension takes
+ * the values 0, ..., numCategories(i) - 1, and the kernel only considers
+ * whether two categories are equal.  The bounds are ignored for categorical
+ * dimensions.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @inproceedings{Snoek2012,
+ *   author    = {Snoek, Jasper and Larochelle, Hugo and Adams, Ryan P.},
+ *   title     = {Practical {B}ayesian Optimization of Machine Learning
+ *                Algorithms},
+ *   booktitle = {Advances in Neural Information Processing Systems 25},
+ *   pages     = {2951--2959},
+ *   year      = {2012}
+ * }
+ * @endcode
+ *
+ * BayesianOptimization can optimize arbitrary functions.  For more details,
+ * see the documentation on function types included with this distribution or
+ * on the ensmallen website.
+ *
+ * @tparam AcquisitionType Acquisition function (ExpectedImprovement or
+ *     UpperConfidenceBound).
+ */
+template<typename AcquisitionType = ExpectedImprovement>
+class BayesianOptimizationType
+{
+ public:
+  /**
+   * Construct the Bayesian optimization optimizer with the given parameters.
+   *
+   * @param maxEvaluations Total number of function evaluations.
+   * @param lowerBound Lower bound of the box; either a single value for all
+   *     dimensions, or one value for each element of the coordinates.
+   * @param upperBound Upper bound of the box; either a single value for all
+   *     dimensions, or one value for each element of the coordinates.
+   * @param numInitialPoints Number of points of the initial design (including
+   *     the starting point), drawn as a Latin hypercube.
+   * @param batchSize Number of points proposed and evaluated together.
+   * @param numStarts Number of L_BFGS runs used to maximize the acquisition
+   *     function.
+   * @param lengthScale Length scale of the kernel, relative to the size of the
+   *     box.
+   * @param noiseVariance Variance of the observation noise, relative to the
+   *     variance of the observed values.
+   * @param categoricalDimensions Set of dimension types.  If a value is true,
+   *     then that dimension is a categorical dimension.  Empty means that all
+   *     dimensions are continuous.
+   * @param numCategories Number of categories in each categorical dimension.
+   * @param acquisition Instantiated acquisition function.
+   * @param lbfgs L_BFGS optimizer used to maximize the acquisition function.
+   */
+  BayesianOptimizationType(
+      const size_t maxEvaluations = 100,
+      const arma::mat& lowerBound = -arma::ones(1, 1),
+      const arma::mat& upperBound = arma::ones(1, 1),
+      const size_t numInitialPoints = 10,
+      const size_t batchSize = 1,
+      const size_t numStarts = 5,
+      const double lengthScale = 0.2,
+      const double noiseVariance = 1e-6,
+      const std::vector<bool>& categoricalDimensions = std::vector<bool>(),
+      const arma::Row<size_t>& numCategories = arma::Row<size_t>(),
+      const AcquisitionType& acquisition = AcquisitionType(),
+      const L_BFGS& lbfgs = L_BFGS(10, 100));
+
+  /**
+   * Construct the Bayesian optimization optimizer with the given parameters,
+   * with the same bounds for all dimensions.
+   *
+   * @param maxEvaluations Total number of function evaluations.
+   * @param lowerBound Lower bound of every dimension.
+   * @param upperBound Upper bound of every dimension.
+   * @param numInitialPoints Number of points of the initial design.
+   * @param batchSize Number of points proposed and evaluated together.
+   * @param numStarts Number of L_BFGS runs used to maximize the acquisition
+   *     function.
+   * @param lengthScale Length scale of the kernel, relative to the size of the
+   *     box.
+   * @param noiseVariance Variance of the observation noise, relative to the
+   *     variance of the observed values.
+   * @param categoricalDimensions Set of dimension types.
+   * @param numCategories Number of categories in each categorical dimension.
+   * @param acquisition Instantiated acquisition function.
+   * @param lbfgs L_BFGS optimizer used to maximize the acquisition function.
+   */
+  BayesianOptimizationType(
+      const size_t maxEvaluations,
+      const double lowerBound,
+      const double upperBound,
+      const size_t numInitialPoints = 10,
+      const size_t batchSize = 1,
+      const size_t numStarts = 5,
+      const double lengthScale = 0.2,
+      const double noiseVariance = 1e-6,
+      const std::vector<bool>& categoricalDimensions = std::vector<bool>(),
+      const arma::Row<size_t>& numCategories = arma::Row<size_t>(),
+      const AcquisitionType& acquisition = AcquisitionType(),
+      const L_BFGS& lbfgs = L_BFGS(10, 100));
+
+  /**
+   * Optimize the given function using Bayesian optimization.  The given
+   * starting point is evaluated as the first point of the initial design
+   * (moved into the box, with categorical dimensions rounded to the nearest
+   * category), and is overwritten with the best point found; the objective
+   * value of that point is returned.
+   *
+   * @tparam ArbitraryFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename ArbitraryFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(ArbitraryFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the total number of function evaluations.
+  size_t MaxEvaluations() const { return maxEvaluations; }
+  //! Modify the total number of function evaluations.
+  size_t& MaxEvaluations() { return maxEvaluations; }
+
+  //! Get the lower bound of the box.
+  const arma::mat& LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the box.
+  arma::mat& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the box.
+  const arma::mat& UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the box.
+  arma::mat& UpperBound() { return upperBound; }
+
+  //! Get the number of points of the initial design.
+  size_t NumInitialPoints() const { return numInitialPoints; }
+  //! Modify the number of points of the initial design.
+  size_t& NumInitialPoints() { return numInitialPoints; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of L_BFGS runs per proposed point.
+  size_t NumStarts() const { return numStarts; }
+  //! Modify the number of L_BFGS runs per proposed point.
+  size_t& NumStarts() { return numStarts; }
+
+  //! Get the length scale of the kernel.
+  double LengthScale() const { return lengthScale; }
+  //! Modify the length scale of the kernel.
+  double& LengthScale() { return lengthScale; }
+
+  //! Get the noise variance.
+  double NoiseVariance() const { return noiseVariance; }
+  //! Modify the noise variance.
+  double& NoiseVariance() { return noiseVariance; }
+
+  //! Get the categorical dimensions.
+  const std::vector<bool>& CategoricalDimensions() const
+  { return categoricalDimensions; }
+  //! Modify the categorical dimensions.
+  std::vector<bool>& CategoricalDimensions() { return categoricalDimensions; }
+
+  //! Get the number of categories of each dimension.
+  const arma::Row<size_t>& NumCategories() const { return numCategories; }
+  //! Modify the number of categories of each dimension.
+  arma::Row<size_t>& NumCategories() { return numCategories; }
+
+  //! Get the acquisition function.
+  const AcquisitionType& Acquisition() const { return acquisition; }
+  //! Modify the acquisition function.
+  AcquisitionType& Acquisition() { return acquisition; }
+
+  //! Get the L_BFGS optimizer.
+  const L_BFGS& LBFGS() const { return lbfgs; }
+  //! Modify the L_BFGS optimizer.
+  L_BFGS& LBFGS() { return lbfgs; }
+
+ private:
+  /**
+   * Propose the next batch of points, in the scaled coordinates of the
+   * Gaussian process, one per column.
+   *
+   * @param gp Fitted Gaussian process.
+   * @param numPoints Number of points to propose.
+   * @param bestPoint Best point observed so far.
+   */
+  arma::mat ProposeBatch(const GaussianProcess& gp,
+                         const size_t numPoints,
+                         const arma::vec& bestPoint);
+
+  /**
+   * Draw random points in the scaled coordinates, one per column: uniform in
+   * [0, 1] for continuous dimensions and uniform over the categories for
+   * categorical dimensions.
+   */
+  arma::mat RandomPoints(const size_t dimensions,
+                         const size_t numPoints) const;
+
+  //! Return whether dimension i is categorical.
+  bool IsCategorical(const size_t i) const
+  {
+    return !categoricalDimensions.empty() && categoricalDimensions[i];
+  }
+
+  //! The total number of function evaluations.
+  size_t maxEvaluations;
+
+  //! Lower bound of the box.
+  arma::mat lowerBound;
+
+  //! Upper bound of the box.
+  arma::mat upperBound;
+
+  //! The number of points of the initial design.
+  size_t numInitialPoints;
+
+  //! The number of points proposed and evaluated together.
+  size_t batchSize;
+
+  //! The number of L_BFGS runs per proposed point.
+  size_t numStarts;
+
+  //! The length scale of the kernel.
+  double lengthScale;
+
+  //! The noise variance.
+  double noiseVariance;
+
+  //! Which dimensions are categorical.
+  std::vector<bool> categoricalDimensions;
+
+  //! The number of categories of each dimension.
+  arma::Row<size_t> numCategories;
+
+  //! The acquisition function.
+  AcquisitionType acquisition;
+
+  //! The L_BFGS optimizer used to maximize the acquisition function.
+  L_BFGS lbfgs;
+};
+
+// Convenience typedefs.
+
+/**
+ * Bayesian optimization with the expected improvement acquisition function.
+ */
+using BayesianOptimization = BayesianOptimizationType<ExpectedImprovement>;
+
+/**
+ * Bayesian optimization with the upper confidence bound acquisition function.
+ */
+using BayesianOptimizationUCB = BayesianOptimizationType<UpperConfidenceBound>;
+
+} // namespace ens
+
+// Include implementation.
+#include "bayesian_optimization_impl.hpp"
+
+#endif
@@ -0,0 +1,369 @@
+/**
+ * @file bayesian_optimization_impl.hpp
+ *
+ * Implementation of Bayesian optimization with a Gaussian process surrogate.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_BAYESIAN_OPTIMIZATION_IMPL_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_BAYESIAN_OPTIMIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "bayesian_optimization.hpp"
+
+namespace ens {
+
+template<typename AcquisitionType>
+inline BayesianOptimizationType<AcquisitionType>::BayesianOptimizationType(
+    const size_t maxEvaluations,
+    const arma::mat& lowerBound,
+    const arma::mat& upperBound,
+    const size_t numInitialPoints,
+    const size_t batchSize,
+    const size_t numStarts,
+    const double lengthScale,
+    const double noiseVariance,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    const AcquisitionType& acquisition,
+    const L_BFGS& lbfgs) :
+    maxEvaluations(maxEvaluations),
+    lowerBound(lowerBound),
+    upperBound(upperBound),
+    numInitialPoints(numInitialPoints),
+    batchSize(batchSize),
+    numStarts(numStarts),
+    lengthScale(lengthScale),
+    noiseVariance(noiseVariance),
+    categoricalDimensions(categoricalDimensions),
+    numCategories(numCategories),
+    acquisition(acquisition),
+    lbfgs(lbfgs)
+{ /* Nothing to do. */ }
+
+template<typename AcquisitionType>
+inline BayesianOptimizationType<AcquisitionType>::BayesianOptimizationType(
+    const size_t maxEvaluations,
+    const double lowerBound,
+    const double upperBound,
+    const size_t numInitialPoints,
+    const size_t batchSize,
+    const size_t numStarts,
+    const double lengthScale,
+    const double noiseVariance,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories,
+    const AcquisitionType& acquisition,
+    const L_BFGS& lbfgs) :
+    maxEvaluations(maxEvaluations),
+    lowerBound(lowerBound * arma::ones(1, 1)),
+    upperBound(upperBound * arma::ones(1, 1)),
+    numInitialPoints(numInitialPoints),
+    batchSize(batchSize),
+    numStarts(numStarts),
+    lengthScale(lengthScale),
+    noiseVariance(noiseVariance),
+    categoricalDimensions(categoricalDimensions),
+    numCategories(numCategories),
+    acquisition(acquisition),
+    lbfgs(lbfgs)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename AcquisitionType>
+template<typename ArbitraryFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type
+BayesianOptimizationType<AcquisitionType>::Optimize(
+    ArbitraryFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitraryFunctionTypeAPI<ArbitraryFunctionType,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  const size_t n = iterate.n_elem;
+
+  if (n == 0)
+  {
+    throw std::invalid_argument("BayesianOptimization::Optimize(): the "
+        "coordinates must not be empty");
+  }
+
+  if (!categoricalDimensions.empty() && (categoricalDimensions.size() != n ||
+      numCategories.n_elem != n))
+  {
+    throw std::invalid_argument("BayesianOptimization::Optimize(): "
+        "categoricalDimensions and numCategories must have as many elements as "
+        "the coordinates");
+  }
+
+  // Expand the bounds to one value per element.
+  arma::vec lower(n), upper(n);
+  if (lowerBound.n_elem == 1)
+    lower.fill(lowerBound(0));
+  else if (lowerBound.n_elem == n)
+    lower = arma::vectorise(lowerBound);
+  else
+    throw std::invalid_argument("BayesianOptimization::Optimize(): the lower "
+        "bound must have one element or as many elements as the coordinates");
+
+  if (upperBound.n_elem == 1)
+    upper.fill(upperBound(0));
+  else if (upperBound.n_elem == n)
+    upper = arma::vectorise(upperBound);
+  else
+    throw std::invalid_argument("BayesianOptimization::Optimize(): the upper "
+        "bound must have one element or as many elements as the coordinates");
+
+  // The coordinates are scaled to [0, 1] in the continuous dimensions, and
+  // categorical dimensions hold the index of the category.
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (IsCategorical(i))
+    {
+      if (numCategories(i) == 0)
+      {
+        throw std::invalid_argument("BayesianOptimization::Optimize(): "
+            "categorical dimensions must have at least one category");
+      }
+
+      lower(i) = 0.0;
+      upper(i) = 1.0;
+    }
+    else if (!std::isfinite(lower(i)) || !std::isfinite(upper(i)) ||
+        !(upper(i) > lower(i)))
+    {
+      throw std::invalid_argument("BayesianOptimization::Optimize(): the "
+          "bounds must be finite, and the upper bound must be larger than the "
+          "lower bound");
+    }
+  }
+  const arma::vec range = upper - lower;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+
+  // The initial design: the starting point, followed by a Latin hypercube.
+  const size_t numInitial = std::max<size_t>(1, std::min(numInitialPoints,
+      maxEvaluations));
+  arma::mat scaled(n, numInitial);
+  scaled.col(0) = (arma::conv_to<arma::vec>::from(arma::vectorise(iterate)) -
+      lower) / range;
+  if (numInitial > 1)
+  {
+    LatinHypercubeSampler sampler;
+    sampler.Reset(n, numInitial - 1);
+    arma::mat design(n, numInitial - 1);
+    sampler.Sample(design);
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (IsCategorical(i))
+        design.row(i) = arma::floor(design.row(i) * numCategories(i));
+    }
+    scaled.cols(1, numInitial - 1) = design;
+  }
+
+  GaussianProcess gp(lengthScale, noiseVariance, categoricalDimensions);
+
+  ElemType bestObjective = std::numeric_limits<ElemType>::max();
+  arma::vec bestPoint;
+  double worstResponse = -std::numeric_limits<double>::max();
+  size_t numEvaluations = 0;
+  arma::vec values;
+  std::vector<BaseMatType> candidates;
+  while (!terminate)
+  {
+    // Map the points to the box (rounding categorical dimensions to the
+    // nearest category), and evaluate them in parallel, if OpenMP is enabled.
+    for (size_t j = 0; j < scaled.n_cols; ++j)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (IsCategorical(i))
+        {
+          scaled(i, j) = std::min(std::max(std::round(scaled(i, j)), 0.0),
+              double(numCategories(i) - 1));
+        }
+        else
+        {
+          scaled(i, j) = std::min(std::max(scaled(i, j), 0.0), 1.0);
+        }
+      }
+    }
+
+    candidates.resize(scaled.n_cols);
+    values.set_size(scaled.n_cols);
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t j = 0; j < (ptrdiff_t) scaled.n_cols; ++j)
+    {
+      candidates[j] = arma::conv_to<BaseMatType>::from(arma::reshape(
+          lower + range % scaled.col(j), iterate.n_rows, iterate.n_cols));
+      values(j) = (double) function.Evaluate(candidates[j]);
+    }
+    numEvaluations += scaled.n_cols;
+
+    for (size_t j = 0; j < scaled.n_cols && !terminate; ++j)
+    {
+      terminate |= Callback::Evaluate(*this, function, candidates[j],
+          ElemType(values(j)), callbacks...);
+
+      // Only finite values can be the best, so that a failed first evaluation
+      // does not hide every later one.
+      if (std::isfinite(values(j)) &&
+          (ElemType(values(j)) < bestObjective || bestPoint.is_empty()))
+      {
+        bestObjective = ElemType(values(j));
+        bestPoint = scaled.col(j);
+        iterate = candidates[j];
+      }
+
+      // A failed evaluation is given the worst value observed so far, so that
+      // the surrogate steers away from it.
+      if (std::isfinite(values(j)))
+      {
+        worstResponse = std::max(worstResponse, values(j));
+        gp.Add(scaled.col(j), values(j));
+      }
+      else if (gp.NumPoints() > 0)
+      {
+        gp.Add(scaled.col(j), worstResponse);
+      }
+    }
+
+    terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+
+    if (numEvaluations >= maxEvaluations || terminate)
+      break;
+
+    if (gp.NumPoints() == 0)
+    {
+      // Nothing is known yet; draw random points.
+      scaled = RandomPoints(n, std::min(std::max<size_t>(1, batchSize),
+          maxEvaluations - numEvaluations));
+      continue;
+    }
+
+    scaled = ProposeBatch(gp, std::min(std::max<size_t>(1, batchSize),
+        maxEvaluations - numEvaluations), bestPoint);
+  }
+
+  Info << "BayesianOptimization: best objective " << bestObjective << " after "
+      << numEvaluations << " evaluations." << std::endl;
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return bestObjective;
+}
+
+template<typename AcquisitionType>
+inline arma::mat BayesianOptimizationType<AcquisitionType>::ProposeBatch(
+    const GaussianProcess& gp,
+    const size_t numPoints,
+    const arma::vec& bestPoint)
+{
+  const size_t n = bestPoint.n_elem;
+  const double best = gp.MinResponse();
+
+  // The starting points of L_BFGS are the best of a set of random candidates.
+  const arma::mat candidates = RandomPoints(n, std::max<size_t>(1000,
+      100 * n));
+
+  // Estimate the Lipschitz constant of the posterior mean for the penalizers
+  // (only needed for batches).
+  double lipschitz = 1e-7;
+  if (numPoints > 1)
+  {
+    double mean, variance;
+    arma::vec dMean, dVariance;
+    for (size_t j = 0; j < candidates.n_cols; ++j)
+    {
+      gp.Predict(candidates.col(j), mean, variance, dMean, dVariance);
+      lipschitz = std::max(lipschitz, arma::norm(dMean));
+    }
+  }
+
+  arma::mat proposals(n, numPoints);
+  arma::mat pending(n, 0);
+  arma::vec pendingMeans, pendingStddevs;
+  arma::vec values(candidates.n_cols);
+  for (size_t p = 0; p < numPoints; ++p)
+  {
+    PenalizedAcquisition<AcquisitionType> f(gp, acquisition, best, pending,
+        pendingMeans, pendingStddevs, lipschitz);
+
+    for (size_t j = 0; j < candidates.n_cols; ++j)
+      values(j) = f.Value(candidates.col(j));
+
+    const arma::uvec order = arma::sort_index(values, "descend");
+    arma::vec proposal = candidates.col(order(0));
+    double proposalValue = values(order(0));
+
+    // Refine the best candidates, and the best observed point, with L_BFGS.
+    const size_t starts = std::min(numStarts, (size_t) candidates.n_cols);
+    for (size_t s = 0; s <= starts; ++s)
+    {
+      arma::mat u = (s < starts) ? arma::mat(candidates.col(order(s))) :
+          arma::mat(bestPoint);
+      lbfgs.Optimize(f, u);
+
+      const arma::vec x = f.Project(u);
+      const double value = f.Value(x);
+      if (std::isfinite(value) && value > proposalValue)
+      {
+        proposal = x;
+        proposalValue = value;
+      }
+    }
+
+    proposals.col(p) = proposal;
+
+    // Penalize the neighbourhood of the proposal for the rest of the batch.
+    if (p + 1 < numPoints)
+    {
+      double mean, variance;
+      gp.Predict(proposal, mean, variance);
+      pending.insert_cols(p, proposal);
+      pendingMeans.resize(p + 1);
+      pendingMeans(p) = mean;
+      pendingStddevs.resize(p + 1);
+      pendingStddevs(p) = std::sqrt(variance);
+    }
+  }
+
+  return proposals;
+}
+
+template<typename AcquisitionType>
+inline arma::mat BayesianOptimizationType<AcquisitionType>::RandomPoints(
+    const size_t dimensions,
+    const size_t numPoints) const
+{
+  arma::mat points(dimensions, numPoints, arma::fill::randu);
+  for (size_t i = 0; i < dimensions; ++i)
+  {
+    if (IsCategorical(i))
+    {
+      points.row(i) = arma::clamp(arma::floor(points.row(i) *
+          numCategories(i)), 0.0, double(numCategories(i) - 1));
+    }
+  }
+  return points;
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * @file gaussian_process.hpp
+ *
+ * Gaussian process surrogate with incremental Cholesky updates, for Bayesian
+ * optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_GAUSSIAN_PROCESS_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_GAUSSIAN_PROCESS_HPP
+
+namespace ens {
+
+/**
+ * A Gaussian process regression model with a Matern 5/2 kernel of unit signal
+ * variance,
+ *
+ *   k(x, x') = (1 + sqrt(5) r / l + 5 r^2 / (3 l^2)) exp(-sqrt(5) r / l),
+ *
+ * where r is the distance between x and x'.  Continuous dimensions contribute
+ * their squared difference to r^2, and categorical dimensions contribute 1 if
+ * the categories differ.  The responses are standardized before fitting.
+ *
+ * Points are added one at a time: the Cholesky factor of the kernel matrix is
+ * extended by one row, which costs O(n^2) for n points instead of the O(n^3)
+ * of a new factorization.
+ */
+class GaussianProcess
+{
+ public:
+  /**
+   * Construct the Gaussian process.
+   *
+   * @param lengthScale Length scale l of the kernel.
+   * @param noiseVariance Variance of the observation noise (relative to the
+   *     variance of the responses); a small value also keeps the kernel matrix
+   *     well conditioned.
+   * @param categorical For each dimension, whether it is categorical; empty
+   *     means all dimensions are continuous.
+   */
+  GaussianProcess(const double lengthScale = 0.2,
+                  const double noiseVariance = 1e-6,
+                  const std::vector<bool>& categorical = std::vector<bool>()) :
+      lengthScale(lengthScale),
+      noiseVariance(noiseVariance),
+      categorical(categorical),
+      responseMean(0.0),
+      responseStd(1.0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Add an observation, extending the Cholesky factor by one row.
+   *
+   * @param x Location of the observation.
+   * @param y Observed response.
+   */
+  void Add(const arma::vec& x, const double y)
+  {
+    const size_t n = points.n_cols;
+
+    // The new row l of the factor solves L l = k(X, x).
+    arma::vec l;
+    if (n > 0)
+      l = arma::solve(arma::trimatl(cholesky), Kernel(x));
+    const double diagonal = 1.0 + noiseVariance - ((n > 0) ? arma::dot(l, l) :
+        0.0);
+
+    cholesky.resize(n + 1, n + 1);
+    if (n > 0)
+      cholesky.submat(n, 0, n, n - 1) = l.t();
+    cholesky(n, n) = std::sqrt(std::max(diagonal, 1e-12));
+
+    if (n == 0)
+      points = x;
+    else
+      points.insert_cols(n, x);
+    responses.resize(n + 1);
+    responses(n) = y;
+
+    // Standardize the responses and solve for the weights.
+    responseMean = arma::mean(responses);
+    responseStd = (n > 0) ? arma::stddev(responses) : 1.0;
+    if (!(responseStd > 0.0))
+      responseStd = 1.0;
+
+    alpha = arma::solve(arma::trimatu(cholesky.t()), arma::solve(
+        arma::trimatl(cholesky), (responses - responseMean) / responseStd));
+  }
+
+  /**
+   * Predict the standardized mean and variance of the latent function at x.
+   *
+   * @param x Location to predict at.
+   * @param mean Will be set to the posterior mean.
+   * @param variance Will be set to the posterior variance.
+   */
+  void Predict(const arma::vec& x, double& mean, double& variance) const
+  {
+    const arma::vec k = Kernel(x);
+    const arma::vec v = arma::solve(arma::trimatl(cholesky), k);
+    mean = arma::dot(k, alpha);
+    variance = std::max(1.0 - arma::dot(v, v), 0.0);
+  }
+
+  /**
+   * Predict the standardized mean and variance of the latent function at x,
+   * and their gradients with respect to the continuous dimensions of x (the
+   * gradients are zero along categorical dimensions).
+   *
+   * @param x Location to predict at.
+   * @param mean Will be set to the posterior mean.
+   * @param variance Will be set to the posterior variance.
+   * @param meanGradient Will be set to the gradient of the mean.
+   * @param varianceGradient Will be set to the gradient of the variance.
+   */
+  void Predict(const arma::vec& x,
+               double& mean,
+               double& variance,
+               arma::vec& meanGradient,
+               arma::vec& varianceGradient) const
+  {
+    arma::mat jacobian;
+    const arma::vec k = Kernel(x, jacobian);
+    const arma::vec v = arma::solve(arma::trimatl(cholesky), k);
+    mean = arma::dot(k, alpha);
+    variance = std::max(1.0 - arma::dot(v, v), 0.0);
+
+    // d(k^T K^-1 k) = 2 (K^-1 k)^T dk.
+    meanGradient = jacobian * alpha;
+    varianceGradient = -2.0 * jacobian * arma::solve(arma::trimatu(
+        cholesky.t()), v);
+  }
+
+  //! Get the smallest standardized response.
+  double MinResponse() const
+  {
+    return (arma::min(responses) - responseMean) / responseStd;
+  }
+
+  /**
+   * Compute the kernel distance between two points, as used by the kernel.
+   */
+  template<typename VecType1, typename VecType2>
+  double Distance(const VecType1& x, const VecType2& y) const
+  {
+    double distSq = 0.0;
+    for (size_t i = 0; i < x.n_elem; ++i)
+    {
+      if (IsCategorical(i))
+        distSq += (x(i) != y(i)) ? 1.0 : 0.0;
+      else
+        distSq += (x(i) - y(i)) * (x(i) - y(i));
+    }
+    return std::sqrt(distSq);
+  }
+
+  //! Return whether dimension i is categorical.
+  bool IsCategorical(const size_t i) const
+  {
+    return !categorical.empty() && categorical[i];
+  }
+
+  //! Get the number of observations.
+  size_t NumPoints() const { return points.n_cols; }
+
+  //! Get the length scale.
+  double LengthScale() const { return lengthScale; }
+  //! Get the noise variance.
+  double NoiseVariance() const { return noiseVariance; }
+
+ private:
+  //! Compute the kernel between x and all observations.
+  arma::vec Kernel(const arma::vec& x) const
+  {
+    const double s = std::sqrt(5.0) / lengthScale;
+    arma::vec k(points.n_cols);
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      const double sr = s * Distance(x, points.col(j));
+      k(j) = (1.0 + sr + sr * sr / 3.0) * std::exp(-sr);
+    }
+    return k;
+  }
+
+  /**
+   * Compute the kernel between x and all observations, and the gradients of
+   * the kernel values with respect to x, one column per observation.
+   */
+  arma::vec Kernel(const arma::vec& x, arma::mat& jacobian) const
+  {
+    const double s = std::sqrt(5.0) / lengthScale;
+    arma::vec k(points.n_cols);
+    jacobian.zeros(x.n_elem, points.n_cols);
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      const double sr = s * Distance(x, points.col(j));
+      const double e = std::exp(-sr);
+      k(j) = (1.0 + sr + sr * sr / 3.0) * e;
+
+      // dk/dx = -(s^2 / 3) (1 + s r) exp(-s r) (x - x_j).
+      const double scale = -(s * s / 3.0) * (1.0 + sr) * e;
+      for (size_t i = 0; i < x.n_elem; ++i)
+      {
+        if (!IsCategorical(i))
+          jacobian(i, j) = scale * (x(i) - points(i, j));
+      }
+    }
+    return k;
+  }
+
+  //! The length scale of the kernel.
+  double lengthScale;
+
+  //! The variance of the observation noise.
+  double noiseVariance;
+
+  //! Which dimensions are categorical.
+  std::vector<bool> categorical;
+
+  //! The observed locations, one per column.
+  arma::mat points;
+
+  //! The observed responses.
+  arma::vec responses;
+
+  //! The lower Cholesky factor of the kernel matrix.
+  arma::mat cholesky;
+
+  //! The weights K^-1 (y - mean) / std.
+  arma::vec alpha;
+
+  //! The mean of the responses.
+  double responseMean;
+
+  //! The standard deviation of the responses.
+  double responseStd;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file penalized_acquisition.hpp
+ *
+ * Acquisition function with local penalization, as maximized by Bayesian
+ * optimization to propose batches of points.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BAYESIAN_OPTIMIZATION_PENALIZED_ACQUISITION_HPP
+#define ENSMALLEN_BAYESIAN_OPTIMIZATION_PENALIZED_ACQUISITION_HPP
+
+#include "gaussian_process.hpp"
+
+namespace ens {
+
+/**
+ * The acquisition value a(x) of the Gaussian process posterior, multiplied by
+ * a local penalizer for each point already chosen for the current batch:
+ *
+ *   a(x) prod_j phi_j(x),
+ *   phi_j(x) = Phi((L ||x - x_j|| + best - mean_j) / stddev_j),
+ *
+ * which is the probability that x is not excluded by the L-Lipschitz ball
+ * around x_j, given the posterior at x_j.  With no pending points this is the
+ * plain acquisition function.
+ *
+ * The coordinates are scaled to [0, 1] in the continuous dimensions; as a
+ * function for L_BFGS, the negative penalized acquisition is evaluated at the
+ * projection onto the box, plus a quadratic penalty on the distance to the
+ * box.  Categorical dimensions have zero gradient, so they keep their value.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @inproceedings{Gonzalez2016,
+ *   author    = {Gonz{\'a}lez, Javier and Dai, Zhenwen and Hennig, Philipp and
+ *                Lawrence, Neil},
+ *   title     = {Batch {B}ayesian Optimization via Local Penalization},
+ *   booktitle = {Proceedings of the 19th International Conference on
+ *                Artificial Intelligence and Statistics (AISTATS)},
+ *   pages     = {648--657},
+ *   year      = {2016}
+ * }
+ * @endcode
+ *
+ * @tparam AcquisitionType Acquisition function of the posterior mean and
+ *     standard deviation.
+ */
+template<typename AcquisitionType>
+class PenalizedAcquisition
+{
+ public:
+  /**
+   * Construct the penalized acquisition function.
+   *
+   * @param gp Fitted Gaussian process.
+   * @param acquisition Acquisition function.
+   * @param best Smallest standardized response.
+   * @param pending Points already chosen for the batch, one per column.
+   * @param pendingMeans Posterior means at the pending points.
+   * @param pendingStddevs Posterior standard deviations at the pending points.
+   * @param lipschitz Estimate of the Lipschitz constant of the posterior mean.
+   */
+  PenalizedAcquisition(const GaussianProcess& gp,
+                       const AcquisitionType& acquisition,
+                       const double best,
+                       const arma::mat& pending,
+                       const arma::vec& pendingMeans,
+                       const arma::vec& pendingStddevs,
+                       const double lipschitz) :
+      gp(gp),
+      acquisition(acquisition),
+      best(best),
+      pending(pending),
+      pendingMeans(pendingMeans),
+      pendingStddevs(pendingStddevs),
+      lipschitz(lipschitz),
+      boxPenalty(1e3)
+  { /* Nothing to do. */ }
+
+  /**
+   * Compute the penalized acquisition value at a point in the box.
+   *
+   * @param x Point to evaluate at.
+   */
+  double Value(const arma::vec& x) const
+  {
+    double mean, variance;
+    gp.Predict(x, mean, variance);
+    double dMean, dStddev;
+    double value = acquisition.Evaluate(mean, std::sqrt(variance), best,
+        dMean, dStddev);
+    for (size_t j = 0; j < pending.n_cols; ++j)
+      value *= 0.5 * std::erfc(-Z(x, j));
+    return value;
+  }
+
+  //! Project the given coordinates onto the box.
+  arma::vec Project(const arma::mat& u) const
+  {
+    arma::vec x = arma::vectorise(u);
+    for (size_t i = 0; i < x.n_elem; ++i)
+    {
+      if (!gp.IsCategorical(i))
+        x(i) = std::min(std::max(x(i), 0.0), 1.0);
+    }
+    return x;
+  }
+
+  /**
+   * Evaluate the objective for L_BFGS.
+   *
+   * @param u Coordinates.
+   */
+  double Evaluate(const arma::mat& u)
+  {
+    const arma::vec x = Project(u);
+    return -Value(x) + boxPenalty * arma::accu(arma::square(
+        arma::vectorise(u) - x));
+  }
+
+  /**
+   * Evaluate the objective for L_BFGS and its gradient.
+   *
+   * @param u Coordinates.
+   * @param gradient Will be set to the gradient.
+   */
+  double EvaluateWithGradient(const arma::mat& u, arma::mat& gradient)
+  {
+    const arma::vec x = Project(u);
+
+    double mean, variance;
+    arma::vec dMean, dVariance;
+    gp.Predict(x, mean, variance, dMean, dVariance);
+    const double stddev = std::sqrt(variance);
+
+    double dAcqMean, dAcqStddev;
+    const double acq = acquisition.Evaluate(mean, stddev, best, dAcqMean,
+        dAcqStddev);
+    arma::vec dAcq = dAcqMean * dMean;
+    if (stddev > 1e-12)
+      dAcq += (dAcqStddev / (2.0 * stddev)) * dVariance;
+
+    // The gradient of the logarithm of the product of the penalizers.
+    double penalty = 1.0;
+    arma::vec dLogPenalty(x.n_elem, arma::fill::zeros);
+    for (size_t j = 0; j < pending.n_cols; ++j)
+    {
+      const double z = Z(x, j);
+      const double phi = 0.5 * std::erfc(-z);
+      penalty *= phi;
+
+      const double r = gp.Distance(x, pending.col(j));
+      if (phi > 0.0 && r > 0.0)
+      {
+        const double dz = lipschitz / (r * std::sqrt(2.0) * Stddev(j));
+        dLogPenalty += (std::exp(-z * z) / (std::sqrt(arma::datum::pi) *
+            phi)) * dz * (x - pending.col(j));
+      }
+    }
+
+    const double value = acq * penalty;
+    const arma::vec excess = arma::vectorise(u) - x;
+    arma::vec g = -(penalty * dAcq + value * dLogPenalty);
+    for (size_t i = 0; i < x.n_elem; ++i)
+    {
+      // Only the box penalty depends on clamped coordinates, and categorical
+      // dimensions are kept fixed.
+      if (gp.IsCategorical(i) || excess(i) != 0.0)
+        g(i) = 0.0;
+    }
+    g += 2.0 * boxPenalty * excess;
+
+    gradient = arma::reshape(g, u.n_rows, u.n_cols);
+    return -value + boxPenalty * arma::dot(excess, excess);
+  }
+
+ private:
+  //! Standard deviation at pending point j, bounded away from zero.
+  double Stddev(const size_t j) const
+  {
+    return std::max(pendingStddevs(j), 1e-6);
+  }
+
+  //! The argument of the penalizer of pending point j, divided by sqrt(2).
+  double Z(const arma::vec& x, const size_t j) const
+  {
+    return (lipschitz * gp.Distance(x, pending.col(j)) + best -
+        pendingMeans(j)) / (std::sqrt(2.0) * Stddev(j));
+  }
+
+  //! The Gaussian process.
+  const GaussianProcess& gp;
+
+  //! The acquisition function.
+  const AcquisitionType& acquisition;
+
+  //! The smallest standardized response.
+  double best;
+
+  //! The points already chosen for the batch.
+  const arma::mat& pending;
+
+  //! The posterior means at the pending points.
+  const arma::vec& pendingMeans;
+
+  //! The posterior standard deviations at the pending points.
+  const arma::vec& pendingStddevs;
+
+  //! The Lipschitz constant of the posterior mean.
+  double lipschitz;
+
+  //! Weight of the quadratic penalty outside of the box.
+  double boxPenalty;
+};
+
+} // namespace ens
+
+#endif
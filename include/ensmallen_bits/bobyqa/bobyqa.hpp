@@ -0,0 +1,260 @@
+/**
+ * @file bobyqa.hpp
+ *
+ * Derivative-free trust region method with quadratic interpolation models and
+ * bound constraints, in the style of Powell's BOBYQA.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BOBYQA_BOBYQA_HPP
+#define ENSMALLEN_BOBYQA_BOBYQA_HPP
+
+namespace ens {
+
+/**
+ * BOBYQA (Bound Optimization BY Quadratic Approximation) minimizes a function
+ * subject to bounds on the coordinates, using only function values.  It keeps
+ * a set of 2n + 1 interpolation points in n dimensions and a quadratic model
+ * that interpolates the function at these points.  Each iteration minimizes
+ * the model in a trust region around the best point, evaluates the function
+ * at the minimizer, and replaces one interpolation point by it.  The model is
+ * then changed by the update of least Frobenius norm of the change to its
+ * Hessian that keeps interpolating; the inverse of the matrix of this
+ * interpolation problem is updated in O(n^2) operations per replaced point.
+ *
+ * When the trust region steps stop making progress and some interpolation
+ * points are far from the best point, those are moved to improve the geometry
+ * of the interpolation set.  Up to numParallel such points are chosen at once
+ * and, if ensmallen is compiled with OpenMP, evaluated in parallel (as are the
+ * initial 2n + 1 points), so the function's Evaluate() must then be safe to
+ * call concurrently.
+ *
+ * This is a simplified version of Powell's method: the trust region subproblem
+ * is solved by truncated conjugate gradients that fix the variables at their
+ * bounds as they are hit, and the geometry steps maximize the Lagrange function
+ * of the moved point along a few lines instead of solving the full subproblem.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @techreport{Powell2009,
+ *   author      = {Powell, Michael J. D.},
+ *   title       = {The {BOBYQA} algorithm for bound constrained optimization
+ *                  without derivatives},
+ *   institution = {University of Cambridge},
+ *   number      = {NA2009/06},
+ *   year        = {2009}
+ * }
+ *
+ * @article{Powell2004,
+ *   author  = {Powell, Michael J. D.},
+ *   title   = {Least {F}robenius norm updating of quadratic models that
+ *              satisfy interpolation conditions},
+ *   journal = {Mathematical Programming},
+ *   volume  = {100},
+ *   number  = {1},
+ *   pages   = {183--215},
+ *   year    = {2004}
+ * }
+ * @endcode
+ *
+ * BOBYQA can optimize arbitrary functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class BOBYQA
+{
+ public:
+  /**
+   * Construct the BOBYQA optimizer with the given parameters.
+   *
+   * @param maxEvaluations Maximum number of function evaluations allowed (at
+   *     least 2n + 1 evaluations are always done).
+   * @param rhoBegin Initial trust region radius; about a tenth of the expected
+   *     distance to the minimum is a good choice.
+   * @param rhoEnd Final trust region radius; this is the accuracy required in
+   *     the coordinates.
+   * @param lowerBound Lower bound of the coordinates; either a single value
+   *     for all dimensions, or one value for each element of the coordinates.
+   * @param upperBound Upper bound of the coordinates; either a single value
+   *     for all dimensions, or one value for each element of the coordinates.
+   * @param numParallel Maximum number of geometry improving points evaluated
+   *     together (in parallel, if OpenMP is enabled).
+   */
+  BOBYQA(const size_t maxEvaluations = 10000,
+         const double rhoBegin = 0.5,
+         const double rhoEnd = 1e-6,
+         const arma::mat& lowerBound = -arma::datum::inf * arma::ones(1, 1),
+         const arma::mat& upperBound = arma::datum::inf * arma::ones(1, 1),
+         const size_t numParallel = 1);
+
+  /**
+   * Construct the BOBYQA optimizer with the given parameters, with the same
+   * bounds for all dimensions.
+   *
+   * @param maxEvaluations Maximum number of function evaluations allowed (at
+   *     least 2n + 1 evaluations are always done).
+   * @param rhoBegin Initial trust region radius.
+   * @param rhoEnd Final trust region radius.
+   * @param lowerBound Lower bound of every dimension.
+   * @param upperBound Upper bound of every dimension.
+   * @param numParallel Maximum number of geometry improving points evaluated
+   *     together (in parallel, if OpenMP is enabled).
+   */
+  BOBYQA(const size_t maxEvaluations,
+         const double rhoBegin,
+         const double rhoEnd,
+         const double lowerBound,
+         const double upperBound,
+         const size_t numParallel = 1);
+
+  /**
+   * Optimize the given function using BOBYQA.  The given starting point will
+   * be modified to store the finishing point of the algorithm, and the final
+   * objective value is returned.  The bounds must leave room for a box of size
+   * 2 * rhoBegin in every dimension; a starting point outside the bounds, or
+   * within rhoBegin of them, is moved.
+   *
+   * @tparam ArbitraryFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename ArbitraryFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(ArbitraryFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the maximum number of function evaluations.
+  size_t MaxEvaluations() const { return maxEvaluations; }
+  //! Modify the maximum number of function evaluations.
+  size_t& MaxEvaluations() { return maxEvaluations; }
+
+  //! Get the initial trust region radius.
+  double RhoBegin() const { return rhoBegin; }
+  //! Modify the initial trust region radius.
+  double& RhoBegin() { return rhoBegin; }
+
+  //! Get the final trust region radius.
+  double RhoEnd() const { return rhoEnd; }
+  //! Modify the final trust region radius.
+  double& RhoEnd() { return rhoEnd; }
+
+  //! Get the lower bound of the coordinates.
+  const arma::mat& LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the coordinates.
+  arma::mat& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the coordinates.
+  const arma::mat& UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the coordinates.
+  arma::mat& UpperBound() { return upperBound; }
+
+  //! Get the maximum number of geometry improving points evaluated together.
+  size_t NumParallel() const { return numParallel; }
+  //! Modify the maximum number of geometry improving points evaluated
+  //! together.
+  size_t& NumParallel() { return numParallel; }
+
+ private:
+  /**
+   * Build the matrix of the interpolation problem of least Frobenius norm for
+   * the given points (one offset from the base point per column).
+   */
+  static arma::mat InterpolationMatrix(const arma::mat& points);
+
+  /**
+   * Build the column of the interpolation matrix for the point s.
+   */
+  static arma::vec InterpolationColumn(const arma::mat& points,
+                                       const arma::vec& s);
+
+  /**
+   * Compute the denominators of the updates that replace each point by s;
+   * points whose replacement has a small denominator would make the
+   * interpolation set degenerate.
+   */
+  static arma::vec Denominators(const arma::mat& points,
+                                const arma::mat& inverse,
+                                const arma::vec& s);
+
+  /**
+   * Replace point t by s and update the inverse of the interpolation matrix.
+   * Nothing is changed, and false is returned, if the update is ill
+   * conditioned.
+   */
+  static bool ReplacePoint(arma::mat& points,
+                           arma::mat& inverse,
+                           const size_t t,
+                           const arma::vec& s);
+
+  /**
+   * Change the model by the least Frobenius norm update that makes it
+   * interpolate the given residuals at the given (already replaced) points.
+   */
+  static void UpdateModel(const arma::mat& points,
+                          const arma::mat& inverse,
+                          const std::vector<size_t>& indices,
+                          const arma::vec& residuals,
+                          double& modelConstant,
+                          arma::vec& modelGradient,
+                          arma::mat& modelHessian);
+
+  /**
+   * Approximately minimize the model g^T d + 0.5 d^T H d subject to
+   * ||d|| <= delta and sl <= d <= su with truncated conjugate gradients.
+   */
+  static arma::vec TrustRegionStep(const arma::vec& g,
+                                   const arma::mat& hessian,
+                                   const double delta,
+                                   const arma::vec& sl,
+                                   const arma::vec& su);
+
+  /**
+   * Find a point within the given radius of the best point (and within sl
+   * and su, relative to the base point) where the Lagrange function of point
+   * k is large, so that replacing point k by it improves the geometry of the
+   * interpolation set.  Returns false if no such point is found.
+   */
+  static bool GeometryStep(const arma::mat& points,
+                           const arma::mat& inverse,
+                           const size_t k,
+                           const size_t best,
+                           const double radius,
+                           const arma::vec& sl,
+                           const arma::vec& su,
+                           arma::vec& s);
+
+  //! The maximum number of function evaluations.
+  size_t maxEvaluations;
+
+  //! The initial trust region radius.
+  double rhoBegin;
+
+  //! The final trust region radius.
+  double rhoEnd;
+
+  //! Lower bound of the coordinates.
+  arma::mat lowerBound;
+
+  //! Upper bound of the coordinates.
+  arma::mat upperBound;
+
+  //! The maximum number of geometry improving points evaluated together.
+  size_t numParallel;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "bobyqa_impl.hpp"
+
+#endif
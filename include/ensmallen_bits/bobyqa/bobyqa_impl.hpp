@@ -0,0 +1,666 @@
+/**
+ * @file bobyqa_impl.hpp
+ *
+ * Implementation of the BOBYQA derivative-free trust region method.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_BOBYQA_BOBYQA_IMPL_HPP
+#define ENSMALLEN_BOBYQA_BOBYQA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "bobyqa.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline BOBYQA::BOBYQA(const size_t maxEvaluations,
+                      const double rhoBegin,
+                      const double rhoEnd,
+                      const arma::mat& lowerBound,
+                      const arma::mat& upperBound,
+                      const size_t numParallel) :
+    maxEvaluations(maxEvaluations),
+    rhoBegin(rhoBegin),
+    rhoEnd(rhoEnd),
+    lowerBound(lowerBound),
+    upperBound(upperBound),
+    numParallel(numParallel)
+{ /* Nothing to do. */ }
+
+inline BOBYQA::BOBYQA(const size_t maxEvaluations,
+                      const double rhoBegin,
+                      const double rhoEnd,
+                      const double lowerBound,
+                      const double upperBound,
+                      const size_t numParallel) :
+    maxEvaluations(maxEvaluations),
+    rhoBegin(rhoBegin),
+    rhoEnd(rhoEnd),
+    lowerBound(lowerBound * arma::ones(1, 1)),
+    upperBound(upperBound * arma::ones(1, 1)),
+    numParallel(numParallel)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename ArbitraryFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type BOBYQA::Optimize(
+    ArbitraryFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitraryFunctionTypeAPI<ArbitraryFunctionType,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  const size_t n = iterate.n_elem;
+  const size_t m = 2 * n + 1;
+
+  if (n == 0)
+  {
+    throw std::invalid_argument("BOBYQA::Optimize(): the coordinates must not "
+        "be empty");
+  }
+
+  if (rhoBegin <= 0.0 || rhoEnd <= 0.0 || rhoEnd > rhoBegin)
+  {
+    throw std::invalid_argument("BOBYQA::Optimize(): rhoBegin and rhoEnd must "
+        "be positive, and rhoEnd must not be larger than rhoBegin");
+  }
+
+  // Expand the bounds to one value per element.
+  arma::vec lower(n), upper(n);
+  if (lowerBound.n_elem == 1)
+    lower.fill(lowerBound(0));
+  else if (lowerBound.n_elem == n)
+    lower = arma::vectorise(lowerBound);
+  else
+    throw std::invalid_argument("BOBYQA::Optimize(): the lower bound must have "
+        "one element or as many elements as the coordinates");
+
+  if (upperBound.n_elem == 1)
+    upper.fill(upperBound(0));
+  else if (upperBound.n_elem == n)
+    upper = arma::vectorise(upperBound);
+  else
+    throw std::invalid_argument("BOBYQA::Optimize(): the upper bound must have "
+        "one element or as many elements as the coordinates");
+
+  if (arma::any(upper - lower < 2.0 * rhoBegin))
+  {
+    throw std::invalid_argument("BOBYQA::Optimize(): the difference between "
+        "the upper and the lower bound must be at least 2 * rhoBegin in every "
+        "dimension");
+  }
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+
+  // Move the base point into the bounds, at least rhoBegin away from them
+  // unless it is on a bound, and put two interpolation points along each
+  // coordinate direction; on a bound, both are on the feasible side.
+  arma::vec base = arma::conv_to<arma::vec>::from(arma::vectorise(iterate));
+  arma::mat points(n, m, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (base(i) <= lower(i))
+      base(i) = lower(i);
+    else if (base(i) < lower(i) + rhoBegin)
+      base(i) = lower(i) + rhoBegin;
+    else if (base(i) >= upper(i))
+      base(i) = upper(i);
+    else if (base(i) > upper(i) - rhoBegin)
+      base(i) = upper(i) - rhoBegin;
+
+    if (base(i) == lower(i))
+    {
+      points(i, 2 * i + 1) = rhoBegin;
+      points(i, 2 * i + 2) = 2.0 * rhoBegin;
+    }
+    else if (base(i) == upper(i))
+    {
+      points(i, 2 * i + 1) = -rhoBegin;
+      points(i, 2 * i + 2) = -2.0 * rhoBegin;
+    }
+    else
+    {
+      points(i, 2 * i + 1) = rhoBegin;
+      points(i, 2 * i + 2) = -rhoBegin;
+    }
+  }
+
+  // Evaluate the initial points (in parallel, if OpenMP is enabled).
+  std::vector<BaseMatType> candidates(m);
+  arma::vec values(m);
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t j = 0; j < (ptrdiff_t) m; ++j)
+  {
+    candidates[j] = arma::conv_to<BaseMatType>::from(arma::reshape(
+        base + points.col(j), iterate.n_rows, iterate.n_cols));
+    values(j) = (double) function.Evaluate(candidates[j]);
+  }
+  size_t numEvaluations = m;
+
+  for (size_t j = 0; j < m && !terminate; ++j)
+  {
+    terminate |= Callback::Evaluate(*this, function, candidates[j],
+        ElemType(values(j)), callbacks...);
+  }
+
+  // The initial model: the gradient and the diagonal of the Hessian follow
+  // from the values along each coordinate direction.
+  double modelConstant = values(0);
+  arma::vec modelGradient(n);
+  arma::mat modelHessian(n, n, arma::fill::zeros);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double a = points(i, 2 * i + 1);
+    const double b = points(i, 2 * i + 2);
+    const double da = (values(2 * i + 1) - values(0)) / a;
+    const double db = (values(2 * i + 2) - values(0)) / b;
+    modelHessian(i, i) = 2.0 * (da - db) / (a - b);
+    modelGradient(i) = da - 0.5 * modelHessian(i, i) * a;
+  }
+
+  arma::mat inverse = arma::inv(InterpolationMatrix(points));
+
+  size_t best = values.index_min();
+
+  // The best evaluated point, which may have been dropped from the
+  // interpolation set (or never entered it).
+  double bestObjective = values(best);
+  BaseMatType bestCoordinates = candidates[best];
+
+  double rho = rhoBegin;
+  double delta = rhoBegin;
+  arma::vec sl(n), su(n);
+  while (numEvaluations < maxEvaluations && !terminate)
+  {
+    // Shift the base point to the best point when the best point is far from
+    // it, to keep the interpolation matrix well conditioned.
+    const arma::vec bestPoint = points.col(best);
+    if (arma::dot(bestPoint, bestPoint) >= 1e3 * delta * delta)
+    {
+      const arma::mat shifted = points.each_col() - bestPoint;
+      arma::mat shiftedInverse;
+      if (arma::inv(shiftedInverse, InterpolationMatrix(shifted)))
+      {
+        modelConstant += arma::dot(modelGradient, bestPoint) + 0.5 *
+            arma::dot(bestPoint, modelHessian * bestPoint);
+        modelGradient += modelHessian * bestPoint;
+        points = shifted;
+        base += bestPoint;
+        inverse = std::move(shiftedInverse);
+      }
+    }
+
+    // Solve the trust region subproblem around the best point.
+    const arma::vec sBest = points.col(best);
+    const arma::vec gBest = modelGradient + modelHessian * sBest;
+    sl = lower - base - sBest;
+    su = upper - base - sBest;
+    const arma::vec d = TrustRegionStep(gBest, modelHessian, delta, sl, su);
+    const double dNorm = arma::norm(d);
+
+    const bool shortStep = (dNorm < 0.5 * rho);
+    double ratio = -1.0;
+    if (shortStep)
+    {
+      // The step is too short to be worth an evaluation.
+      delta = (0.1 * delta > 1.5 * rho) ? 0.1 * delta : rho;
+    }
+    else
+    {
+      const arma::vec s = arma::min(arma::max(sBest + d, lower - base),
+          upper - base);
+      const BaseMatType candidate = arma::conv_to<BaseMatType>::from(
+          arma::reshape(base + s, iterate.n_rows, iterate.n_cols));
+      const double fNew = (double) function.Evaluate(candidate);
+      ++numEvaluations;
+      terminate |= Callback::Evaluate(*this, function, candidate,
+          ElemType(fNew), callbacks...);
+      if (fNew < bestObjective)
+      {
+        bestObjective = fNew;
+        bestCoordinates = candidate;
+      }
+
+      // Compare the actual and the predicted reduction, and update the trust
+      // region radius.
+      const double fBest = values(best);
+      const double predicted = -arma::dot(gBest, d) - 0.5 * arma::dot(d,
+          modelHessian * d);
+      if (predicted > 0.0)
+        ratio = (fBest - fNew) / predicted;
+
+      if (ratio <= 0.1)
+        delta = std::min(0.5 * delta, dNorm);
+      else if (ratio <= 0.7)
+        delta = std::max(0.5 * delta, dNorm);
+      else
+        delta = std::max(0.5 * delta, 2.0 * dNorm);
+      if (delta <= 1.5 * rho)
+        delta = rho;
+
+      // Replace the point that keeps the interpolation set best conditioned,
+      // preferring points far from the best point.  The best point is only
+      // replaced by a better one.
+      const arma::vec denominators = Denominators(points, inverse, s);
+      size_t t = m;
+      double largest = 0.0;
+      for (size_t j = 0; j < m; ++j)
+      {
+        if (j == best && fNew >= fBest)
+          continue;
+
+        const double distSq = arma::accu(arma::square(points.col(j) - sBest));
+        const double weight = std::max(1.0, distSq * distSq /
+            (delta * delta * delta * delta));
+        if (weight * std::abs(denominators(j)) > largest)
+        {
+          largest = weight * std::abs(denominators(j));
+          t = j;
+        }
+      }
+
+      if (t < m)
+      {
+        const double residual = fNew - (modelConstant + arma::dot(
+            modelGradient, s) + 0.5 * arma::dot(s, modelHessian * s));
+        if (ReplacePoint(points, inverse, t, s))
+        {
+          UpdateModel(points, inverse, std::vector<size_t>(1, t),
+              arma::vec(1).fill(residual), modelConstant, modelGradient,
+              modelHessian);
+          values(t) = fNew;
+          if (fNew < values(best))
+            best = t;
+        }
+      }
+    }
+
+    if (shortStep || ratio <= 0.1)
+    {
+      // Move the points that are far from the best point, farthest first.
+      const arma::vec distSq = arma::sum(arma::square(points.each_col() -
+          points.col(best)), 0).t();
+      const arma::uvec order = arma::sort_index(distSq, "descend");
+      const double threshold = std::max(delta * delta, 4.0 * rho * rho);
+
+      const size_t maxMoved = std::max<size_t>(numParallel, 1);
+      std::vector<size_t> moved;
+      std::vector<arma::vec> newPoints;
+      sl = lower - base;
+      su = upper - base;
+      for (size_t j = 0; j < m && moved.size() < maxMoved &&
+          distSq(order(j)) > threshold; ++j)
+      {
+        const size_t k = order(j);
+        const double radius = std::max(std::min(0.1 * std::sqrt(distSq(k)),
+            delta), rho);
+        arma::vec s;
+        // The inverse already accounts for the points chosen before, so that
+        // the new points do not collapse onto each other.
+        if (GeometryStep(points, inverse, k, best, radius, sl, su, s) &&
+            ReplacePoint(points, inverse, k, s))
+        {
+          moved.push_back(k);
+          newPoints.push_back(s);
+        }
+      }
+
+      if (!moved.empty())
+      {
+        // Evaluate all new points together (in parallel, if OpenMP is
+        // enabled).
+        arma::vec newValues(moved.size());
+        candidates.resize(moved.size());
+        ENS_PRAGMA_OMP_PARALLEL_FOR
+        for (ptrdiff_t j = 0; j < (ptrdiff_t) moved.size(); ++j)
+        {
+          candidates[j] = arma::conv_to<BaseMatType>::from(arma::reshape(
+              base + newPoints[j], iterate.n_rows, iterate.n_cols));
+          newValues(j) = (double) function.Evaluate(candidates[j]);
+        }
+        numEvaluations += moved.size();
+
+        arma::vec residuals(moved.size());
+        for (size_t j = 0; j < moved.size(); ++j)
+        {
+          terminate |= Callback::Evaluate(*this, function, candidates[j],
+              ElemType(newValues(j)), callbacks...);
+          if (newValues(j) < bestObjective)
+          {
+            bestObjective = newValues(j);
+            bestCoordinates = candidates[j];
+          }
+          residuals(j) = newValues(j) - (modelConstant + arma::dot(
+              modelGradient, newPoints[j]) + 0.5 * arma::dot(newPoints[j],
+              modelHessian * newPoints[j]));
+        }
+
+        UpdateModel(points, inverse, moved, residuals, modelConstant,
+            modelGradient, modelHessian);
+        for (size_t j = 0; j < moved.size(); ++j)
+        {
+          values(moved[j]) = newValues(j);
+          if (newValues(j) < values(best))
+            best = moved[j];
+        }
+      }
+      else if ((shortStep || ratio <= 0.0) && std::max(delta, dNorm) <= rho)
+      {
+        // The model is accurate at this resolution; reduce rho.
+        if (rho <= rhoEnd)
+        {
+          Info << "BOBYQA: trust region radius reached rhoEnd; terminating "
+              << "optimization." << std::endl;
+          break;
+        }
+
+        const double oldRho = rho;
+        if (rho > 250.0 * rhoEnd)
+          rho *= 0.1;
+        else if (rho > 16.0 * rhoEnd)
+          rho = std::sqrt(rho * rhoEnd);
+        else
+          rho = rhoEnd;
+        delta = std::max(0.5 * oldRho, rho);
+      }
+    }
+
+    iterate = arma::conv_to<BaseMatType>::from(arma::reshape(base +
+        points.col(best), iterate.n_rows, iterate.n_cols));
+    terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+  }
+
+  if (numEvaluations >= maxEvaluations)
+  {
+    Info << "BOBYQA: maximum function evaluations (" << maxEvaluations << ") "
+        << "reached; terminating optimization." << std::endl;
+  }
+
+  iterate = bestCoordinates;
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return ElemType(bestObjective);
+}
+
+inline arma::mat BOBYQA::InterpolationMatrix(const arma::mat& points)
+{
+  const size_t n = points.n_rows;
+  const size_t m = points.n_cols;
+
+  arma::mat w(m + n + 1, m + n + 1, arma::fill::zeros);
+  w.submat(0, 0, m - 1, m - 1) = 0.5 * arma::square(points.t() * points);
+  w.submat(0, m, m - 1, m).ones();
+  w.submat(m, 0, m, m - 1).ones();
+  w.submat(0, m + 1, m - 1, m + n) = points.t();
+  w.submat(m + 1, 0, m + n, m - 1) = points;
+  return w;
+}
+
+inline arma::vec BOBYQA::InterpolationColumn(const arma::mat& points,
+                                            const arma::vec& s)
+{
+  const size_t n = points.n_rows;
+  const size_t m = points.n_cols;
+
+  arma::vec w(m + n + 1);
+  w.head(m) = 0.5 * arma::square(points.t() * s);
+  w(m) = 1.0;
+  w.tail(n) = s;
+  return w;
+}
+
+inline arma::vec BOBYQA::Denominators(const arma::mat& points,
+                                      const arma::mat& inverse,
+                                      const arma::vec& s)
+{
+  const size_t m = points.n_cols;
+
+  const arma::vec w = InterpolationColumn(points, s);
+  const arma::vec hw = inverse * w;
+  const double sNormSq = arma::dot(s, s);
+  const double beta = 0.5 * sNormSq * sNormSq - arma::dot(w, hw);
+
+  const arma::vec alpha = inverse.diag();
+  return beta * alpha.head(m) + arma::square(hw.head(m));
+}
+
+inline bool BOBYQA::ReplacePoint(arma::mat& points,
+                                 arma::mat& inverse,
+                                 const size_t t,
+                                 const arma::vec& s)
+{
+  const arma::vec w = InterpolationColumn(points, s);
+  const arma::vec hw = inverse * w;
+  const double sNormSq = arma::dot(s, s);
+  const double alpha = inverse(t, t);
+  const double beta = 0.5 * sNormSq * sNormSq - arma::dot(w, hw);
+  const double tau = hw(t);
+  const double sigma = alpha * beta + tau * tau;
+  if (std::abs(sigma) <= 1e-12 * std::max(1.0, std::abs(alpha * beta)))
+    return false;
+
+  // Powell's update of the inverse; u = e_t - H w.
+  arma::vec u = -hw;
+  u(t) += 1.0;
+  const arma::vec ht = inverse.col(t);
+  inverse += (alpha * u * u.t() - beta * ht * ht.t() + tau * (ht * u.t() +
+      u * ht.t())) / sigma;
+
+  points.col(t) = s;
+  return true;
+}
+
+inline void BOBYQA::UpdateModel(const arma::mat& points,
+                                const arma::mat& inverse,
+                                const std::vector<size_t>& indices,
+                                const arma::vec& residuals,
+                                double& modelConstant,
+                                arma::vec& modelGradient,
+                                arma::mat& modelHessian)
+{
+  const size_t n = points.n_rows;
+  const size_t m = points.n_cols;
+
+  // The coefficients of the change are the columns of the inverse weighted by
+  // the residuals.
+  arma::vec coefficients(m + n + 1, arma::fill::zeros);
+  for (size_t j = 0; j < indices.size(); ++j)
+    coefficients += residuals(j) * inverse.col(indices[j]);
+
+  modelConstant += coefficients(m);
+  modelGradient += coefficients.tail(n);
+  modelHessian += points * arma::diagmat(coefficients.head(m)) * points.t();
+}
+
+inline arma::vec BOBYQA::TrustRegionStep(const arma::vec& g,
+                                         const arma::mat& hessian,
+                                         const double delta,
+                                         const arma::vec& sl,
+                                         const arma::vec& su)
+{
+  const size_t n = g.n_elem;
+  arma::vec d(n, arma::fill::zeros);
+  arma::vec gradient = g;
+
+  // Variables on a bound that the gradient pushes against stay fixed.
+  std::vector<bool> free(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    free[i] = !((sl(i) >= 0.0 && gradient(i) >= 0.0) ||
+        (su(i) <= 0.0 && gradient(i) <= 0.0));
+  }
+
+  arma::vec r(n), p(n), hp(n);
+  size_t totalIterations = 0;
+  bool restart = true;
+  while (restart && totalIterations < 2 * n + 5)
+  {
+    restart = false;
+    for (size_t i = 0; i < n; ++i)
+      r(i) = free[i] ? -gradient(i) : 0.0;
+    double rr = arma::dot(r, r);
+    const double rr0 = rr;
+    if (rr <= 1e-30)
+      break;
+
+    p = r;
+    for (size_t iter = 0; iter < n; ++iter, ++totalIterations)
+    {
+      hp = hessian * p;
+      const double pHp = arma::dot(p, hp);
+      const double dp = arma::dot(d, p);
+      const double pp = arma::dot(p, p);
+      const double remaining = delta * delta - arma::dot(d, d);
+      if (remaining <= 0.0)
+        return d;
+
+      // The largest steps to the trust region boundary, to a bound, and to
+      // the minimum along p.
+      const double toBoundary = (std::sqrt(dp * dp + pp * remaining) - dp) /
+          pp;
+      double toBound = arma::datum::inf;
+      size_t boundIndex = n;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (!free[i] || p(i) == 0.0)
+          continue;
+
+        const double limit = (p(i) > 0.0) ? (su(i) - d(i)) / p(i) :
+            (sl(i) - d(i)) / p(i);
+        if (limit < toBound)
+        {
+          toBound = limit;
+          boundIndex = i;
+        }
+      }
+      const double toMinimum = (pHp > 0.0) ? rr / pHp : arma::datum::inf;
+
+      const double step = std::min(toMinimum, std::min(toBoundary, toBound));
+      d += step * p;
+      gradient += step * hp;
+
+      if (step == toBoundary)
+        return d;
+
+      if (step == toBound)
+      {
+        // Fix the variable on its bound, and restart from the steepest
+        // descent direction of the remaining ones.
+        free[boundIndex] = false;
+        d(boundIndex) = (p(boundIndex) > 0.0) ? su(boundIndex) :
+            sl(boundIndex);
+        restart = true;
+        ++totalIterations;
+        break;
+      }
+
+      arma::vec rNew(n);
+      for (size_t i = 0; i < n; ++i)
+        rNew(i) = free[i] ? -gradient(i) : 0.0;
+      const double rrNew = arma::dot(rNew, rNew);
+      if (rrNew <= 1e-20 * rr0)
+        return d;
+
+      p = rNew + (rrNew / rr) * p;
+      r = std::move(rNew);
+      rr = rrNew;
+    }
+  }
+
+  return d;
+}
+
+inline bool BOBYQA::GeometryStep(const arma::mat& points,
+                                 const arma::mat& inverse,
+                                 const size_t k,
+                                 const size_t best,
+                                 const double radius,
+                                 const arma::vec& sl,
+                                 const arma::vec& su,
+                                 arma::vec& s)
+{
+  const size_t n = points.n_rows;
+  const size_t m = points.n_cols;
+
+  // The Lagrange function of point k is c + g^T s + 0.5 s^T H s with
+  // H = sum_j lambda_j s_j s_j^T, from column k of the inverse.
+  const arma::vec lambda = inverse.col(k).head(m);
+  const arma::mat hessian = points * arma::diagmat(lambda) * points.t();
+  const arma::vec sBest = points.col(best);
+  const arma::vec gradient = inverse.col(k).tail(n) + hessian * sBest;
+  const double value = (k == best) ? 1.0 : 0.0;
+
+  // Maximize the absolute value of the Lagrange function along the lines
+  // from the best point through the other points, and along its gradient.
+  double largest = -1.0;
+  for (size_t j = 0; j <= m; ++j)
+  {
+    if (j == best)
+      continue;
+
+    const arma::vec v = (j < m) ? arma::vec(points.col(j) - sBest) : gradient;
+    const double vNorm = arma::norm(v);
+    if (vNorm == 0.0)
+      continue;
+
+    // The range of steps that stays in the ball and in the bounds.
+    double aMax = radius / vNorm;
+    double aMin = -aMax;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (v(i) > 0.0)
+      {
+        aMax = std::min(aMax, (su(i) - sBest(i)) / v(i));
+        aMin = std::max(aMin, (sl(i) - sBest(i)) / v(i));
+      }
+      else if (v(i) < 0.0)
+      {
+        aMax = std::min(aMax, (sl(i) - sBest(i)) / v(i));
+        aMin = std::max(aMin, (su(i) - sBest(i)) / v(i));
+      }
+    }
+
+    const double gv = arma::dot(gradient, v);
+    const double vHv = arma::dot(v, hessian * v);
+    double steps[3] = { aMin, aMax, 0.0 };
+    size_t numSteps = 2;
+    if (vHv != 0.0 && -gv / vHv > aMin && -gv / vHv < aMax)
+      steps[numSteps++] = -gv / vHv;
+
+    for (size_t l = 0; l < numSteps; ++l)
+    {
+      const double a = steps[l];
+      const double lagrange = std::abs(value + a * gv + 0.5 * a * a * vHv);
+      if (lagrange > largest)
+      {
+        largest = lagrange;
+        s = sBest + a * v;
+      }
+    }
+  }
+
+  return (largest > 0.0);
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,334 @@
+/**
+ * @file early_stop_at_validation_loss.hpp
+ *
+ * Implementation of the early stop at validation loss callback function.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_CALLBACKS_EARLY_STOP_AT_VALIDATION_LOSS_HPP
+#define ENSMALLEN_CALLBACKS_EARLY_STOP_AT_VALIDATION_LOSS_HPP
+
+#include <deque>
+
+namespace ens {
+
+/**
+ * Early stopping on a held-out separable function.  Every evaluationInterval
+ * steps (or at the end of every epoch, if evaluationInterval is 0), the mean
+ * loss of the held-out function is estimated, either on all of its functions
+ * or on a stratified subsample: the functions are split into subsampleSize
+ * contiguous strata, and one function is drawn at random from each.
+ *
+ * The optimization stops once patience evaluations in a row did not improve
+ * the moving average of the last windowSize estimates significantly: an
+ * estimate counts as an improvement only if the moving average plus
+ * confidence times its standard error is below the best moving average so
+ * far.  With the defaults (a window of one and no confidence bound), this is
+ * EarlyStopAtMinLoss on the held-out loss.
+ *
+ * At the end of the optimization, the coordinates with the lowest held-out
+ * loss are restored (if restoreBest is true); the objective returned by the
+ * optimizer still refers to the last iterate.
+ *
+ * When ensmallen is compiled with OpenMP, the functions of a subsample are
+ * evaluated in parallel, so the Evaluate() method of the held-out function must
+ * then be safe to call concurrently.
+ *
+ * @tparam ValidationFunctionType Type of the held-out separable function.
+ * @tparam ModelMatType Type of the model coordinates.
+ */
+template<typename ValidationFunctionType, typename ModelMatType = arma::mat>
+class EarlyStopAtValidationLoss
+{
+ public:
+  /**
+   * Set up the early stop at validation loss class.
+   *
+   * @param validationFunction The held-out function; it must provide
+   *    NumFunctions() and Evaluate(coordinates, begin, batchSize).
+   * @param evaluationInterval The number of steps between two evaluations of
+   *    the held-out function; 0 evaluates at the end of every epoch.
+   * @param patience The number of evaluations without significant improvement
+   *    after which the optimization is terminated (Default: 10).
+   * @param subsampleSize The number of held-out functions to evaluate each
+   *    time; 0 evaluates all of them.
+   * @param windowSize The number of estimates in the moving average.
+   * @param confidence Number of standard errors by which the moving average
+   *    must improve on the best one.
+   * @param restoreBest Whether to restore the best coordinates at the end of
+   *    the optimization.
+   */
+  EarlyStopAtValidationLoss(ValidationFunctionType& validationFunction,
+                            const size_t evaluationInterval = 0,
+                            const size_t patience = 10,
+                            const size_t subsampleSize = 0,
+                            const size_t windowSize = 1,
+                            const double confidence = 0.0,
+                            const bool restoreBest = true) :
+      validationFunction(validationFunction),
+      evaluationInterval(evaluationInterval),
+      patience(patience),
+      subsampleSize(subsampleSize),
+      windowSize(std::max(windowSize, (size_t) 1)),
+      confidence(confidence),
+      restoreBest(restoreBest),
+      bestObjective(std::numeric_limits<double>::max()),
+      bestAverage(std::numeric_limits<double>::max()),
+      steps(0),
+      evaluations(0),
+      misses(0)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Callback function called at the begin of the optimization process.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void BeginOptimization(OptimizerType& /* optimizer */,
+                         FunctionType& /* function */,
+                         MatType& /* coordinates */)
+  {
+    bestObjective = std::numeric_limits<double>::max();
+    bestAverage = std::numeric_limits<double>::max();
+    steps = 0;
+    evaluations = 0;
+    misses = 0;
+    window.clear();
+    bestCoordinates.reset();
+  }
+
+  /**
+   * Callback function called once a step is taken.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& coordinates)
+  {
+    if (evaluationInterval == 0 || ++steps % evaluationInterval != 0)
+      return false;
+
+    return Validate(coordinates);
+  }
+
+  /**
+   * Callback function called at the end of a pass over the data.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param epoch The index of the current epoch.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& coordinates,
+                const size_t /* epoch */,
+                const double /* objective */)
+  {
+    if (evaluationInterval != 0)
+      return false;
+
+    return Validate(coordinates);
+  }
+
+  /**
+   * Callback function called at the end of the optimization process.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates The final coordinates.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  void EndOptimization(OptimizerType& /* optimizer */,
+                       FunctionType& /* function */,
+                       MatType& coordinates)
+  {
+    // If no held-out estimate was finite (e.g. the optimization diverged),
+    // there is nothing to restore.
+    if (restoreBest && !bestCoordinates.is_empty())
+      coordinates = bestCoordinates;
+  }
+
+  //! Get the best held-out loss.
+  double BestObjective() const { return bestObjective; }
+
+  //! Get the coordinates with the best held-out loss.
+  const ModelMatType& BestCoordinates() const { return bestCoordinates; }
+
+  //! Get the number of evaluations of the held-out function.
+  size_t Evaluations() const { return evaluations; }
+
+  //! Get the number of steps between two evaluations.
+  size_t EvaluationInterval() const { return evaluationInterval; }
+  //! Modify the number of steps between two evaluations.
+  size_t& EvaluationInterval() { return evaluationInterval; }
+
+  //! Get the patience.
+  size_t Patience() const { return patience; }
+  //! Modify the patience.
+  size_t& Patience() { return patience; }
+
+  //! Get the number of held-out functions evaluated each time.
+  size_t SubsampleSize() const { return subsampleSize; }
+  //! Modify the number of held-out functions evaluated each time.
+  size_t& SubsampleSize() { return subsampleSize; }
+
+  //! Get the number of estimates in the moving average.
+  size_t WindowSize() const { return windowSize; }
+  //! Modify the number of estimates in the moving average.
+  size_t& WindowSize() { return windowSize; }
+
+  //! Get the number of standard errors required for an improvement.
+  double Confidence() const { return confidence; }
+  //! Modify the number of standard errors required for an improvement.
+  double& Confidence() { return confidence; }
+
+  //! Get whether the best coordinates are restored.
+  bool RestoreBest() const { return restoreBest; }
+  //! Modify whether the best coordinates are restored.
+  bool& RestoreBest() { return restoreBest; }
+
+ private:
+  /**
+   * Estimate the held-out loss at the given coordinates, update the moving
+   * average and return whether the optimization should be terminated.
+   */
+  template<typename MatType>
+  bool Validate(const MatType& coordinates)
+  {
+    double mean, variance;
+    Estimate(coordinates, mean, variance);
+    ++evaluations;
+
+    if (mean < bestObjective)
+    {
+      bestObjective = mean;
+      // The buffer keeps its memory, so this does not allocate after the
+      // first improvement.
+      bestCoordinates = coordinates;
+    }
+
+    window.push_back(std::make_pair(mean, variance));
+    if (window.size() > windowSize)
+      window.pop_front();
+
+    double average = 0.0, averageVariance = 0.0;
+    for (size_t i = 0; i < window.size(); ++i)
+    {
+      average += window[i].first;
+      averageVariance += window[i].second;
+    }
+    average /= window.size();
+    averageVariance /= (window.size() * window.size());
+
+    if (average + confidence * std::sqrt(averageVariance) < bestAverage)
+    {
+      bestAverage = average;
+      misses = 0;
+      return false;
+    }
+
+    if (++misses >= patience)
+    {
+      Info << "Held-out loss stopped decreasing; terminate optimization."
+          << std::endl;
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * Estimate the mean held-out loss per function and the variance of the
+   * estimate.  The variance is 0 if all functions are evaluated.
+   */
+  template<typename MatType>
+  void Estimate(const MatType& coordinates, double& mean, double& variance)
+  {
+    const size_t numFunctions = validationFunction.NumFunctions();
+    if (subsampleSize == 0 || subsampleSize >= numFunctions)
+    {
+      mean = validationFunction.Evaluate(coordinates, 0, numFunctions) /
+          (double) numFunctions;
+      variance = 0.0;
+      return;
+    }
+
+    // Draw one function from each stratum.
+    const size_t n = subsampleSize;
+    arma::uvec indices(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      const size_t begin = (i * numFunctions) / n;
+      const size_t end = ((i + 1) * numFunctions) / n;
+      indices[i] = begin + std::min((size_t) (arma::randu() * (end - begin)),
+          end - begin - 1);
+    }
+
+    arma::vec losses(n);
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t i = 0; i < (ptrdiff_t) n; ++i)
+      losses[i] = validationFunction.Evaluate(coordinates, indices[i], 1);
+
+    mean = arma::mean(losses);
+    variance = (n > 1) ? arma::var(losses) / n : 0.0;
+  }
+
+  //! The held-out function.
+  ValidationFunctionType& validationFunction;
+
+  //! The number of steps between two evaluations (0 for every epoch).
+  size_t evaluationInterval;
+
+  //! The number of evaluations without improvement before terminating.
+  size_t patience;
+
+  //! The number of held-out functions evaluated each time (0 for all).
+  size_t subsampleSize;
+
+  //! The number of estimates in the moving average.
+  size_t windowSize;
+
+  //! The number of standard errors required for an improvement.
+  double confidence;
+
+  //! Whether to restore the best coordinates.
+  bool restoreBest;
+
+  //! The best held-out loss.
+  double bestObjective;
+
+  //! The best moving average of the held-out loss.
+  double bestAverage;
+
+  //! The number of steps taken.
+  size_t steps;
+
+  //! The number of evaluations of the held-out function.
+  size_t evaluations;
+
+  //! The number of evaluations since the last improvement.
+  size_t misses;
+
+  //! The last estimates of the mean and their variances.
+  std::deque<std::pair<double, double>> window;
+
+  //! The coordinates with the best held-out loss.
+  ModelMatType bestCoordinates;
+};
+
+} // namespace ens
+
+#endif
@@ -18,6 +18,8 @@
 
 #include "cne.hpp"
 
+#include <ensmallen_bits/function/memoized_function.hpp>
+
 namespace ens {
 
 inline CNE::CNE(const size_t populationSize,
@@ -109,6 +111,11 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
   Info << "CNE initialized successfully. Optimization started."
       << std::endl;
 
+  // Candidates that survive a generation unchanged (at least the best one)
+  // are not evaluated again; the cache holds one generation.
+  MemoizedFunction<ArbitraryFunctionType, BaseMatType> memoized(function,
+      populationSize);
+
   // Find the fitness before optimization using given iterate parameters.
   ElemType lastBestFitness = function.Evaluate(iterate);
   Callback::Evaluate(*this, function, iterate, lastBestFitness, callbacks...);
@@ -127,7 +134,7 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
           callbacks...);
 
        // Find fitness of candidate.
-       fitnessValues[i] = function.Evaluate(iterate);
+       fitnessValues[i] = memoized.Evaluate(iterate);
 
        Callback::Evaluate(*this, function, iterate, fitnessValues[i],
           callbacks...);
@@ -154,9 +161,13 @@ typename MatType::elem_type CNE::Optimize(ArbitraryFunctionType& function,
   // Set the best candidate into the network parameters.
   iterateIn = population[index(0)];
 
-  const ElemType objective = function.Evaluate(iterate);
+  const ElemType objective = memoized.Evaluate(iterate);
   Callback::Evaluate(*this, function, iterate, objective, callbacks...);
 
+  Info << "CNE: " << memoized.Hits() << " of " << memoized.Hits() +
+      memoized.Misses() << " fitness evaluations were answered from the "
+      << "cache." << std::endl;
+
   Callback::EndOptimization(*this, function, iterate, callbacks...);
   return objective;
 }
@@ -48,11 +48,13 @@
   #define ENS_PRAGMA_OMP_ATOMIC   _Pragma("omp atomic")
   #define ENS_PRAGMA_OMP_CRITICAL _Pragma("omp critical")
   #define ENS_PRAGMA_OMP_CRITICAL_NAMED _Pragma("omp critical(section)")
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR _Pragma("omp parallel for")
 #else
   #define ENS_PRAGMA_OMP_PARALLEL
   #define ENS_PRAGMA_OMP_ATOMIC
   #define ENS_PRAGMA_OMP_CRITICAL
   #define ENS_PRAGMA_OMP_CRITICAL_NAMED
+  #define ENS_PRAGMA_OMP_PARALLEL_FOR
 #endif
 
 
@@ -125,8 +125,8 @@ typename MatType::elem_type DE::Optimize(FunctionType& function,
         }
       }
 
-      ElemType iterateValue = function.Evaluate(iterate);
-      Callback::Evaluate(*this, function, iterate, iterateValue, callbacks...);
+      // The fitness of the current member is already known.
+      ElemType iterateValue = fitnessValues[member];
 
       const ElemType mutantValue = function.Evaluate(mutant);
       Callback::Evaluate(*this, function, mutant, mutantValue, callbacks...);
@@ -0,0 +1,99 @@
+/**
+ * @file extern_templates.hpp
+ *
+ * Explicit instantiations of common optimizers for the abstract function types
+ * in function/function_base.hpp.  The ensmallen_instantiations library (built
+ * with the BUILD_INSTANTIATIONS CMake option) compiles them once; code that
+ * links against it and defines ENS_USE_EXTERN_TEMPLATES before including
+ * ensmallen declares them extern, so they are not compiled again in every
+ * translation unit.
+ *
+ * This file is included at the end of ensmallen.hpp and of every
+ * per-optimizer header, so each block is emitted once, as soon as the headers
+ * of its optimizer have been included.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_EXTERN_TEMPLATES_HPP
+#define ENSMALLEN_EXTERN_TEMPLATES_HPP
+
+/**
+ * The instantiations of each optimizer, for the given matrix type.  PREFIX is
+ * "template" for the explicit instantiation definitions in the library, and
+ * "extern template" for the declarations everywhere else.
+ */
+#define ENS_LBFGS_INSTANTIATIONS(PREFIX, MatType) \
+    PREFIX MatType::elem_type L_BFGS::Optimize< \
+        DifferentiableFunctionBase<MatType>, MatType, MatType>( \
+        DifferentiableFunctionBase<MatType>&, MatType&);
+
+#define ENS_GRADIENT_DESCENT_INSTANTIATIONS(PREFIX, MatType) \
+    PREFIX MatType::elem_type GradientDescent::Optimize< \
+        DifferentiableFunctionBase<MatType>, MatType, MatType>( \
+        DifferentiableFunctionBase<MatType>&, MatType&);
+
+#define ENS_SGD_INSTANTIATIONS(PREFIX, MatType) \
+    PREFIX MatType::elem_type SGD<VanillaUpdate, NoDecay>::Optimize< \
+        SeparableFunctionBase<MatType>, MatType, MatType>( \
+        SeparableFunctionBase<MatType>&, MatType&);
+
+#define ENS_ADAM_INSTANTIATIONS(PREFIX, MatType) \
+    PREFIX MatType::elem_type SGD<AdamUpdate, NoDecay>::Optimize< \
+        SeparableFunctionBase<MatType>, MatType, MatType>( \
+        SeparableFunctionBase<MatType>&, MatType&);
+
+#define ENS_CMAES_INSTANTIATIONS(PREFIX, MatType) \
+    PREFIX MatType::elem_type CMAES<FullSelection>::Optimize< \
+        SeparableFunctionBase<MatType>, MatType>( \
+        SeparableFunctionBase<MatType>&, MatType&);
+
+#endif
+
+#if defined(ENS_USE_EXTERN_TEMPLATES)
+
+#if defined(ENSMALLEN_LBFGS_LBFGS_HPP) && \
+    !defined(ENS_EXTERN_TEMPLATES_LBFGS)
+#define ENS_EXTERN_TEMPLATES_LBFGS
+namespace ens {
+ENS_LBFGS_INSTANTIATIONS(extern template, arma::mat)
+ENS_LBFGS_INSTANTIATIONS(extern template, arma::fmat)
+} // namespace ens
+#endif
+
+#if defined(ENSMALLEN_GRADIENT_DESCENT_GRADIENT_DESCENT_HPP) && \
+    !defined(ENS_EXTERN_TEMPLATES_GRADIENT_DESCENT)
+#define ENS_EXTERN_TEMPLATES_GRADIENT_DESCENT
+namespace ens {
+ENS_GRADIENT_DESCENT_INSTANTIATIONS(extern template, arma::mat)
+ENS_GRADIENT_DESCENT_INSTANTIATIONS(extern template, arma::fmat)
+} // namespace ens
+#endif
+
+#if defined(ENSMALLEN_SGD_SGD_HPP) && !defined(ENS_EXTERN_TEMPLATES_SGD)
+#define ENS_EXTERN_TEMPLATES_SGD
+namespace ens {
+ENS_SGD_INSTANTIATIONS(extern template, arma::mat)
+ENS_SGD_INSTANTIATIONS(extern template, arma::fmat)
+} // namespace ens
+#endif
+
+#if defined(ENSMALLEN_ADAM_ADAM_HPP) && !defined(ENS_EXTERN_TEMPLATES_ADAM)
+#define ENS_EXTERN_TEMPLATES_ADAM
+namespace ens {
+ENS_ADAM_INSTANTIATIONS(extern template, arma::mat)
+ENS_ADAM_INSTANTIATIONS(extern template, arma::fmat)
+} // namespace ens
+#endif
+
+#if defined(ENSMALLEN_CMAES_CMAES_HPP) && !defined(ENS_EXTERN_TEMPLATES_CMAES)
+#define ENS_EXTERN_TEMPLATES_CMAES
+namespace ens {
+ENS_CMAES_INSTANTIATIONS(extern template, arma::mat)
+ENS_CMAES_INSTANTIATIONS(extern template, arma::fmat)
+} // namespace ens
+#endif
+
+#endif
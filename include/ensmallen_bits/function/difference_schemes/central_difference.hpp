@@ -0,0 +1,85 @@
+/**
+ * @file central_difference.hpp
+ *
+ * Central differences for NumericalGradientFunction.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_CENTRAL_DIFFERENCE_HPP
+#define ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_CENTRAL_DIFFERENCE_HPP
+
+namespace ens {
+
+/**
+ * Central differences approximate each partial derivative by
+ *
+ * \f[
+ * \frac{\partial f}{\partial x_i} \approx
+ *     \frac{f(x + h_i e_i) - f(x - h_i e_i)}{2 h_i},
+ * \f]
+ *
+ * which costs two evaluations per coordinate and has an error of order h_i^2.
+ * The step of each coordinate is h_i = s max(|x_i|, 1) for a relative step s,
+ * whose default eps^(1/3) balances the truncation and rounding errors.
+ */
+class CentralDifference
+{
+ public:
+  //! Central differences do not need the objective at the coordinates.
+  static const bool NeedsObjective = false;
+
+  //! Get the default relative step for the given element type.
+  template<typename ElemType>
+  static double DefaultStep()
+  {
+    return std::cbrt(double(std::numeric_limits<ElemType>::epsilon()));
+  }
+
+  /**
+   * Compute the partial derivatives with respect to the coordinates in
+   * [begin, end), and store them in the same elements of gradient.
+   *
+   * @param evaluator Callable that returns the objective at a point.
+   * @param coordinates Coordinates to differentiate at.
+   * @param objective The objective at the coordinates (unused).
+   * @param gradient Gradient to store the partial derivatives into.
+   * @param relativeStep Relative step.
+   * @param begin First coordinate to differentiate with respect to.
+   * @param end One past the last coordinate.
+   */
+  template<typename EvaluatorType, typename MatType, typename GradType>
+  static void Gradient(const EvaluatorType& evaluator,
+                       const MatType& coordinates,
+                       const typename MatType::elem_type /* objective */,
+                       GradType& gradient,
+                       const double relativeStep,
+                       const size_t begin,
+                       const size_t end)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    MatType work(coordinates);
+    for (size_t i = begin; i < end; ++i)
+    {
+      const ElemType x = coordinates(i);
+      ElemType h = ElemType(relativeStep * std::max(std::abs(double(x)), 1.0));
+      // Make the step exactly representable, so that (x + h) - x == h.
+      const ElemType shifted = x + h;
+      h = shifted - x;
+
+      work(i) = shifted;
+      const ElemType forward = evaluator(work);
+      work(i) = x - h;
+      const ElemType backward = evaluator(work);
+      gradient(i) = (forward - backward) / (2 * h);
+      work(i) = x;
+    }
+  }
+};
+
+} // namespace ens
+
+#endif
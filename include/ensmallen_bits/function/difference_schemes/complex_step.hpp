@@ -0,0 +1,103 @@
+/**
+ * @file complex_step.hpp
+ *
+ * Complex-step differentiation for NumericalGradientFunction.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_COMPLEX_STEP_HPP
+#define ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_COMPLEX_STEP_HPP
+
+#include <complex>
+
+namespace ens {
+
+/**
+ * Complex-step differentiation computes each partial derivative by
+ *
+ * \f[
+ * \frac{\partial f}{\partial x_i} \approx \frac{Im f(x + i h_i e_i)}{h_i}.
+ * \f]
+ *
+ * There is no subtraction, so the step can be tiny and the result is accurate
+ * to machine precision, at the cost of one complex evaluation per coordinate.
+ * The function's Evaluate() must be a template that accepts
+ * arma::Mat<std::complex<ElemType>> and is real-analytic (no abs(), no
+ * comparisons of the point's elements, and so on).  The step of each
+ * coordinate is h_i = s max(|x_i|, 1) for a relative step s, eps by default.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Squire1998,
+ *   author  = {Squire, William and Trapp, George},
+ *   title   = {Using Complex Variables to Estimate Derivatives of Real
+ *              Functions},
+ *   journal = {SIAM Review},
+ *   volume  = {40},
+ *   number  = {1},
+ *   pages   = {110--112},
+ *   year    = {1998}
+ * }
+ * @endcode
+ */
+class ComplexStep
+{
+ public:
+  //! The complex step does not need the objective at the coordinates.
+  static const bool NeedsObjective = false;
+
+  //! Get the default relative step for the given element type.
+  template<typename ElemType>
+  static double DefaultStep()
+  {
+    return double(std::numeric_limits<ElemType>::epsilon());
+  }
+
+  /**
+   * Compute the partial derivatives with respect to the coordinates in
+   * [begin, end), and store them in the same elements of gradient.
+   *
+   * @param evaluator Callable that returns the objective at a point.
+   * @param coordinates Coordinates to differentiate at.
+   * @param objective The objective at the coordinates (unused).
+   * @param gradient Gradient to store the partial derivatives into.
+   * @param relativeStep Relative step.
+   * @param begin First coordinate to differentiate with respect to.
+   * @param end One past the last coordinate.
+   */
+  template<typename EvaluatorType, typename MatType, typename GradType>
+  static void Gradient(const EvaluatorType& evaluator,
+                       const MatType& coordinates,
+                       const typename MatType::elem_type /* objective */,
+                       GradType& gradient,
+                       const double relativeStep,
+                       const size_t begin,
+                       const size_t end)
+  {
+    typedef typename MatType::elem_type ElemType;
+    typedef std::complex<ElemType> ComplexType;
+
+    arma::Mat<ComplexType> work(coordinates.n_rows, coordinates.n_cols);
+    for (size_t i = 0; i < coordinates.n_elem; ++i)
+      work(i) = ComplexType(coordinates(i), ElemType(0));
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      const ElemType x = coordinates(i);
+      const ElemType h = ElemType(relativeStep *
+          std::max(std::abs(double(x)), 1.0));
+
+      work(i) = ComplexType(x, h);
+      gradient(i) = std::imag(evaluator(work)) / h;
+      work(i) = ComplexType(x, ElemType(0));
+    }
+  }
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file forward_difference.hpp
+ *
+ * Forward differences for NumericalGradientFunction.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_FORWARD_DIFFERENCE_HPP
+#define ENSMALLEN_FUNCTION_DIFFERENCE_SCHEMES_FORWARD_DIFFERENCE_HPP
+
+namespace ens {
+
+/**
+ * Forward differences approximate each partial derivative by
+ *
+ * \f[
+ * \frac{\partial f}{\partial x_i} \approx \frac{f(x + h_i e_i) - f(x)}{h_i},
+ * \f]
+ *
+ * which costs one evaluation per coordinate (plus f(x), which is usually known
+ * already) and has an error of order h_i.  The step of each coordinate is
+ * h_i = s max(|x_i|, 1) for a relative step s, whose default sqrt(eps)
+ * balances the truncation and rounding errors.
+ */
+class ForwardDifference
+{
+ public:
+  //! Forward differences need the objective at the coordinates.
+  static const bool NeedsObjective = true;
+
+  //! Get the default relative step for the given element type.
+  template<typename ElemType>
+  static double DefaultStep()
+  {
+    return std::sqrt(double(std::numeric_limits<ElemType>::epsilon()));
+  }
+
+  /**
+   * Compute the partial derivatives with respect to the coordinates in
+   * [begin, end), and store them in the same elements of gradient.
+   *
+   * @param evaluator Callable that returns the objective at a point.
+   * @param coordinates Coordinates to differentiate at.
+   * @param objective The objective at the coordinates.
+   * @param gradient Gradient to store the partial derivatives into.
+   * @param relativeStep Relative step.
+   * @param begin First coordinate to differentiate with respect to.
+   * @param end One past the last coordinate.
+   */
+  template<typename EvaluatorType, typename MatType, typename GradType>
+  static void Gradient(const EvaluatorType& evaluator,
+                       const MatType& coordinates,
+                       const typename MatType::elem_type objective,
+                       GradType& gradient,
+                       const double relativeStep,
+                       const size_t begin,
+                       const size_t end)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    MatType work(coordinates);
+    for (size_t i = begin; i < end; ++i)
+    {
+      const ElemType x = coordinates(i);
+      ElemType h = ElemType(relativeStep * std::max(std::abs(double(x)), 1.0));
+      // Make the step exactly representable, so that (x + h) - x == h.
+      const ElemType shifted = x + h;
+      h = shifted - x;
+
+      work(i) = shifted;
+      gradient(i) = (evaluator(work) - objective) / h;
+      work(i) = x;
+    }
+  }
+};
+
+} // namespace ens
+
+#endif
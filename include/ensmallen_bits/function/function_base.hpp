@@ -0,0 +1,152 @@
+/**
+ * @file function_base.hpp
+ *
+ * Abstract base classes for objective functions, so that optimizers can be
+ * instantiated once for all functions that derive from them.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_FUNCTION_BASE_HPP
+#define ENSMALLEN_FUNCTION_FUNCTION_BASE_HPP
+
+namespace ens {
+
+/**
+ * DifferentiableFunctionBase is an abstract differentiable function.  Every
+ * optimizer is a template on the type of the function, so each function type
+ * compiles its own copy of the optimizer; a function that derives from this
+ * class and is passed to the optimizer as a DifferentiableFunctionBase<MatType>
+ * reference shares one instantiation with all other such functions.  With
+ * ENS_USE_EXTERN_TEMPLATES defined, that instantiation is taken from the
+ * ensmallen_instantiations library for L_BFGS and GradientDescent, and not
+ * compiled at all (see extern_templates.hpp).
+ *
+ * @code
+ * class MyFunction : public ens::DifferentiableFunctionBase<arma::mat>
+ * {
+ *  public:
+ *   double Evaluate(const arma::mat& x) { ... }
+ *   void Gradient(const arma::mat& x, arma::mat& g) { ... }
+ * };
+ *
+ * MyFunction f;
+ * ens::DifferentiableFunctionBase<arma::mat>& base = f;
+ * ens::L_BFGS().Optimize(base, coordinates);
+ * @endcode
+ *
+ * The cost is one virtual call per evaluation.
+ *
+ * @tparam MatType Type of the coordinates and the gradient.
+ */
+template<typename MatType = arma::mat>
+class DifferentiableFunctionBase
+{
+ public:
+  //! The type of the objective values.
+  typedef typename MatType::elem_type ElemType;
+
+  virtual ~DifferentiableFunctionBase() { }
+
+  /**
+   * Return the objective at the given coordinates.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   */
+  virtual ElemType Evaluate(const MatType& coordinates) = 0;
+
+  /**
+   * Compute the gradient at the given coordinates.
+   *
+   * @param coordinates Coordinates to differentiate at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  virtual void Gradient(const MatType& coordinates, MatType& gradient) = 0;
+
+  /**
+   * Return the objective and compute the gradient at the given coordinates.
+   * By default this calls Evaluate() and Gradient(); override it if both can
+   * be computed together more cheaply.
+   *
+   * @param coordinates Coordinates to evaluate and differentiate at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  virtual ElemType EvaluateWithGradient(const MatType& coordinates,
+                                        MatType& gradient)
+  {
+    Gradient(coordinates, gradient);
+    return Evaluate(coordinates);
+  }
+};
+
+/**
+ * SeparableFunctionBase is an abstract differentiable separable function, the
+ * counterpart of DifferentiableFunctionBase for SGD-type optimizers and CMAES.
+ * With ENS_USE_EXTERN_TEMPLATES defined, the instantiations of StandardSGD,
+ * Adam and CMAES for it are taken from the ensmallen_instantiations library.
+ *
+ * @tparam MatType Type of the coordinates and the gradient.
+ */
+template<typename MatType = arma::mat>
+class SeparableFunctionBase
+{
+ public:
+  //! The type of the objective values.
+  typedef typename MatType::elem_type ElemType;
+
+  virtual ~SeparableFunctionBase() { }
+
+  //! Return the number of separable functions.
+  virtual size_t NumFunctions() const = 0;
+
+  //! Shuffle the order of the separable functions.
+  virtual void Shuffle() = 0;
+
+  /**
+   * Return the objective of the given batch of separable functions.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  virtual ElemType Evaluate(const MatType& coordinates,
+                            const size_t begin,
+                            const size_t batchSize) = 0;
+
+  /**
+   * Compute the gradient of the given batch of separable functions.
+   *
+   * @param coordinates Coordinates to differentiate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  virtual void Gradient(const MatType& coordinates,
+                        const size_t begin,
+                        MatType& gradient,
+                        const size_t batchSize) = 0;
+
+  /**
+   * Return the objective and compute the gradient of the given batch.  By
+   * default this calls Evaluate() and Gradient().
+   *
+   * @param coordinates Coordinates to evaluate and differentiate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  virtual ElemType EvaluateWithGradient(const MatType& coordinates,
+                                        const size_t begin,
+                                        MatType& gradient,
+                                        const size_t batchSize)
+  {
+    Gradient(coordinates, begin, gradient, batchSize);
+    return Evaluate(coordinates, begin, batchSize);
+  }
+};
+
+} // namespace ens
+
+#endif
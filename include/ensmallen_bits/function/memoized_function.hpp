@@ -0,0 +1,223 @@
+/**
+ * @file memoized_function.hpp
+ *
+ * A wrapper that caches the objective values of a function, so that points
+ * which are evaluated again do not cost another evaluation.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_MEMOIZED_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_MEMOIZED_FUNCTION_HPP
+
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace ens {
+
+/**
+ * MemoizedFunction wraps a function with an Evaluate() method and remembers
+ * the objective values of the most recently evaluated points, so that an
+ * optimizer that evaluates a point again (GridSearch run twice, an elite of
+ * CNE, a state that SA returns to, ...) gets the stored value instead of
+ * calling the function.  It can be passed to any optimizer for arbitrary
+ * functions in place of the wrapped function.
+ *
+ * Points are identified by their bytes; if a tolerance is given, every element
+ * is first rounded to the nearest multiple of the tolerance, so that points
+ * which round to the same values share one entry.  At most maxSize entries are
+ * kept, and the least recently used entry is dropped when the cache is full.
+ *
+ * Evaluate() may be called concurrently (for instance by optimizers that
+ * evaluate a population in parallel); the cache is protected by a mutex, and
+ * the wrapped function is called outside of it.
+ *
+ * @tparam FunctionType Type of the wrapped function.
+ * @tparam MatType Type of the coordinates the function is evaluated at.
+ */
+template<typename FunctionType, typename MatType = arma::mat>
+class MemoizedFunction
+{
+ public:
+  //! The type of the objective values.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Wrap the given function.  The function is held by reference, so it must
+   * outlive the MemoizedFunction.
+   *
+   * @param function Function to wrap.
+   * @param maxSize Maximum number of stored objective values (0 disables the
+   *     cache).
+   * @param tolerance If positive, the elements of the coordinates are rounded
+   *     to multiples of the tolerance before they are compared.
+   */
+  MemoizedFunction(FunctionType& function,
+                   const size_t maxSize = 10000,
+                   const double tolerance = 0.0) :
+      function(function),
+      maxSize(maxSize),
+      tolerance(tolerance),
+      hits(0),
+      misses(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Return the objective value at the given coordinates, evaluating the
+   * wrapped function only if the coordinates are not in the cache.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   */
+  ElemType Evaluate(const MatType& coordinates)
+  {
+    const std::string key = Key(coordinates);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      typename IndexType::iterator it = index.find(key);
+      if (it != index.end())
+      {
+        // Move the entry to the front of the list (most recently used).
+        entries.splice(entries.begin(), entries, it->second);
+        ++hits;
+        return it->second->second;
+      }
+      ++misses;
+    }
+
+    const ElemType objective = function.Evaluate(coordinates);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (maxSize > 0 && index.find(key) == index.end())
+    {
+      entries.push_front(std::make_pair(key, objective));
+      index[key] = entries.begin();
+      if (entries.size() > maxSize)
+      {
+        index.erase(entries.back().first);
+        entries.pop_back();
+      }
+    }
+    return objective;
+  }
+
+  //! Drop all stored objective values and reset the statistics.
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+  }
+
+  //! Get the number of evaluations answered from the cache.
+  size_t Hits() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+  }
+
+  //! Get the number of evaluations of the wrapped function.
+  size_t Misses() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+  }
+
+  //! Get the fraction of evaluations answered from the cache.
+  double HitRate() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (hits + misses == 0) ? 0.0 : double(hits) / double(hits + misses);
+  }
+
+  //! Get the number of stored objective values.
+  size_t Size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the maximum number of stored objective values.
+  size_t MaxSize() const { return maxSize; }
+  //! Modify the maximum number of stored objective values.
+  size_t& MaxSize() { return maxSize; }
+
+  //! Get the tolerance.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! The list of entries, most recently used first.
+  typedef std::list<std::pair<std::string, ElemType>> ListType;
+  //! The map from keys to entries.
+  typedef std::unordered_map<std::string, typename ListType::iterator>
+      IndexType;
+
+  //! Build the key of the given coordinates from their shape and elements.
+  std::string Key(const MatType& coordinates) const
+  {
+    const size_t shape[2] = { (size_t) coordinates.n_rows,
+                              (size_t) coordinates.n_cols };
+    const size_t elemSize = (tolerance > 0.0) ? sizeof(int64_t) :
+        sizeof(ElemType);
+
+    std::string key(sizeof(shape) + coordinates.n_elem * elemSize, '\0');
+    std::memcpy(&key[0], shape, sizeof(shape));
+    char* out = &key[sizeof(shape)];
+    for (size_t i = 0; i < coordinates.n_elem; ++i, out += elemSize)
+    {
+      if (tolerance > 0.0)
+      {
+        const int64_t q = (int64_t) std::floor(double(coordinates(i)) /
+            tolerance + 0.5);
+        std::memcpy(out, &q, elemSize);
+      }
+      else
+      {
+        // Adding zero turns -0 into +0, so that both have the same key.
+        const ElemType value = coordinates(i) + ElemType(0);
+        std::memcpy(out, &value, elemSize);
+      }
+    }
+    return key;
+  }
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The maximum number of stored objective values.
+  size_t maxSize;
+
+  //! The tolerance used to round the coordinates.
+  double tolerance;
+
+  //! The stored objective values, most recently used first.
+  ListType entries;
+
+  //! The position of each key in the list.
+  IndexType index;
+
+  //! The number of evaluations answered from the cache.
+  size_t hits;
+
+  //! The number of evaluations of the wrapped function.
+  size_t misses;
+
+  //! Protects the cache and the statistics.
+  mutable std::mutex mutex;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @file numerical_gradient_function.hpp
+ *
+ * Wrappers that give a function which only implements Evaluate() a gradient
+ * computed by finite differences or the complex step, so that it can be used
+ * with gradient-based optimizers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_FUNCTION_NUMERICAL_GRADIENT_FUNCTION_HPP
+#define ENSMALLEN_FUNCTION_NUMERICAL_GRADIENT_FUNCTION_HPP
+
+#include "difference_schemes/forward_difference.hpp"
+#include "difference_schemes/central_difference.hpp"
+#include "difference_schemes/complex_step.hpp"
+
+namespace ens {
+
+/**
+ * Approximate the gradient of the given callable at the given coordinates with
+ * the given difference scheme.  The coordinates are split into one contiguous
+ * block per thread, and the blocks are differentiated in parallel if ensmallen
+ * is compiled with OpenMP, so the callable must then be safe to call
+ * concurrently.
+ *
+ * @tparam DifferenceType Difference scheme (ForwardDifference,
+ *     CentralDifference or ComplexStep).
+ * @param evaluator Callable that returns the objective at a point.
+ * @param coordinates Coordinates to differentiate at.
+ * @param objective The objective at the coordinates; only used if
+ *     DifferenceType::NeedsObjective is true.
+ * @param gradient Matrix to store the gradient into.
+ * @param relativeStep Relative step of the scheme; 0 selects the scheme's
+ *     default for the element type.
+ */
+template<typename DifferenceType,
+         typename EvaluatorType,
+         typename MatType,
+         typename GradType>
+void NumericalGradient(const EvaluatorType& evaluator,
+                       const MatType& coordinates,
+                       const typename MatType::elem_type objective,
+                       GradType& gradient,
+                       const double relativeStep = 0.0)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const double step = (relativeStep > 0.0) ? relativeStep :
+      DifferenceType::template DefaultStep<ElemType>();
+
+  const size_t n = coordinates.n_elem;
+  gradient.set_size(coordinates.n_rows, coordinates.n_cols);
+  if (n == 0)
+    return;
+
+  size_t numBlocks = 1;
+  #ifdef ENS_USE_OPENMP
+    numBlocks = std::min((size_t) omp_get_max_threads(), n);
+  #endif
+  const size_t blockSize = (n + numBlocks - 1) / numBlocks;
+
+  // Each block perturbs its own copy of the coordinates.
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t b = 0; b < (ptrdiff_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(n, begin + blockSize);
+    if (begin < end)
+    {
+      DifferenceType::Gradient(evaluator, coordinates, objective, gradient,
+          step, begin, end);
+    }
+  }
+}
+
+/**
+ * NumericalGradientFunction wraps a function that only implements Evaluate()
+ * and adds Gradient() and EvaluateWithGradient(), approximated with the given
+ * difference scheme.  It is opt-in: pass the wrapper instead of the function
+ * to any optimizer for differentiable functions, such as L_BFGS.
+ *
+ * @code
+ * MyFunction f; // Only has Evaluate().
+ * NumericalGradientFunction<MyFunction> g(f);
+ * L_BFGS lbfgs;
+ * lbfgs.Optimize(g, coordinates);
+ * @endcode
+ *
+ * Each gradient costs one (forward differences, complex step) or two (central
+ * differences) evaluations per coordinate, spread over all threads when OpenMP
+ * is enabled; the function's Evaluate() must then be safe to call
+ * concurrently.  With ComplexStep, Evaluate() must be a template that also
+ * accepts complex matrices.
+ *
+ * @tparam FunctionType Type of the wrapped function.
+ * @tparam DifferenceType Difference scheme (ForwardDifference,
+ *     CentralDifference or ComplexStep).
+ */
+template<typename FunctionType, typename DifferenceType = CentralDifference>
+class NumericalGradientFunction
+{
+ public:
+  /**
+   * Wrap the given function.  The function is held by reference, so it must
+   * outlive the wrapper.
+   *
+   * @param function Function to wrap.
+   * @param relativeStep Relative step of the difference scheme; 0 selects the
+   *     scheme's default.
+   */
+  NumericalGradientFunction(FunctionType& function,
+                            const double relativeStep = 0.0) :
+      function(function),
+      relativeStep(relativeStep)
+  { /* Nothing to do. */ }
+
+  /**
+   * Evaluate the wrapped function at the given coordinates.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    return function.Evaluate(coordinates);
+  }
+
+  /**
+   * Approximate the gradient at the given coordinates.
+   *
+   * @param coordinates Coordinates to differentiate at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates, GradType& gradient)
+  {
+    typedef typename MatType::elem_type ElemType;
+    const ElemType objective = DifferenceType::NeedsObjective ?
+        function.Evaluate(coordinates) : ElemType(0);
+    NumericalGradient<DifferenceType>(Evaluator(function), coordinates,
+        objective, gradient, relativeStep);
+  }
+
+  /**
+   * Evaluate the wrapped function and approximate its gradient at the given
+   * coordinates.
+   *
+   * @param coordinates Coordinates to evaluate and differentiate at.
+   * @param gradient Matrix to store the gradient into.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(const MatType& coordinates,
+                                                   GradType& gradient)
+  {
+    const typename MatType::elem_type objective =
+        function.Evaluate(coordinates);
+    NumericalGradient<DifferenceType>(Evaluator(function), coordinates,
+        objective, gradient, relativeStep);
+    return objective;
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the relative step.
+  double RelativeStep() const { return relativeStep; }
+  //! Modify the relative step.
+  double& RelativeStep() { return relativeStep; }
+
+ private:
+  //! Evaluates the wrapped function at any matrix type.
+  class Evaluator
+  {
+   public:
+    Evaluator(FunctionType& function) : function(function) { }
+
+    template<typename MatType>
+    typename MatType::elem_type operator()(const MatType& coordinates) const
+    {
+      return function.Evaluate(coordinates);
+    }
+
+   private:
+    FunctionType& function;
+  };
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The relative step of the difference scheme.
+  double relativeStep;
+};
+
+/**
+ * NumericalSeparableGradientFunction is the separable counterpart of
+ * NumericalGradientFunction: it wraps a separable function that implements
+ * Evaluate(coordinates, begin, batchSize), NumFunctions() and Shuffle(), and
+ * adds the separable Gradient() and EvaluateWithGradient(), differentiating
+ * only the objective of the requested batch.  It can be passed to SGD and the
+ * other optimizers for differentiable separable functions.
+ *
+ * @tparam FunctionType Type of the wrapped function.
+ * @tparam DifferenceType Difference scheme (ForwardDifference,
+ *     CentralDifference or ComplexStep).
+ */
+template<typename FunctionType, typename DifferenceType = CentralDifference>
+class NumericalSeparableGradientFunction
+{
+ public:
+  /**
+   * Wrap the given function.  The function is held by reference, so it must
+   * outlive the wrapper.
+   *
+   * @param function Function to wrap.
+   * @param relativeStep Relative step of the difference scheme; 0 selects the
+   *     scheme's default.
+   */
+  NumericalSeparableGradientFunction(FunctionType& function,
+                                     const double relativeStep = 0.0) :
+      function(function),
+      relativeStep(relativeStep)
+  { /* Nothing to do. */ }
+
+  //! Return the number of separable functions.
+  size_t NumFunctions() const { return function.NumFunctions(); }
+
+  //! Shuffle the order of the separable functions.
+  void Shuffle() { function.Shuffle(); }
+
+  /**
+   * Evaluate the given batch of the wrapped function.
+   *
+   * @param coordinates Coordinates to evaluate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates,
+                                       const size_t begin,
+                                       const size_t batchSize)
+  {
+    return function.Evaluate(coordinates, begin, batchSize);
+  }
+
+  /**
+   * Approximate the gradient of the given batch.
+   *
+   * @param coordinates Coordinates to differentiate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  template<typename MatType, typename GradType>
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize)
+  {
+    typedef typename MatType::elem_type ElemType;
+    const ElemType objective = DifferenceType::NeedsObjective ?
+        function.Evaluate(coordinates, begin, batchSize) : ElemType(0);
+    NumericalGradient<DifferenceType>(Evaluator(function, begin, batchSize),
+        coordinates, objective, gradient, relativeStep);
+  }
+
+  /**
+   * Evaluate the given batch and approximate its gradient.
+   *
+   * @param coordinates Coordinates to evaluate and differentiate at.
+   * @param begin Index of the first separable function of the batch.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of separable functions in the batch.
+   */
+  template<typename MatType, typename GradType>
+  typename MatType::elem_type EvaluateWithGradient(const MatType& coordinates,
+                                                   const size_t begin,
+                                                   GradType& gradient,
+                                                   const size_t batchSize)
+  {
+    const typename MatType::elem_type objective =
+        function.Evaluate(coordinates, begin, batchSize);
+    NumericalGradient<DifferenceType>(Evaluator(function, begin, batchSize),
+        coordinates, objective, gradient, relativeStep);
+    return objective;
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the relative step.
+  double RelativeStep() const { return relativeStep; }
+  //! Modify the relative step.
+  double& RelativeStep() { return relativeStep; }
+
+ private:
+  //! Evaluates one batch of the wrapped function at any matrix type.
+  class Evaluator
+  {
+   public:
+    Evaluator(FunctionType& function,
+              const size_t begin,
+              const size_t batchSize) :
+        function(function),
+        begin(begin),
+        batchSize(batchSize)
+    { }
+
+    template<typename MatType>
+    typename MatType::elem_type operator()(const MatType& coordinates) const
+    {
+      return function.Evaluate(coordinates, begin, batchSize);
+    }
+
+   private:
+    FunctionType& function;
+    size_t begin;
+    size_t batchSize;
+  };
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The relative step of the difference scheme.
+  double relativeStep;
+};
+
+} // namespace ens
+
+#endif
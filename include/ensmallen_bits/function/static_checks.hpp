@@ -37,6 +37,24 @@ struct CheckEvaluate
           TypedForms<MatType, GradType>::template EvaluateStaticForm>::value;
 };
 
+/**
+ * Check if a suitable overload of Evaluate() that returns one value per
+ * objective is available.
+ *
+ * This is required by the MultiObjectiveFunctionType API.
+ */
+template<typename FunctionType, typename MatType, typename GradType>
+struct CheckMultiObjectiveEvaluate
+{
+  const static bool value =
+      HasEvaluate<FunctionType, TypedForms<MatType, GradType>::template
+          MultiObjectiveEvaluateForm>::value ||
+      HasEvaluate<FunctionType, TypedForms<MatType, GradType>::template
+          MultiObjectiveEvaluateConstForm>::value ||
+      HasEvaluate<FunctionType, TypedForms<MatType, GradType>::template
+          MultiObjectiveEvaluateStaticForm>::value;
+};
+
 /**
  * Check if a suitable overload of Gradient() is available.
  *
@@ -471,6 +489,23 @@ inline void CheckArbitrarySeparableFunctionTypeAPI()
 #endif
 }
 
+/**
+ * Perform checks for the MultiObjectiveFunctionType API.
+ */
+template<typename FunctionType, typename MatType>
+inline void CheckMultiObjectiveFunctionTypeAPI()
+{
+#ifndef ENS_DISABLE_TYPE_CHECKS
+  static_assert(CheckMultiObjectiveEvaluate<FunctionType,
+                                            MatType,
+                                            MatType>::value,
+      "The FunctionType does not have a correct definition of Evaluate(). "
+      "Please check that the FunctionType fully satisfies the requirements of "
+      "the MultiObjectiveFunctionType API; see the optimizer tutorial for "
+      "more details.");
+#endif
+}
+
 } // namespace traits
 } // namespace ens
 
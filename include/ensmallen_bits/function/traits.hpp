@@ -45,6 +45,12 @@ ENS_HAS_EXACT_METHOD_FORM(MaxIterations, HasMaxIterations)
 ENS_HAS_EXACT_METHOD_FORM(ResetPolicy, HasResetPolicy)
 //! Detect an BatchSize() method.
 ENS_HAS_EXACT_METHOD_FORM(BatchSize, HasBatchSize)
+//! Detect a DualityGap() method.
+ENS_HAS_EXACT_METHOD_FORM(DualityGap, HasDualityGap)
+//! Detect a Lambda() method.
+ENS_HAS_EXACT_METHOD_FORM(Lambda, HasLambda)
+//! Detect a ClearHistory() method.
+ENS_HAS_EXACT_METHOD_FORM(ClearHistory, HasClearHistory)
 
 template<typename MatType, typename GradType>
 struct TypedForms
@@ -67,6 +73,23 @@ struct TypedForms
   using EvaluateStaticForm = typename BaseMatType::elem_type(*)(
       const BaseMatType&);
 
+  //! This is the form of a non-const multi-objective Evaluate() method.
+  template<typename FunctionType>
+  using MultiObjectiveEvaluateForm =
+      arma::Col<typename BaseMatType::elem_type>(FunctionType::*)(
+          const BaseMatType&);
+
+  //! This is the form of a const multi-objective Evaluate() method.
+  template<typename FunctionType>
+  using MultiObjectiveEvaluateConstForm =
+      arma::Col<typename BaseMatType::elem_type>(FunctionType::*)(
+          const BaseMatType&) const;
+
+  //! This is the form of a static multi-objective Evaluate() method.
+  template<typename FunctionType>
+  using MultiObjectiveEvaluateStaticForm =
+      arma::Col<typename BaseMatType::elem_type>(*)(const BaseMatType&);
+
   //! This is the form of a non-const Gradient() method.
   template<typename FunctionType>
   using GradientForm = void(FunctionType::*)(const BaseMatType&, BaseGradType&);
@@ -418,6 +441,26 @@ struct HasNumFunctionsSignature
       HasNumFunctions<OptimizerType, NumFunctionsConstForm>::value;
 };
 
+//! Utility struct, check if ElemType DualityGap(const MatType&, const MatType&,
+//! const double) (optionally const) exists.
+template<typename FunctionType, typename MatType>
+struct HasDualityGapSignature
+{
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  template<typename C>
+  using DualityGapConstForm = typename BaseMatType::elem_type(C::*)(
+      const BaseMatType&, const BaseMatType&, const double) const;
+
+  template<typename C>
+  using DualityGapForm = typename BaseMatType::elem_type(C::*)(
+      const BaseMatType&, const BaseMatType&, const double);
+
+  const static bool value =
+      HasDualityGap<FunctionType, DualityGapForm>::value ||
+      HasDualityGap<FunctionType, DualityGapConstForm>::value;
+};
+
 //! Utility struct, check if bool ResetPolicy() exists.
 template<typename OptimizerType>
 struct HasResetPolicySignature
@@ -429,6 +472,27 @@ struct HasResetPolicySignature
       HasResetPolicy<OptimizerType, HasResetPolicyForm>::value;
 };
 
+//! Utility struct, check if double& Lambda() exists.
+template<typename FunctionType>
+struct HasLambdaSignature
+{
+  template<typename C>
+  using HasLambdaForm = double&(C::*)(void);
+
+  const static bool value = HasLambda<FunctionType, HasLambdaForm>::value;
+};
+
+//! Utility struct, check if void ClearHistory() exists.
+template<typename OptimizerType>
+struct HasClearHistorySignature
+{
+  template<typename C>
+  using HasClearHistoryForm = void(C::*)(void);
+
+  const static bool value =
+      HasClearHistory<OptimizerType, HasClearHistoryForm>::value;
+};
+
 } // namespace traits
 } // namespace ens
 
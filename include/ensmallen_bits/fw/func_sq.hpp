@@ -22,6 +22,10 @@ namespace ens {
 class FuncSq
 {
  public:
+  //! The objective is exactly 0.5 * ||Ax - b||_2^2, so LineSearch can take
+  //! the closed-form step.
+  static const bool IsLeastSquares = true;
+
   /**
    * Construct the square loss function.
    *
@@ -58,12 +62,12 @@ class FuncSq
   }
 
   //! Get the matrix A.
-  arma::mat MatrixA() const {return A;}
+  const arma::mat& MatrixA() const {return A;}
   //! Modify the matrix A.
   arma::mat& MatrixA() {return A;}
 
   //! Get the vector b.
-  arma::vec Vectorb() const { return b; }
+  const arma::vec& Vectorb() const { return b; }
   //! Modify the vector b.
   arma::vec& Vectorb() { return b; }
 
@@ -14,6 +14,31 @@
 
 namespace ens {
 
+/**
+ * Detect whether a function has the least-squares form
+ * \f$ f(x) = 0.5 * ||Ax - b||_2^2 \f$ of FuncSq.  Having MatrixA() and
+ * Vectorb() is not enough, since the objective might be scaled, weighted or
+ * regularized; the function must opt in with
+ *
+ * @code
+ * static const bool IsLeastSquares = true;
+ * @endcode
+ *
+ * and provide MatrixA() and Vectorb() with elements of type ElemType.
+ */
+template<typename FunctionType, typename ElemType, typename = void>
+struct HasLeastSquaresForm : std::false_type { };
+
+template<typename FunctionType, typename ElemType>
+struct HasLeastSquaresForm<FunctionType, ElemType, typename std::enable_if<
+    FunctionType::IsLeastSquares &&
+    std::is_same<typename std::decay<decltype(
+        std::declval<FunctionType&>().MatrixA())>::type::elem_type,
+        ElemType>::value &&
+    std::is_same<typename std::decay<decltype(
+        std::declval<FunctionType&>().Vectorb())>::type::elem_type,
+        ElemType>::value>::type> : std::true_type { };
+
 /**
  * Find the minimum of a function along the line between two points.
  * The solver uses the secant method to find the zero of the derivative of the
@@ -23,6 +48,12 @@ namespace ens {
  * line will be nondecreasing, so the minimum always exists.
  * If the function is strongly convex, the derivative of the function along the
  * search line will be strictly increasing, so the minimum is unique.
+ *
+ * If the function has the least-squares form of FuncSq (see
+ * HasLeastSquaresForm), the derivative along the search line is affine, and
+ * the minimum is computed in closed form from A * (x2 - x1) without any
+ * gradient evaluations.  Otherwise, the secant iterations reuse the same
+ * buffers for the trial point and the gradient.
  */
 class LineSearch
 {
@@ -49,7 +80,12 @@ class LineSearch
            typename GradType = MatType>
   typename MatType::elem_type Optimize(FunctionType& function,
                                        const MatType& x1,
-                                       MatType& x2);
+                                       MatType& x2)
+  {
+    return Optimize<FunctionType, MatType, GradType>(function, x1, x2,
+        typename HasLeastSquaresForm<FunctionType,
+            typename MatType::elem_type>::type());
+  }
 
   //! Get the maximum number of iterations (0 indicates no limit).
   size_t MaxIterations() const { return maxIterations; }
@@ -68,6 +104,24 @@ class LineSearch
   //! Tolerance for convergence.
   double tolerance;
 
+  /**
+   * Line search with the secant method, for general functions.
+   */
+  template<typename FunctionType, typename MatType, typename GradType>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       const MatType& x1,
+                                       MatType& x2,
+                                       std::false_type /* leastSquares */);
+
+  /**
+   * Exact line search for functions of the form 0.5 * ||Ax - b||_2^2.
+   */
+  template<typename FunctionType, typename MatType, typename GradType>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       const MatType& x1,
+                                       MatType& x2,
+                                       std::true_type /* leastSquares */);
+
   /**
    * Derivative of the function along the search line.
    *
@@ -75,6 +129,8 @@ class LineSearch
    * @param x0 starting point.
    * @param deltaX distance between two end points.
    * @param gamma position of the point in the search line, take in [0, 1].
+   * @param point Buffer to store x0 + gamma * deltaX into.
+   * @param gradient Buffer to store the gradient at point into.
    *
    * @return Derivative of function(x0 + gamma * deltaX) with respect to gamma.
    */
@@ -82,7 +138,9 @@ class LineSearch
   typename MatType::elem_type Derivative(FunctionType& function,
                                          const MatType& x0,
                                          const MatType& deltaX,
-                                         const double gamma);
+                                         const double gamma,
+                                         MatType& point,
+                                         GradType& gradient);
 };  // class LineSearch
 } // namespace ens
 
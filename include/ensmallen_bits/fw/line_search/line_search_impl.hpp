@@ -20,9 +20,11 @@
 namespace ens {
 
 template<typename FunctionType, typename MatType, typename GradType>
-typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
-                                                 const MatType& x1,
-                                                 MatType& x2)
+typename MatType::elem_type LineSearch::Optimize(
+    FunctionType& function,
+    const MatType& x1,
+    MatType& x2,
+    std::false_type /* leastSquares */)
 {
   typedef typename MatType::elem_type ElemType;
 
@@ -33,13 +35,16 @@ typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
   traits::CheckFunctionTypeAPI<FullFunctionType, MatType, GradType>();
 
   // Set up the search line, that is,
-  // find the zero of der(gamma) = Derivative(gamma).
+  // find the zero of der(gamma) = Derivative(gamma).  The trial point and the
+  // gradient buffers are reused by every call to Derivative().
   MatType deltaX = x2 - x1;
+  MatType point(x1.n_rows, x1.n_cols);
+  GradType gradient(x1.n_rows, x1.n_cols);
   ElemType gamma = 0;
-  ElemType derivative = Derivative<FunctionType, MatType, GradType>(f, x1,
-      deltaX, 0);
-  ElemType derivativeNew = Derivative<FunctionType, MatType, GradType>(f, x1,
-      deltaX, 1);
+  ElemType derivative = Derivative<FullFunctionType, MatType, GradType>(f, x1,
+      deltaX, 0, point, gradient);
+  ElemType derivativeNew = Derivative<FullFunctionType, MatType, GradType>(f,
+      x1, deltaX, 1, point, gradient);
   ElemType secant = derivativeNew - derivative;
 
   if (derivative >= 0.0) // Optimal solution at left endpoint.
@@ -65,7 +70,7 @@ typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
     {
       Warn << "LineSearchSecant: Function is not convex!" << std::endl;
       x2 = x1;
-      return function.Evaluate(x1);
+      return f.Evaluate(x1);
     }
 
     // Solve new gamma.
@@ -74,8 +79,8 @@ typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
     gammaNew = std::min(gammaNew, ElemType(1.0));
 
     // Update secant, gamma and derivative.
-    derivativeNew = Derivative<FunctionType, MatType, GradType>(function, x1,
-        deltaX, gammaNew);
+    derivativeNew = Derivative<FullFunctionType, MatType, GradType>(f, x1,
+        deltaX, gammaNew, point, gradient);
     secant = (derivativeNew - derivative) / (gammaNew - gamma);
     gamma = gammaNew;
     derivative = derivativeNew;
@@ -84,7 +89,9 @@ typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
     {
       Info << "LineSearchSecant: minimized within tolerance "
           << tolerance << "; " << "terminating optimization." << std::endl;
-      x2 = (1 - gamma) * x1 + gamma * x2;
+      // The last trial point is x1 + gamma * deltaX, so it is not recomputed;
+      // the objective still takes one evaluation.
+      x2 = point;
       return f.Evaluate(x2);
     }
   }
@@ -96,16 +103,59 @@ typename MatType::elem_type LineSearch::Optimize(FunctionType& function,
   return f.Evaluate(x2);
 }  // Optimize
 
+template<typename FunctionType, typename MatType, typename GradType>
+typename MatType::elem_type LineSearch::Optimize(
+    FunctionType& function,
+    const MatType& x1,
+    MatType& x2,
+    std::true_type /* leastSquares */)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // For f(x) = 0.5 * ||Ax - b||^2, with r1 = A x1 - b and ad = A (x2 - x1),
+  //
+  //   f(x1 + gamma (x2 - x1)) = 0.5 * ||r1 + gamma ad||^2,
+  //
+  // so the derivative along the line is dot(r1, ad) + gamma * dot(ad, ad).
+  // Once ad is cached, each derivative evaluation is O(m), and the zero of the
+  // derivative can be found directly.
+  const MatType r1 = function.MatrixA() * x1 - function.Vectorb();
+  const MatType ad = function.MatrixA() * (x2 - x1);
+
+  const ElemType r1r1 = arma::dot(r1, r1);
+  const ElemType derivative = arma::dot(r1, ad);
+  const ElemType secant = arma::dot(ad, ad);
+
+  ElemType gamma;
+  if (derivative >= 0.0) // Optimal solution at left endpoint.
+    gamma = 0;
+  else if (derivative + secant <= 0.0) // Optimal solution at right endpoint.
+    gamma = 1;
+  else if (secant < tolerance) // function too flat, just take left endpoint.
+    gamma = 0;
+  else
+    gamma = -derivative / secant;
+
+  if (gamma == 0)
+    x2 = x1;
+  else if (gamma != 1)
+    x2 = (1 - gamma) * x1 + gamma * x2;
+
+  return 0.5 * (r1r1 + 2 * gamma * derivative + gamma * gamma * secant);
+}
+
 
 //! Derivative of the function along the search line.
 template<typename FunctionType, typename MatType, typename GradType>
 typename MatType::elem_type LineSearch::Derivative(FunctionType& function,
                                                    const MatType& x0,
                                                    const MatType& deltaX,
-                                                   const double gamma)
+                                                   const double gamma,
+                                                   MatType& point,
+                                                   GradType& gradient)
 {
-  GradType gradient(x0.n_rows, x0.n_cols);
-  function.Gradient(x0 + gamma * deltaX, gradient);
+  point = x0 + gamma * deltaX;
+  function.Gradient(point, gradient);
   return arma::dot(gradient, deltaX);
 }
 
@@ -207,31 +207,28 @@ KatyushaType<Proximal>::Optimize(
 
       // By the minimality definition of z_{k + 1}, we have that:
       // z_{k+1} − z_k + \alpha * \sigma_{k+1} + \alpha g = 0.
-      BaseMatType zNew = z - alpha * (fullGradient + (gradient - gradient0) /
-          (double) batchSize);
-
+      //
       // Proximal update, choose between Option I and Option II. Shift relative
       // to the Lipschitz constant or take a constant step using the given step
       // size.
-      if (Proximal)
-      {
-        // yk = x0 − 1 / (3L) * \delta1, k = 1
-        // yk = x0 − 1 / (3L) * \delta2 - ((1 - tau) / (3L)) + tau * alpha)
-        // * \delta1, k = 2
-        // yk = x0 − 1 / (3L) * \delta3 - ((1 - tau) / (3L)) + tau * alpha)
-        // * \delta2 - ((1-tau)^2 / (3L) + (1 - (1 - tau)^2) * alpha) * \delta1,
-        // k = 3.
-        y = iterate + 1.0 / (3.0 * lipschitz) * w;
-      }
-      else
-      {
-        y = iterate + tau1 * (zNew - z);
-      }
-
-      z = std::move(zNew);
-
+      //
+      // Option II:
+      // yk = x0 − 1 / (3L) * \delta1, k = 1
+      // yk = x0 − 1 / (3L) * \delta2 - ((1 - tau) / (3L)) + tau * alpha)
+      // * \delta1, k = 2
+      // yk = x0 − 1 / (3L) * \delta3 - ((1 - tau) / (3L)) + tau * alpha)
+      // * \delta2 - ((1-tau)^2 / (3L) + (1 - (1 - tau)^2) * alpha) * \delta1,
+      // k = 3.
+      //
+      // Option I: y = iterate + tau1 * (z_{k+1} - z_k).
+      //
+      // Also accumulate
       // sum_{j=0}^{m-1} 1 + std::min(alpha * convexity, 1 / (4 * m)^j * ys).
-      w += cw * iterate;
+      //
+      // All of this is done in a single pass over the coordinates.
+      KatyushaStep(iterate, y, z, w, fullGradient, gradient, gradient0,
+          1.0 / (double) batchSize, alpha, tau1, Proximal,
+          1.0 / (3.0 * lipschitz), cw);
       cw *= r;
 
       currentFunction += effectiveBatchSize;
@@ -48,6 +48,10 @@ class L_BFGS
    *     (before giving up).
    * @param minStep The minimum step of the line search.
    * @param maxStep The maximum step of the line search.
+   * @param resetPolicy If true, the curvature history is discarded before
+   *     every call to Optimize(); otherwise, the history of the previous call
+   *     is reused when the iterate has the same size (useful to warm start a
+   *     sequence of similar problems).
    */
   L_BFGS(const size_t numBasis = 10, /* same default as scipy */
          const size_t maxIterations = 10000, /* many but not infinite */
@@ -57,7 +61,8 @@ class L_BFGS
          const double factr = 1e-15,
          const size_t maxLineSearchTrials = 50,
          const double minStep = 1e-20,
-         const double maxStep = 1e20);
+         const double maxStep = 1e20,
+         const bool resetPolicy = true);
 
   /**
    * Use L-BFGS to optimize the given function, starting at the given iterate
@@ -144,6 +149,20 @@ class L_BFGS
   //! Modify the maximum line search step size.
   double& MaxStep() { return maxStep; }
 
+  //! Get whether the curvature history is reset before every Optimize() call.
+  bool ResetPolicy() const { return resetPolicy; }
+  //! Modify whether the curvature history is reset before every Optimize()
+  //! call.
+  bool& ResetPolicy() { return resetPolicy; }
+
+  //! Discard the curvature history kept from the previous call.
+  void ClearHistory()
+  {
+    historyS.reset();
+    historyY.reset();
+    historyUpdates = 0;
+  }
+
  private:
   //! Size of memory for this L-BFGS optimizer.
   size_t numBasis;
@@ -163,6 +182,14 @@ class L_BFGS
   double minStep;
   //! Maximum step of the line search.
   double maxStep;
+  //! Whether to discard the curvature history before every Optimize() call.
+  bool resetPolicy;
+  //! The iterate differences kept from the previous call.
+  arma::cube historyS;
+  //! The gradient differences kept from the previous call.
+  arma::cube historyY;
+  //! The number of basis updates of the kept history.
+  size_t historyUpdates;
   //! Controls early termination of the optimization process.
   bool terminate;
 
@@ -37,6 +37,8 @@ namespace ens {
  *     (before giving up).
  * @param minStep The minimum step of the line search.
  * @param maxStep The maximum step of the line search.
+ * @param resetPolicy If true, the curvature history is discarded before every
+ *     call to Optimize().
  */
 inline L_BFGS::L_BFGS(const size_t numBasis,
                       const size_t maxIterations,
@@ -46,7 +48,8 @@ inline L_BFGS::L_BFGS(const size_t numBasis,
                       const double factr,
                       const size_t maxLineSearchTrials,
                       const double minStep,
-                      const double maxStep) :
+                      const double maxStep,
+                      const bool resetPolicy) :
     numBasis(numBasis),
     maxIterations(maxIterations),
     armijoConstant(armijoConstant),
@@ -56,6 +59,8 @@ inline L_BFGS::L_BFGS(const size_t numBasis,
     maxLineSearchTrials(maxLineSearchTrials),
     minStep(minStep),
     maxStep(maxStep),
+    resetPolicy(resetPolicy),
+    historyUpdates(0),
     terminate(false)
 {
   // Nothing to do.
@@ -355,6 +360,18 @@ L_BFGS::Optimize(FunctionType& function,
   arma::Cube<ElemType> s(rows, cols, numBasis);
   arma::Cube<ElemType> y(rows, cols, numBasis);
 
+  // Reuse the curvature pairs of the previous call, if requested.  The basis
+  // positions continue from where the previous call stopped.
+  size_t basisOffset = 0;
+  if (!resetPolicy && historyUpdates > 0 && historyS.n_rows == rows &&
+      historyS.n_cols == cols && historyS.n_slices == numBasis)
+  {
+    s = arma::conv_to<arma::Cube<ElemType>>::from(historyS);
+    y = arma::conv_to<arma::Cube<ElemType>>::from(historyY);
+    basisOffset = historyUpdates;
+  }
+  size_t basisUpdates = basisOffset;
+
   // The old iterate to be saved.
   BaseMatType oldIterate(iterate.n_rows, iterate.n_cols);
   oldIterate.zeros();
@@ -373,6 +390,7 @@ L_BFGS::Optimize(FunctionType& function,
   searchDirection.zeros();
 
   // The initial function value and gradient.
+  terminate = false;
   ElemType functionValue = f.EvaluateWithGradient(iterate, gradient);
 
   terminate |= Callback::EvaluateWithGradient(*this, f, iterate,
@@ -408,7 +426,8 @@ L_BFGS::Optimize(FunctionType& function,
     }
 
     // Choose the scaling factor.
-    double scalingFactor = ChooseScalingFactor(itNum, gradient, s, y);
+    double scalingFactor = ChooseScalingFactor(itNum + basisOffset, gradient,
+        s, y);
     if (scalingFactor == 0.0)
     {
       Info << "L-BFGS scaling factor computed as 0 (terminating successfully)."
@@ -418,7 +437,8 @@ L_BFGS::Optimize(FunctionType& function,
 
     // Build an approximation to the Hessian and choose the search
     // direction for the current iteration.
-    SearchDirection(gradient, itNum, scalingFactor, s, y, searchDirection);
+    SearchDirection(gradient, itNum + basisOffset, scalingFactor, s, y,
+        searchDirection);
 
     // Save the old iterate and the gradient before stepping.
     oldIterate = iterate;
@@ -454,11 +474,21 @@ L_BFGS::Optimize(FunctionType& function,
     }
 
     // Overwrite an old basis set.
-    UpdateBasisSet(itNum, iterate, oldIterate, gradient, oldGradient, s, y);
+    UpdateBasisSet(itNum + basisOffset, iterate, oldIterate, gradient,
+        oldGradient, s, y);
+    basisUpdates = basisOffset + itNum + 1;
 
     terminate |= Callback::StepTaken(*this, f, iterate, callbacks...);
   } // End of the optimization loop.
 
+  // Keep the curvature pairs for the next call.
+  if (!resetPolicy)
+  {
+    historyS = arma::conv_to<arma::cube>::from(s);
+    historyY = arma::conv_to<arma::cube>::from(y);
+    historyUpdates = basisUpdates;
+  }
+
   Callback::EndOptimization(*this, f, iterate, callbacks...);
   return functionValue;
 }
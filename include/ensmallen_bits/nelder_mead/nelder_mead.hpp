@@ -0,0 +1,182 @@
+/**
+ * @file nelder_mead.hpp
+ *
+ * Nelder-Mead simplex method with adaptive coefficients, and its parallel
+ * variant that moves several vertices at once.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NELDER_MEAD_NELDER_MEAD_HPP
+#define ENSMALLEN_NELDER_MEAD_NELDER_MEAD_HPP
+
+namespace ens {
+
+/**
+ * The Nelder-Mead method minimizes a function using only function values.  It
+ * keeps a simplex of n + 1 points in n dimensions and, at each iteration,
+ * replaces the worst vertex by its reflection through the centroid of the
+ * others, expanded or contracted depending on how good the reflected point is;
+ * if no better point is found, the simplex is shrunk towards the best vertex.
+ *
+ * With adaptive coefficients, the expansion, contraction and shrink
+ * coefficients depend on the dimension (Gao and Han, 2012), which keeps the
+ * method from stalling in higher dimensions.
+ *
+ * With numParallel = P > 1, the parallel simplex method of Lee and Wiswall
+ * (2007) is used: the worst P vertices are each reflected through the centroid
+ * of the remaining n + 1 - P vertices and moved independently, and the simplex
+ * is only shrunk if none of them improved.  P is capped at n / 2, since the
+ * centroid of too few vertices makes the simplex stall.  If ensmallen is
+ * compiled with OpenMP, the P vertices are handled in parallel (as are the
+ * evaluations of the initial simplex and of a shrink), so the function's
+ * Evaluate() must then be safe to call concurrently.  This needs many fewer
+ * iterations when evaluations are expensive and several cores are available.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Nelder1965,
+ *   author  = {Nelder, John A. and Mead, Roger},
+ *   title   = {A Simplex Method for Function Minimization},
+ *   journal = {The Computer Journal},
+ *   volume  = {7},
+ *   number  = {4},
+ *   pages   = {308--313},
+ *   year    = {1965}
+ * }
+ *
+ * @article{Gao2012,
+ *   author  = {Gao, Fuchang and Han, Lixing},
+ *   title   = {Implementing the {N}elder-{M}ead simplex algorithm with
+ *              adaptive parameters},
+ *   journal = {Computational Optimization and Applications},
+ *   volume  = {51},
+ *   number  = {1},
+ *   pages   = {259--277},
+ *   year    = {2012}
+ * }
+ *
+ * @article{Lee2007,
+ *   author  = {Lee, Donghoon and Wiswall, Matthew},
+ *   title   = {A Parallel Implementation of the Simplex Function
+ *              Minimization Routine},
+ *   journal = {Computational Economics},
+ *   volume  = {30},
+ *   number  = {2},
+ *   pages   = {171--187},
+ *   year    = {2007}
+ * }
+ * @endcode
+ *
+ * NelderMead can optimize arbitrary functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class NelderMead
+{
+ public:
+  /**
+   * Construct the Nelder-Mead optimizer with the given parameters.
+   *
+   * @param maxIterations Maximum number of iterations allowed (0 means no
+   *     limit).
+   * @param tolerance Stop when the objective values of the best and the worst
+   *     vertex differ by at most this much.
+   * @param initialStep Relative size of the initial simplex: each vertex moves
+   *     one coordinate of the starting point by initialStep times its value
+   *     (or by 0.00025 if the coordinate is zero).
+   * @param adaptive Whether to use the dimension-dependent coefficients of Gao
+   *     and Han.
+   * @param numParallel Number of worst vertices moved at each iteration (1
+   *     gives the standard method); at most half the number of coordinates
+   *     are used.
+   */
+  NelderMead(const size_t maxIterations = 10000,
+             const double tolerance = 1e-10,
+             const double initialStep = 0.05,
+             const bool adaptive = true,
+             const size_t numParallel = 1);
+
+  /**
+   * Optimize the given function using the Nelder-Mead method.  The given
+   * starting point will be modified to store the finishing point of the
+   * algorithm, and the final objective value is returned.
+   *
+   * @tparam ArbitraryFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename ArbitraryFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(ArbitraryFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the relative size of the initial simplex.
+  double InitialStep() const { return initialStep; }
+  //! Modify the relative size of the initial simplex.
+  double& InitialStep() { return initialStep; }
+
+  //! Get whether adaptive coefficients are used.
+  bool Adaptive() const { return adaptive; }
+  //! Modify whether adaptive coefficients are used.
+  bool& Adaptive() { return adaptive; }
+
+  //! Get the number of vertices moved at each iteration.
+  size_t NumParallel() const { return numParallel; }
+  //! Modify the number of vertices moved at each iteration.
+  size_t& NumParallel() { return numParallel; }
+
+ private:
+  /**
+   * Evaluate the function at the given columns of the simplex (in parallel,
+   * if OpenMP is enabled) and store the objective values.
+   */
+  template<typename FunctionType, typename BaseMatType, typename ElemType>
+  void EvaluateVertices(FunctionType& function,
+                        const arma::Mat<ElemType>& simplex,
+                        const size_t first,
+                        const size_t last,
+                        arma::Col<ElemType>& values,
+                        const BaseMatType& iterate);
+
+  //! The maximum number of iterations.
+  size_t maxIterations;
+
+  //! The tolerance on the spread of the objective values.
+  double tolerance;
+
+  //! The relative size of the initial simplex.
+  double initialStep;
+
+  //! Whether adaptive coefficients are used.
+  bool adaptive;
+
+  //! The number of vertices moved at each iteration.
+  size_t numParallel;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "nelder_mead_impl.hpp"
+
+#endif
@@ -0,0 +1,262 @@
+/**
+ * @file nelder_mead_impl.hpp
+ *
+ * Implementation of the Nelder-Mead simplex method.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NELDER_MEAD_NELDER_MEAD_IMPL_HPP
+#define ENSMALLEN_NELDER_MEAD_NELDER_MEAD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "nelder_mead.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline NelderMead::NelderMead(const size_t maxIterations,
+                              const double tolerance,
+                              const double initialStep,
+                              const bool adaptive,
+                              const size_t numParallel) :
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    initialStep(initialStep),
+    adaptive(adaptive),
+    numParallel(numParallel)
+{ /* Nothing to do. */ }
+
+//! Optimize the function (minimize).
+template<typename ArbitraryFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type NelderMead::Optimize(
+    ArbitraryFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitraryFunctionTypeAPI<ArbitraryFunctionType,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  const size_t n = iterate.n_elem;
+  if (n == 0)
+  {
+    throw std::invalid_argument("NelderMead::Optimize(): the coordinates must "
+        "not be empty");
+  }
+
+  // Reflection, expansion, contraction and shrink coefficients.  The adaptive
+  // coefficients reduce to the standard ones for n = 2 and are only defined
+  // for n >= 2.
+  const double dn = (double) n;
+  const bool useAdaptive = adaptive && n >= 2;
+  const ElemType alpha = ElemType(1.0);
+  const ElemType beta = ElemType(useAdaptive ? 1.0 + 2.0 / dn : 2.0);
+  const ElemType gamma = ElemType(useAdaptive ? 0.75 - 0.5 / dn : 0.5);
+  const ElemType delta = ElemType(useAdaptive ? 1.0 - 1.0 / dn : 0.5);
+
+  // If too few vertices stay in place, the centroid degenerates and the
+  // simplex stalls, so at most half of the vertices are moved at once.
+  const size_t maxParallel = std::max<size_t>(n / 2, 1);
+  const size_t p = std::min(std::max<size_t>(numParallel, 1), maxParallel);
+  if (numParallel > maxParallel)
+  {
+    Warn << "NelderMead::Optimize(): numParallel (" << numParallel << ") is "
+        << "larger than half the number of coordinates; using " << p
+        << " instead." << std::endl;
+  }
+  const size_t retained = n + 1 - p;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+
+  // Build the initial simplex around the starting point; each column is a
+  // vertex.
+  arma::Mat<ElemType> simplex(n, n + 1);
+  simplex.each_col() = arma::vectorise(iterate);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const ElemType xi = simplex(i, 0);
+    simplex(i, i + 1) = (xi != ElemType(0)) ?
+        ElemType((1.0 + initialStep) * xi) : ElemType(0.00025);
+  }
+
+  arma::Col<ElemType> values(n + 1);
+  EvaluateVertices(function, simplex, 0, n + 1, values, iterate);
+  for (size_t i = 0; i <= n && !terminate; ++i)
+  {
+    const BaseMatType vertex(simplex.colptr(i), iterate.n_rows,
+        iterate.n_cols, false, true);
+    terminate |= Callback::Evaluate(*this, function, vertex, values(i),
+        callbacks...);
+  }
+
+  // Each of the p moving vertices has two trial points: the reflection, and
+  // then the expansion or the contraction.
+  arma::Mat<ElemType> trials(n, 2 * p);
+  arma::Col<ElemType> trialValues(2 * p);
+  arma::Col<ElemType> centroid(n);
+  std::vector<int> numTrials(p), accepted(p);
+
+  size_t i = 0;
+  for (; (i < maxIterations || maxIterations == 0) && !terminate; ++i)
+  {
+    // Order the vertices from best to worst.
+    const arma::uvec order = arma::stable_sort_index(values);
+    simplex = simplex.cols(order);
+    values = values.elem(order);
+
+    const BaseMatType best(simplex.colptr(0), iterate.n_rows, iterate.n_cols,
+        false, true);
+    terminate |= Callback::StepTaken(*this, function, best, callbacks...);
+
+    if (values(n) - values(0) <= tolerance)
+    {
+      Info << "NelderMead: minimized within tolerance " << tolerance << "; "
+          << "terminating optimization." << std::endl;
+      break;
+    }
+
+    const ElemType fBest = values(0);
+    const ElemType fRetainedWorst = values(retained - 1);
+    centroid = arma::mean(simplex.cols(0, retained - 1), 1);
+
+    // Move each of the worst p vertices independently.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t k = 0; k < (ptrdiff_t) p; ++k)
+    {
+      const size_t v = retained + k;
+      const arma::Col<ElemType> vertex(simplex.colptr(v), n, false, true);
+      arma::Col<ElemType> reflected(trials.colptr(2 * k), n, false, true);
+      arma::Col<ElemType> other(trials.colptr(2 * k + 1), n, false, true);
+      const BaseMatType reflectedMat(trials.colptr(2 * k), iterate.n_rows,
+          iterate.n_cols, false, true);
+      const BaseMatType otherMat(trials.colptr(2 * k + 1), iterate.n_rows,
+          iterate.n_cols, false, true);
+
+      reflected = centroid + alpha * (centroid - vertex);
+      const ElemType fr = function.Evaluate(reflectedMat);
+      trialValues(2 * k) = fr;
+      numTrials[k] = 1;
+      accepted[k] = -1;
+
+      if (fr < fBest)
+      {
+        // Expand.
+        other = centroid + beta * (reflected - centroid);
+        const ElemType fe = function.Evaluate(otherMat);
+        trialValues(2 * k + 1) = fe;
+        numTrials[k] = 2;
+        accepted[k] = (fe < fr) ? 1 : 0;
+      }
+      else if (fr < fRetainedWorst)
+      {
+        accepted[k] = 0;
+      }
+      else if (fr < values(v))
+      {
+        // Outside contraction; if it fails, the vertex is not replaced, and
+        // the simplex is shrunk as in the standard method.
+        other = centroid + gamma * (reflected - centroid);
+        const ElemType fc = function.Evaluate(otherMat);
+        trialValues(2 * k + 1) = fc;
+        numTrials[k] = 2;
+        accepted[k] = (fc <= fr) ? 1 : -1;
+      }
+      else
+      {
+        // Inside contraction.
+        other = centroid + gamma * (vertex - centroid);
+        const ElemType fc = function.Evaluate(otherMat);
+        trialValues(2 * k + 1) = fc;
+        numTrials[k] = 2;
+        accepted[k] = (fc < values(v)) ? 1 : -1;
+      }
+    }
+
+    bool improved = false;
+    for (size_t k = 0; k < p; ++k)
+    {
+      for (int t = 0; t < numTrials[k]; ++t)
+      {
+        const BaseMatType trial(trials.colptr(2 * k + t), iterate.n_rows,
+            iterate.n_cols, false, true);
+        terminate |= Callback::Evaluate(*this, function, trial,
+            trialValues(2 * k + t), callbacks...);
+      }
+
+      if (accepted[k] >= 0)
+      {
+        simplex.col(retained + k) = trials.col(2 * k + accepted[k]);
+        values(retained + k) = trialValues(2 * k + accepted[k]);
+        improved = true;
+      }
+    }
+
+    if (!improved)
+    {
+      // Shrink the simplex towards the best vertex.
+      for (size_t j = 1; j <= n; ++j)
+        simplex.col(j) = simplex.col(0) + delta * (simplex.col(j) -
+            simplex.col(0));
+
+      EvaluateVertices(function, simplex, 1, n + 1, values, iterate);
+      for (size_t j = 1; j <= n && !terminate; ++j)
+      {
+        const BaseMatType vertex(simplex.colptr(j), iterate.n_rows,
+            iterate.n_cols, false, true);
+        terminate |= Callback::Evaluate(*this, function, vertex, values(j),
+            callbacks...);
+      }
+    }
+  }
+
+  if (maxIterations != 0 && i == maxIterations)
+  {
+    Info << "NelderMead: maximum iterations (" << maxIterations << ") "
+        << "reached; terminating optimization." << std::endl;
+  }
+
+  // Return the best vertex.
+  const size_t bestIndex = values.index_min();
+  iterate = arma::reshape(simplex.col(bestIndex), iterate.n_rows,
+      iterate.n_cols);
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return values(bestIndex);
+}
+
+template<typename FunctionType, typename BaseMatType, typename ElemType>
+void NelderMead::EvaluateVertices(FunctionType& function,
+                                  const arma::Mat<ElemType>& simplex,
+                                  const size_t first,
+                                  const size_t last,
+                                  arma::Col<ElemType>& values,
+                                  const BaseMatType& iterate)
+{
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t j = (ptrdiff_t) first; j < (ptrdiff_t) last; ++j)
+  {
+    const BaseMatType vertex((ElemType*) simplex.colptr(j), iterate.n_rows,
+        iterate.n_cols, false, true);
+    values(j) = function.Evaluate(vertex);
+  }
+}
+
+} // namespace ens
+
+#endif
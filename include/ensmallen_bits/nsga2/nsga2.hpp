@@ -0,0 +1,296 @@
+/**
+ * @file nsga2.hpp
+ *
+ * NSGA-II, an evolutionary algorithm for multi-objective optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NSGA2_NSGA2_HPP
+#define ENSMALLEN_NSGA2_NSGA2_HPP
+
+namespace ens {
+
+/**
+ * NSGA-II (Non-dominated Sorting Genetic Algorithm II) approximates the Pareto
+ * front of a function with several objectives, all of which are minimized
+ * over a box.  A point dominates another if it is no worse in every objective
+ * and better in at least one; the Pareto front is the set of points that no
+ * other point dominates.
+ *
+ * Each generation creates as many offspring as there are members, by binary
+ * tournament selection, simulated binary crossover and polynomial mutation.
+ * Members and offspring together are then sorted into fronts of mutually
+ * non-dominated points, and the best fronts survive; within the last front
+ * that fits, points in less crowded regions of the objective space are
+ * preferred, which spreads the population along the Pareto front.
+ *
+ * The non-dominated sorting takes O(M N^2) time for M objectives and N points,
+ * or O(N log N) for two objectives.  If ensmallen is compiled with OpenMP, the
+ * population is evaluated in parallel, so the function's Evaluate() must then
+ * be safe to call concurrently.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Deb2002,
+ *   author  = {Deb, Kalyanmoy and Pratap, Amrit and Agarwal, Sameer and
+ *              Meyarivan, T.},
+ *   title   = {A Fast and Elitist Multiobjective Genetic Algorithm: NSGA-II},
+ *   journal = {IEEE Transactions on Evolutionary Computation},
+ *   volume  = {6},
+ *   number  = {2},
+ *   pages   = {182--197},
+ *   year    = {2002}
+ * }
+ *
+ * @article{Jensen2003,
+ *   author  = {Jensen, Mikkel T.},
+ *   title   = {Reducing the Run-Time Complexity of Multiobjective {EA}s: The
+ *              {NSGA-II} and Other Algorithms},
+ *   journal = {IEEE Transactions on Evolutionary Computation},
+ *   volume  = {7},
+ *   number  = {5},
+ *   pages   = {503--515},
+ *   year    = {2003}
+ * }
+ * @endcode
+ *
+ * NSGA2 can optimize multi-objective functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ */
+class NSGA2
+{
+ public:
+  /**
+   * Construct the NSGA-II optimizer with the given parameters.
+   *
+   * @param populationSize The number of members of the population (at least
+   *     4).
+   * @param maxGenerations The number of generations.
+   * @param crossoverProb The probability that a pair of offspring is created
+   *     by crossover rather than copied from the parents.
+   * @param mutationProb The probability that each element of an offspring is
+   *     mutated.
+   * @param distributionIndex The distribution index of the crossover and the
+   *     mutation; larger values create offspring closer to their parents.
+   * @param lowerBound Lower bound of the coordinates; either a single value
+   *     for all dimensions, or one value for each element of the coordinates.
+   * @param upperBound Upper bound of the coordinates; either a single value
+   *     for all dimensions, or one value for each element of the coordinates.
+   */
+  NSGA2(const size_t populationSize = 100,
+        const size_t maxGenerations = 2000,
+        const double crossoverProb = 0.9,
+        const double mutationProb = 0.1,
+        const double distributionIndex = 20.0,
+        const arma::mat& lowerBound = arma::zeros(1, 1),
+        const arma::mat& upperBound = arma::ones(1, 1));
+
+  /**
+   * Construct the NSGA-II optimizer with the given parameters, with the same
+   * bounds for all dimensions.
+   *
+   * @param populationSize The number of members of the population (at least
+   *     4).
+   * @param maxGenerations The number of generations.
+   * @param crossoverProb The probability that a pair of offspring is created
+   *     by crossover.
+   * @param mutationProb The probability that each element of an offspring is
+   *     mutated.
+   * @param distributionIndex The distribution index of the crossover and the
+   *     mutation.
+   * @param lowerBound Lower bound of every dimension.
+   * @param upperBound Upper bound of every dimension.
+   */
+  NSGA2(const size_t populationSize,
+        const size_t maxGenerations,
+        const double crossoverProb,
+        const double mutationProb,
+        const double distributionIndex,
+        const double lowerBound,
+        const double upperBound);
+
+  /**
+   * Approximate the Pareto front of the given multi-objective function.  The
+   * given starting point is a member of the initial population (the others are
+   * drawn uniformly from the box).  Afterwards, the Pareto set and front of the
+   * final population are available through ParetoSet() and ParetoFront(), and
+   * the starting point is overwritten with the member of the Pareto set whose
+   * objectives have the smallest sum; that sum is returned.
+   *
+   * @tparam MultiObjectiveFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Sum of the objectives of the final point.
+   */
+  template<typename MultiObjectiveFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(MultiObjectiveFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the population size.
+  size_t PopulationSize() const { return populationSize; }
+  //! Modify the population size.
+  size_t& PopulationSize() { return populationSize; }
+
+  //! Get the number of generations.
+  size_t MaxGenerations() const { return maxGenerations; }
+  //! Modify the number of generations.
+  size_t& MaxGenerations() { return maxGenerations; }
+
+  //! Get the crossover probability.
+  double CrossoverProb() const { return crossoverProb; }
+  //! Modify the crossover probability.
+  double& CrossoverProb() { return crossoverProb; }
+
+  //! Get the mutation probability.
+  double MutationProb() const { return mutationProb; }
+  //! Modify the mutation probability.
+  double& MutationProb() { return mutationProb; }
+
+  //! Get the distribution index.
+  double DistributionIndex() const { return distributionIndex; }
+  //! Modify the distribution index.
+  double& DistributionIndex() { return distributionIndex; }
+
+  //! Get the lower bound of the coordinates.
+  const arma::mat& LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the coordinates.
+  arma::mat& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the coordinates.
+  const arma::mat& UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the coordinates.
+  arma::mat& UpperBound() { return upperBound; }
+
+  //! Get the Pareto set of the last optimization: one (vectorised) point per
+  //! column.
+  const arma::mat& ParetoSet() const { return paretoSet; }
+
+  //! Get the Pareto front of the last optimization: the objectives of the
+  //! point in the same column of ParetoSet(), one objective per row.
+  const arma::mat& ParetoFront() const { return paretoFront; }
+
+ private:
+  /**
+   * Evaluate the points in the given columns (in parallel, if OpenMP is
+   * enabled), and store their objectives in the same columns of objectives.
+   */
+  template<typename MultiObjectiveFunctionType, typename BaseMatType>
+  static void EvaluatePoints(
+      MultiObjectiveFunctionType& function,
+      const BaseMatType& iterate,
+      const arma::Mat<typename BaseMatType::elem_type>& points,
+      const size_t begin,
+      const size_t end,
+      arma::Mat<typename BaseMatType::elem_type>& objectives);
+
+  /**
+   * Compute the front of each point and the crowding distance of each point
+   * within its front.
+   */
+  template<typename ElemType>
+  static void RankAndCrowd(const arma::Mat<ElemType>& objectives,
+                           arma::uvec& ranks,
+                           arma::vec& crowding);
+
+  /**
+   * Sort the given points (one column of objectives per point) into fronts of
+   * mutually non-dominated points, and store the index of the front of each
+   * point in ranks.
+   */
+  template<typename ElemType>
+  static void NonDominatedSort(const arma::Mat<ElemType>& objectives,
+                               arma::uvec& ranks);
+
+  /**
+   * Non-dominated sorting for two objectives, in O(N log N): the points are
+   * visited in lexicographic order, and each one is put in the first front
+   * whose last point does not dominate it.
+   */
+  template<typename ElemType>
+  static void NonDominatedSortTwoObjectives(
+      const arma::Mat<ElemType>& objectives,
+      arma::uvec& ranks);
+
+  //! Return whether point p dominates point q.
+  template<typename ElemType>
+  static bool Dominates(const arma::Mat<ElemType>& objectives,
+                        const size_t p,
+                        const size_t q);
+
+  /**
+   * Compute the crowding distance of the points in the given front: the sum
+   * over all objectives of the normalized distance between the neighbours of
+   * each point.  The extreme points get an infinite distance.
+   */
+  template<typename ElemType>
+  static void CrowdingDistance(const arma::Mat<ElemType>& objectives,
+                               const arma::uvec& front,
+                               arma::vec& distance);
+
+  //! Return the index of the winner of a binary tournament between two random
+  //! members: the lower front wins, then the larger crowding distance.
+  static size_t Tournament(const arma::uvec& ranks, const arma::vec& crowding);
+
+  //! Return the index of the member of the first front whose objectives have
+  //! the smallest sum.
+  template<typename ElemType>
+  static size_t BestMember(const arma::Mat<ElemType>& objectives,
+                           const arma::uvec& ranks);
+
+  //! Apply simulated binary crossover to the given pair of offspring.
+  template<typename ElemType>
+  void Crossover(arma::Col<ElemType>& first,
+                 arma::Col<ElemType>& second) const;
+
+  //! Apply polynomial mutation to the given offspring, and clamp it to the
+  //! bounds.
+  template<typename ElemType>
+  void Mutate(arma::Col<ElemType>& child,
+              const arma::Col<ElemType>& lower,
+              const arma::Col<ElemType>& upper) const;
+
+  //! The number of members of the population.
+  size_t populationSize;
+
+  //! The number of generations.
+  size_t maxGenerations;
+
+  //! The crossover probability.
+  double crossoverProb;
+
+  //! The mutation probability.
+  double mutationProb;
+
+  //! The distribution index of the crossover and mutation.
+  double distributionIndex;
+
+  //! Lower bound of the coordinates.
+  arma::mat lowerBound;
+
+  //! Upper bound of the coordinates.
+  arma::mat upperBound;
+
+  //! The Pareto set of the last optimization.
+  arma::mat paretoSet;
+
+  //! The Pareto front of the last optimization.
+  arma::mat paretoFront;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "nsga2_impl.hpp"
+
+#endif
@@ -0,0 +1,516 @@
+/**
+ * @file nsga2_impl.hpp
+ *
+ * Implementation of the NSGA-II multi-objective evolutionary algorithm.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_NSGA2_NSGA2_IMPL_HPP
+#define ENSMALLEN_NSGA2_NSGA2_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "nsga2.hpp"
+
+namespace ens {
+
+inline NSGA2::NSGA2(const size_t populationSize,
+                    const size_t maxGenerations,
+                    const double crossoverProb,
+                    const double mutationProb,
+                    const double distributionIndex,
+                    const arma::mat& lowerBound,
+                    const arma::mat& upperBound) :
+    populationSize(populationSize),
+    maxGenerations(maxGenerations),
+    crossoverProb(crossoverProb),
+    mutationProb(mutationProb),
+    distributionIndex(distributionIndex),
+    lowerBound(lowerBound),
+    upperBound(upperBound)
+{ /* Nothing to do. */ }
+
+inline NSGA2::NSGA2(const size_t populationSize,
+                    const size_t maxGenerations,
+                    const double crossoverProb,
+                    const double mutationProb,
+                    const double distributionIndex,
+                    const double lowerBound,
+                    const double upperBound) :
+    populationSize(populationSize),
+    maxGenerations(maxGenerations),
+    crossoverProb(crossoverProb),
+    mutationProb(mutationProb),
+    distributionIndex(distributionIndex),
+    lowerBound(lowerBound * arma::ones(1, 1)),
+    upperBound(upperBound * arma::ones(1, 1))
+{ /* Nothing to do. */ }
+
+//! Optimize the function (approximate the Pareto front).
+template<typename MultiObjectiveFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type NSGA2::Optimize(
+    MultiObjectiveFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckMultiObjectiveFunctionTypeAPI<MultiObjectiveFunctionType,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  const size_t n = iterate.n_elem;
+
+  if (n == 0)
+  {
+    throw std::invalid_argument("NSGA2::Optimize(): the coordinates must not "
+        "be empty");
+  }
+
+  if (populationSize < 4)
+  {
+    throw std::invalid_argument("NSGA2::Optimize(): the population size must "
+        "be at least 4");
+  }
+
+  // Expand the bounds to one value per element.
+  arma::Col<ElemType> lower(n), upper(n);
+  if (lowerBound.n_elem == 1)
+    lower.fill(ElemType(lowerBound(0)));
+  else if (lowerBound.n_elem == n)
+    lower = arma::conv_to<arma::Col<ElemType>>::from(arma::vectorise(
+        lowerBound));
+  else
+    throw std::invalid_argument("NSGA2::Optimize(): the lower bound must have "
+        "one element or as many elements as the coordinates");
+
+  if (upperBound.n_elem == 1)
+    upper.fill(ElemType(upperBound(0)));
+  else if (upperBound.n_elem == n)
+    upper = arma::conv_to<arma::Col<ElemType>>::from(arma::vectorise(
+        upperBound));
+  else
+    throw std::invalid_argument("NSGA2::Optimize(): the upper bound must have "
+        "one element or as many elements as the coordinates");
+
+  if (!lower.is_finite() || !upper.is_finite() || arma::any(upper <= lower))
+  {
+    throw std::invalid_argument("NSGA2::Optimize(): the bounds must be finite, "
+        "and the upper bound must be larger than the lower bound");
+  }
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+
+  // The members and the offspring, one (vectorised) point per column; the
+  // members are the first populationSize columns.  The starting point is a
+  // member, and the others are drawn uniformly from the box.
+  const size_t numMembers = populationSize;
+  arma::Mat<ElemType> points(n, 2 * numMembers);
+  points.col(0) = arma::min(arma::max(arma::vectorise(iterate), lower),
+      upper);
+  points.cols(1, numMembers - 1).randu();
+  points.cols(1, numMembers - 1).each_col() %= (upper - lower);
+  points.cols(1, numMembers - 1).each_col() += lower;
+
+  // The objectives of the starting point give the number of objectives.
+  arma::Mat<ElemType> objectives;
+  {
+    const BaseMatType start(points.colptr(0), iterate.n_rows, iterate.n_cols,
+        false, true);
+    const arma::Col<ElemType> startObjectives = function.Evaluate(start);
+    if (startObjectives.n_elem == 0)
+    {
+      throw std::invalid_argument("NSGA2::Optimize(): Evaluate() must return "
+          "at least one objective");
+    }
+
+    objectives.set_size(startObjectives.n_elem, 2 * numMembers);
+    objectives.col(0) = startObjectives;
+    objectives.col(0).replace(std::numeric_limits<ElemType>::quiet_NaN(),
+        std::numeric_limits<ElemType>::infinity());
+  }
+  EvaluatePoints(function, iterate, points, 1, numMembers, objectives);
+
+  arma::uvec ranks;
+  arma::vec crowding;
+  RankAndCrowd(arma::Mat<ElemType>(objectives.cols(0, numMembers - 1)), ranks,
+      crowding);
+
+  arma::uvec allRanks;
+  arma::vec allCrowding;
+  arma::Col<ElemType> first, second;
+  for (size_t gen = 0; gen < maxGenerations && !terminate; ++gen)
+  {
+    // Create the offspring in the last populationSize columns.
+    for (size_t k = 0; k < numMembers; k += 2)
+    {
+      first = points.col(Tournament(ranks, crowding));
+      second = points.col(Tournament(ranks, crowding));
+      if (arma::randu() < crossoverProb)
+        Crossover(first, second);
+
+      Mutate(first, lower, upper);
+      points.col(numMembers + k) = first;
+      if (k + 1 < numMembers)
+      {
+        Mutate(second, lower, upper);
+        points.col(numMembers + k + 1) = second;
+      }
+    }
+
+    EvaluatePoints(function, iterate, points, numMembers, 2 * numMembers,
+        objectives);
+
+    // The best fronts of members and offspring survive; the last front that
+    // does not fit completely is truncated by crowding distance.
+    RankAndCrowd(objectives, allRanks, allCrowding);
+    arma::uvec survivors(numMembers);
+    size_t numSurvivors = 0;
+    for (size_t rank = 0; numSurvivors < numMembers; ++rank)
+    {
+      const arma::uvec front = arma::find(allRanks == rank);
+      const size_t count = std::min((size_t) front.n_elem,
+          numMembers - numSurvivors);
+      if (count == front.n_elem)
+      {
+        survivors.subvec(numSurvivors, numSurvivors + count - 1) = front;
+      }
+      else
+      {
+        const arma::uvec order = arma::sort_index(allCrowding.elem(front),
+            "descend");
+        survivors.subvec(numSurvivors, numSurvivors + count - 1) =
+            front.elem(order.head(count));
+      }
+      numSurvivors += count;
+    }
+
+    const arma::Mat<ElemType> survivingPoints = points.cols(survivors);
+    const arma::Mat<ElemType> survivingObjectives =
+        objectives.cols(survivors);
+    points.cols(0, numMembers - 1) = survivingPoints;
+    objectives.cols(0, numMembers - 1) = survivingObjectives;
+    ranks = allRanks.elem(survivors);
+    crowding = allCrowding.elem(survivors);
+
+    iterate = arma::reshape(points.col(BestMember(objectives, ranks)),
+        iterate.n_rows, iterate.n_cols);
+    terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+  }
+
+  // Store the first front of the final population.
+  const arma::uvec front = arma::find(ranks == 0);
+  paretoSet = arma::conv_to<arma::mat>::from(arma::Mat<ElemType>(
+      points.cols(front)));
+  paretoFront = arma::conv_to<arma::mat>::from(arma::Mat<ElemType>(
+      objectives.cols(front)));
+
+  const size_t best = BestMember(objectives, ranks);
+  iterate = arma::reshape(points.col(best), iterate.n_rows, iterate.n_cols);
+
+  Info << "NSGA2: " << front.n_elem << " points in the Pareto front."
+      << std::endl;
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return arma::accu(objectives.col(best));
+}
+
+template<typename MultiObjectiveFunctionType, typename BaseMatType>
+inline void NSGA2::EvaluatePoints(
+    MultiObjectiveFunctionType& function,
+    const BaseMatType& iterate,
+    const arma::Mat<typename BaseMatType::elem_type>& points,
+    const size_t begin,
+    const size_t end,
+    arma::Mat<typename BaseMatType::elem_type>& objectives)
+{
+  typedef typename BaseMatType::elem_type ElemType;
+
+  std::vector<arma::Col<ElemType>> values(end - begin);
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t j = (ptrdiff_t) begin; j < (ptrdiff_t) end; ++j)
+  {
+    const BaseMatType candidate(const_cast<ElemType*>(points.colptr(j)),
+        iterate.n_rows, iterate.n_cols, false, true);
+    values[j - begin] = function.Evaluate(candidate);
+  }
+
+  // Failed evaluations are dominated by everything else.
+  for (size_t j = begin; j < end; ++j)
+  {
+    if (values[j - begin].n_elem != objectives.n_rows)
+    {
+      throw std::invalid_argument("NSGA2::Optimize(): Evaluate() must return "
+          "the same number of objectives for every point");
+    }
+
+    objectives.col(j) = values[j - begin];
+    objectives.col(j).replace(std::numeric_limits<ElemType>::quiet_NaN(),
+        std::numeric_limits<ElemType>::infinity());
+  }
+}
+
+template<typename ElemType>
+inline void NSGA2::RankAndCrowd(const arma::Mat<ElemType>& objectives,
+                                arma::uvec& ranks,
+                                arma::vec& crowding)
+{
+  NonDominatedSort(objectives, ranks);
+
+  crowding.zeros(objectives.n_cols);
+  const size_t numFronts = ranks.max() + 1;
+  for (size_t rank = 0; rank < numFronts; ++rank)
+    CrowdingDistance(objectives, arma::find(ranks == rank), crowding);
+}
+
+template<typename ElemType>
+inline void NSGA2::NonDominatedSort(const arma::Mat<ElemType>& objectives,
+                                    arma::uvec& ranks)
+{
+  if (objectives.n_rows == 2)
+  {
+    NonDominatedSortTwoObjectives(objectives, ranks);
+    return;
+  }
+
+  // For each point, the points it dominates and the number of points that
+  // dominate it.
+  const size_t numPoints = objectives.n_cols;
+  std::vector<std::vector<size_t>> dominated(numPoints);
+  std::vector<size_t> dominationCount(numPoints, 0);
+  for (size_t p = 0; p < numPoints; ++p)
+  {
+    for (size_t q = p + 1; q < numPoints; ++q)
+    {
+      if (Dominates(objectives, p, q))
+      {
+        dominated[p].push_back(q);
+        ++dominationCount[q];
+      }
+      else if (Dominates(objectives, q, p))
+      {
+        dominated[q].push_back(p);
+        ++dominationCount[p];
+      }
+    }
+  }
+
+  // Peel off the fronts: each front is made of the points that are only
+  // dominated by points of the previous fronts.
+  ranks.set_size(numPoints);
+  std::vector<size_t> front, next;
+  for (size_t p = 0; p < numPoints; ++p)
+  {
+    if (dominationCount[p] == 0)
+    {
+      ranks(p) = 0;
+      front.push_back(p);
+    }
+  }
+
+  for (size_t rank = 1; !front.empty(); ++rank)
+  {
+    next.clear();
+    for (size_t i = 0; i < front.size(); ++i)
+    {
+      const std::vector<size_t>& p = dominated[front[i]];
+      for (size_t j = 0; j < p.size(); ++j)
+      {
+        if (--dominationCount[p[j]] == 0)
+        {
+          ranks(p[j]) = rank;
+          next.push_back(p[j]);
+        }
+      }
+    }
+    front.swap(next);
+  }
+}
+
+template<typename ElemType>
+inline void NSGA2::NonDominatedSortTwoObjectives(
+    const arma::Mat<ElemType>& objectives,
+    arma::uvec& ranks)
+{
+  const size_t numPoints = objectives.n_cols;
+
+  // Sort the points by the first objective, then by the second.
+  std::vector<size_t> order(numPoints);
+  for (size_t p = 0; p < numPoints; ++p)
+    order[p] = p;
+  std::sort(order.begin(), order.end(),
+      [&objectives](const size_t p, const size_t q)
+      {
+        return objectives(0, p) < objectives(0, q) ||
+            (objectives(0, p) == objectives(0, q) &&
+             objectives(1, p) < objectives(1, q));
+      });
+
+  // Every earlier point is no worse in the first objective, so a front
+  // dominates a point if and only if the last point added to it (the one with
+  // the smallest second objective) does.  Since that is monotone over the
+  // fronts, the first front that does not dominate the point is found by
+  // binary search.
+  ranks.set_size(numPoints);
+  std::vector<size_t> lastPoints;
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const size_t p = order[i];
+    size_t low = 0, high = lastPoints.size();
+    while (low < high)
+    {
+      const size_t mid = (low + high) / 2;
+      if (Dominates(objectives, lastPoints[mid], p))
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+    if (low == lastPoints.size())
+      lastPoints.push_back(p);
+    else
+      lastPoints[low] = p;
+    ranks(p) = low;
+  }
+}
+
+template<typename ElemType>
+inline bool NSGA2::Dominates(const arma::Mat<ElemType>& objectives,
+                             const size_t p,
+                             const size_t q)
+{
+  bool better = false;
+  for (size_t m = 0; m < objectives.n_rows; ++m)
+  {
+    if (objectives(m, p) > objectives(m, q))
+      return false;
+    else if (objectives(m, p) < objectives(m, q))
+      better = true;
+  }
+  return better;
+}
+
+template<typename ElemType>
+inline void NSGA2::CrowdingDistance(const arma::Mat<ElemType>& objectives,
+                                    const arma::uvec& front,
+                                    arma::vec& distance)
+{
+  distance.elem(front).zeros();
+  if (front.n_elem <= 2)
+  {
+    distance.elem(front).fill(arma::datum::inf);
+    return;
+  }
+
+  arma::Col<ElemType> values(front.n_elem);
+  for (size_t m = 0; m < objectives.n_rows; ++m)
+  {
+    for (size_t i = 0; i < front.n_elem; ++i)
+      values(i) = objectives(m, front(i));
+
+    const arma::uvec order = arma::sort_index(values);
+    distance(front(order(0))) = arma::datum::inf;
+    distance(front(order(front.n_elem - 1))) = arma::datum::inf;
+
+    const double range = double(values(order(front.n_elem - 1)) -
+        values(order(0)));
+    if (!(range > 0.0) || !std::isfinite(range))
+      continue;
+
+    for (size_t i = 1; i + 1 < front.n_elem; ++i)
+    {
+      distance(front(order(i))) += double(values(order(i + 1)) -
+          values(order(i - 1))) / range;
+    }
+  }
+}
+
+inline size_t NSGA2::Tournament(const arma::uvec& ranks,
+                                const arma::vec& crowding)
+{
+  const size_t a = arma::randi<arma::uword>(arma::distr_param(0,
+      (int) ranks.n_elem - 1));
+  const size_t b = arma::randi<arma::uword>(arma::distr_param(0,
+      (int) ranks.n_elem - 1));
+
+  if (ranks(a) != ranks(b))
+    return (ranks(a) < ranks(b)) ? a : b;
+  return (crowding(a) >= crowding(b)) ? a : b;
+}
+
+template<typename ElemType>
+inline size_t NSGA2::BestMember(const arma::Mat<ElemType>& objectives,
+                                const arma::uvec& ranks)
+{
+  size_t best = 0;
+  ElemType bestSum = std::numeric_limits<ElemType>::infinity();
+  for (size_t j = 0; j < ranks.n_elem; ++j)
+  {
+    const ElemType sum = arma::accu(objectives.col(j));
+    if (ranks(j) == 0 && (sum < bestSum || ranks(best) != 0))
+    {
+      best = j;
+      bestSum = sum;
+    }
+  }
+  return best;
+}
+
+template<typename ElemType>
+inline void NSGA2::Crossover(arma::Col<ElemType>& first,
+                             arma::Col<ElemType>& second) const
+{
+  // Each element is crossed over with probability 0.5; the spread factor beta
+  // has a polynomial distribution around 1.
+  const double exponent = 1.0 / (distributionIndex + 1.0);
+  for (size_t i = 0; i < first.n_elem; ++i)
+  {
+    if (arma::randu() >= 0.5 || std::abs(first(i) - second(i)) <= 1e-14)
+      continue;
+
+    const double u = arma::randu();
+    const double beta = (u <= 0.5) ? std::pow(2.0 * u, exponent) :
+        std::pow(1.0 / (2.0 * (1.0 - u)), exponent);
+
+    const ElemType x1 = first(i);
+    const ElemType x2 = second(i);
+    first(i) = ElemType(0.5 * ((1.0 + beta) * x1 + (1.0 - beta) * x2));
+    second(i) = ElemType(0.5 * ((1.0 - beta) * x1 + (1.0 + beta) * x2));
+  }
+}
+
+template<typename ElemType>
+inline void NSGA2::Mutate(arma::Col<ElemType>& child,
+                          const arma::Col<ElemType>& lower,
+                          const arma::Col<ElemType>& upper) const
+{
+  const double exponent = 1.0 / (distributionIndex + 1.0);
+  for (size_t i = 0; i < child.n_elem; ++i)
+  {
+    if (arma::randu() < mutationProb)
+    {
+      const double u = arma::randu();
+      const double delta = (u < 0.5) ? std::pow(2.0 * u, exponent) - 1.0 :
+          1.0 - std::pow(2.0 * (1.0 - u), exponent);
+      child(i) += ElemType(delta * (upper(i) - lower(i)));
+    }
+
+    child(i) = std::min(std::max(child(i), lower(i)), upper(i));
+  }
+}
+
+} // namespace ens
+
+#endif
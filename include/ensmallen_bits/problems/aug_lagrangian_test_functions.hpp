@@ -90,6 +90,52 @@ class GockenbachFunction
   arma::mat initialPoint;
 };
 
+/**
+ * A separable constrained function: the mean squared distance to n points,
+ *
+ *   f(x) = (1 / n) sum_i ||x - a_i||^2,
+ *
+ * subject to x_1 + x_2 = 1.  The points are scattered around (3, 1) and
+ * centered exactly on it, so the minimum that satisfies the constraint is
+ * x = [1.5, -0.5], with an objective value of 4.5 plus the variance of the
+ * points.
+ */
+class SeparableAugLagrangianTestFunction
+{
+ public:
+  SeparableAugLagrangianTestFunction(const size_t numFunctions = 1000);
+
+  size_t NumFunctions() const { return points.n_cols; }
+  void Shuffle();
+
+  double Evaluate(const arma::mat& coordinates);
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient);
+
+  double Evaluate(const arma::mat& coordinates,
+                  const size_t begin,
+                  const size_t batchSize);
+  void Gradient(const arma::mat& coordinates,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
+  size_t NumConstraints() const { return 1; }
+
+  double EvaluateConstraint(const size_t index, const arma::mat& coordinates);
+  void GradientConstraint(const size_t index,
+                          const arma::mat& coordinates,
+                          arma::mat& gradient);
+
+  const arma::mat& GetInitialPoint() const { return initialPoint; }
+
+  //! Return the points.
+  const arma::mat& Points() const { return points; }
+
+ private:
+  arma::mat points;
+  arma::mat initialPoint;
+};
+
 /**
  * This function is the Lovasz-Theta semidefinite program, as implemented in the
  * following paper:
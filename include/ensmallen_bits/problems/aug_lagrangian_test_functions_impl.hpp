@@ -172,6 +172,87 @@ inline void GockenbachFunction::GradientConstraint(const size_t index,
   }
 }
 
+//
+// SeparableAugLagrangianTestFunction
+//
+inline SeparableAugLagrangianTestFunction::SeparableAugLagrangianTestFunction(
+    const size_t numFunctions)
+{
+  // Scatter the points around (3, 1), and center them exactly.
+  points.randn(2, numFunctions);
+  points.each_col() -= arma::mean(points, 1);
+  points.row(0) += 3;
+  points.row(1) += 1;
+
+  initialPoint.zeros(2, 1);
+}
+
+inline void SeparableAugLagrangianTestFunction::Shuffle()
+{
+  points = points.cols(arma::shuffle(arma::linspace<arma::uvec>(0,
+      points.n_cols - 1, points.n_cols))).eval();
+}
+
+inline double SeparableAugLagrangianTestFunction::Evaluate(
+    const arma::mat& coordinates)
+{
+  return Evaluate(coordinates, 0, points.n_cols);
+}
+
+inline void SeparableAugLagrangianTestFunction::Gradient(
+    const arma::mat& coordinates,
+    arma::mat& gradient)
+{
+  Gradient(coordinates, 0, gradient, points.n_cols);
+}
+
+inline double SeparableAugLagrangianTestFunction::Evaluate(
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize)
+{
+  // f_i(x) = ||x - a_i||^2 / n
+  arma::mat diff = points.cols(begin, begin + batchSize - 1);
+  diff.each_col() -= coordinates.col(0);
+  return arma::accu(arma::square(diff)) / points.n_cols;
+}
+
+inline void SeparableAugLagrangianTestFunction::Gradient(
+    const arma::mat& coordinates,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  // f'_i(x) = 2 (x - a_i) / n
+  gradient = 2.0 * (batchSize * coordinates - arma::sum(points.cols(begin,
+      begin + batchSize - 1), 1)) / points.n_cols;
+}
+
+inline double SeparableAugLagrangianTestFunction::EvaluateConstraint(
+    const size_t index,
+    const arma::mat& coordinates)
+{
+  // We return 0 if the index is wrong (not 0).
+  if (index != 0)
+    return 0;
+
+  // c(x) = x_1 + x_2 - 1
+  return (coordinates[0] + coordinates[1] - 1);
+}
+
+inline void SeparableAugLagrangianTestFunction::GradientConstraint(
+    const size_t index,
+    const arma::mat& /* coordinates */,
+    arma::mat& gradient)
+{
+  // If the user passed an invalid index (not 0), we will return a zero
+  // gradient.
+  gradient.zeros(2, 1);
+
+  if (index == 0)
+    gradient.ones(2, 1);
+}
+
 //
 // LovaszThetaSDP
 //
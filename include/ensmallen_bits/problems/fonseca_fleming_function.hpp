@@ -0,0 +1,75 @@
+/**
+ * @file fonseca_fleming_function.hpp
+ *
+ * Definition of the Fonseca-Fleming function, a multi-objective test problem.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_FONSECA_FLEMING_FUNCTION_HPP
+#define ENSMALLEN_PROBLEMS_FONSECA_FLEMING_FUNCTION_HPP
+
+namespace ens {
+namespace test {
+
+/**
+ * The Fonseca-Fleming function, a multi-objective function of n variables
+ * with the two objectives
+ *
+ * \f[
+ * f_1(x) = 1 - \exp(-\sum_i (x_i - 1 / \sqrt{n})^2), \quad
+ * f_2(x) = 1 - \exp(-\sum_i (x_i + 1 / \sqrt{n})^2),
+ * \f]
+ *
+ * usually considered for -4 <= x_i <= 4.  The Pareto optimal set is the
+ * segment x_1 = ... = x_n, -1 / sqrt(n) <= x_i <= 1 / sqrt(n), and the Pareto
+ * front is concave.
+ *
+ * For more information, please refer to:
+ *
+ * @code
+ * @article{Fonseca1995,
+ *   author  = {Fonseca, Carlos M. and Fleming, Peter J.},
+ *   title   = {An Overview of Evolutionary Algorithms in Multiobjective
+ *              Optimization},
+ *   journal = {Evolutionary Computation},
+ *   volume  = {3},
+ *   number  = {1},
+ *   pages   = {1--16},
+ *   year    = {1995}
+ * }
+ * @endcode
+ */
+class FonsecaFlemingFunction
+{
+ public:
+  //! Initialize the FonsecaFlemingFunction.
+  FonsecaFlemingFunction();
+
+  //! Return 2 (the number of objectives).
+  size_t NumObjectives() const { return 2; }
+
+  //! Get the starting point.
+  template<typename MatType = arma::mat>
+  MatType GetInitialPoint() const { return MatType("2; -2; 3"); }
+
+  /**
+   * Evaluate both objectives with the given coordinates.
+   *
+   * @param coordinates The function coordinates.
+   * @return The value of each objective.
+   */
+  template<typename MatType>
+  arma::Col<typename MatType::elem_type> Evaluate(
+      const MatType& coordinates) const;
+};
+
+} // namespace test
+} // namespace ens
+
+// Include implementation.
+#include "fonseca_fleming_function_impl.hpp"
+
+#endif // ENSMALLEN_PROBLEMS_FONSECA_FLEMING_FUNCTION_HPP
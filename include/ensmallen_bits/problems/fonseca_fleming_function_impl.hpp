@@ -0,0 +1,43 @@
+/**
+ * @file fonseca_fleming_function_impl.hpp
+ *
+ * Implementation of the Fonseca-Fleming function.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_FONSECA_FLEMING_FUNCTION_IMPL_HPP
+#define ENSMALLEN_PROBLEMS_FONSECA_FLEMING_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "fonseca_fleming_function.hpp"
+
+namespace ens {
+namespace test {
+
+inline FonsecaFlemingFunction::FonsecaFlemingFunction()
+{ /* Nothing to do here */ }
+
+template<typename MatType>
+arma::Col<typename MatType::elem_type> FonsecaFlemingFunction::Evaluate(
+    const MatType& coordinates) const
+{
+  // Convenience typedef.
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType shift = 1 / std::sqrt(ElemType(coordinates.n_elem));
+
+  arma::Col<ElemType> objectives(2);
+  objectives(0) = 1 - std::exp(-arma::accu(arma::square(coordinates -
+      shift)));
+  objectives(1) = 1 - std::exp(-arma::accu(arma::square(coordinates +
+      shift)));
+  return objectives;
+}
+
+} // namespace test
+} // namespace ens
+
+#endif
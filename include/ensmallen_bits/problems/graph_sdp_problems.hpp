@@ -0,0 +1,106 @@
+/**
+ * @file graph_sdp_problems.hpp
+ *
+ * Construct the max-cut and Lovasz-Theta semidefinite programs of a graph,
+ * for instance to benchmark the SDP solvers on the graphs in tests/data/.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_GRAPH_SDP_PROBLEMS_HPP
+#define ENSMALLEN_PROBLEMS_GRAPH_SDP_PROBLEMS_HPP
+
+#include "../sdp/sdp.hpp"
+
+namespace ens {
+namespace test {
+
+/**
+ * Create the max-cut SDP relaxation of the given graph,
+ *
+ *     min    dot(-L, X)
+ *     s.t.   X_ii = 1, i=1,...,n, X >= 0,
+ *
+ * where L is the (weighted) Laplacian of the graph.  The edge matrix has one
+ * column per edge, holding the indices of its two vertices.
+ *
+ * @param edges Matrix of edges.
+ * @param weights Weights of the edges; if empty, all weights are 1.
+ */
+inline SDP<arma::sp_mat> CreateMaxCutSDP(const arma::mat& edges,
+                                         const arma::vec& weights = arma::vec())
+{
+  const size_t vertices = (size_t) arma::max(arma::max(edges)) + 1;
+  const size_t numEdges = edges.n_cols;
+
+  SDP<arma::sp_mat> sdp;
+  arma::umat locations(2, 4 * numEdges);
+  arma::vec values(4 * numEdges);
+  for (size_t e = 0; e < numEdges; ++e)
+  {
+    const arma::uword i = (arma::uword) edges(0, e);
+    const arma::uword j = (arma::uword) edges(1, e);
+    const double w = weights.is_empty() ? 1.0 : weights[e];
+
+    // -L has -w on the diagonal and w off the diagonal.
+    locations.col(4 * e) = arma::uvec({ i, i });
+    locations.col(4 * e + 1) = arma::uvec({ j, j });
+    locations.col(4 * e + 2) = arma::uvec({ i, j });
+    locations.col(4 * e + 3) = arma::uvec({ j, i });
+    values.subvec(4 * e, 4 * e + 3) = arma::vec({ -w, -w, w, w });
+  }
+  sdp.C() = arma::sp_mat(true, locations, values, vertices, vertices);
+
+  sdp.SparseA().resize(vertices);
+  for (arma::uword i = 0; i < vertices; ++i)
+  {
+    const arma::umat location = { { i }, { i } };
+    sdp.SparseA()[i] = arma::sp_mat(location, arma::vec({ 1.0 }), vertices,
+        vertices);
+  }
+  sdp.SparseB().ones(vertices);
+
+  return sdp;
+}
+
+/**
+ * Create the Lovasz-Theta SDP of the given graph,
+ *
+ *     min    dot(-e e^T, X)
+ *     s.t.   Tr(X) = 1, X_ij = 0 for all edges (i, j), X >= 0.
+ *
+ * The edge matrix has one column per edge, holding the indices of its two
+ * vertices.
+ *
+ * @param edges Matrix of edges.
+ */
+inline SDP<arma::sp_mat> CreateLovaszThetaSDP(const arma::mat& edges)
+{
+  const size_t vertices = (size_t) arma::max(arma::max(edges)) + 1;
+
+  SDP<arma::sp_mat> sdp;
+  sdp.C() = -arma::sp_mat(arma::ones<arma::mat>(vertices, vertices));
+
+  sdp.SparseA().resize(edges.n_cols + 1);
+  sdp.SparseA()[0] = arma::speye<arma::sp_mat>(vertices, vertices);
+  for (size_t e = 0; e < edges.n_cols; ++e)
+  {
+    const arma::uword i = (arma::uword) edges(0, e);
+    const arma::uword j = (arma::uword) edges(1, e);
+    const arma::umat locations = { { i, j }, { j, i } };
+    sdp.SparseA()[e + 1] = arma::sp_mat(locations, arma::vec({ 1.0, 1.0 }),
+        vertices, vertices);
+  }
+
+  sdp.SparseB().zeros(edges.n_cols + 1);
+  sdp.SparseB()[0] = 1.0;
+
+  return sdp;
+}
+
+} // namespace test
+} // namespace ens
+
+#endif
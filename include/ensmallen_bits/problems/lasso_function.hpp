@@ -0,0 +1,133 @@
+/**
+ * @file lasso_function.hpp
+ *
+ * The least squares (elastic net) loss, to be used with an L1 penalty by
+ * ScreenedSCD.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_LASSO_FUNCTION_HPP
+#define ENSMALLEN_PROBLEMS_LASSO_FUNCTION_HPP
+
+namespace ens {
+namespace test {
+
+/**
+ * The smooth part of the Lasso and elastic net problems,
+ *
+ *   f(w) = 1 / (2 n) ||y - w X||^2 + l2 / 2 ||w||^2,
+ *
+ * where X is the d x n matrix of predictors (one column per point), y holds
+ * the n responses, and w is a 1 x d row of coefficients (one coordinate per
+ * feature).  The L1 penalty lambda ||w||_1 is handled by the optimizer.
+ *
+ * Besides the resolvable function API (NumFeatures(), Evaluate() and
+ * PartialGradient()), the function provides the full Gradient(), which holds
+ * the correlations of the features with the residual, and the hooks used by
+ * the gap safe screening rules of ScreenedSCD: DualityGap() and
+ * FeatureNorms().  They treat the elastic net as a Lasso problem with the
+ * augmented design [X / sqrt(n); sqrt(l2) I].
+ *
+ * All evaluations only touch the rows of X of the nonzero coefficients to
+ * compute the residual, so they are cheap for sparse coefficients.
+ */
+class LassoFunction
+{
+ public:
+  /**
+   * Construct the function with the given data.
+   *
+   * @param predictors Matrix of predictors, one column per point.
+   * @param responses Responses of the points.
+   * @param l2 Weight of the L2 penalty (0 for the Lasso).
+   */
+  LassoFunction(const arma::mat& predictors,
+                const arma::rowvec& responses,
+                const double l2 = 0.0);
+
+  //! Return the number of features.
+  size_t NumFeatures() const { return predictors.n_rows; }
+
+  /**
+   * Evaluate the smooth loss at the given coefficients.
+   *
+   * @param coordinates The coefficients.
+   */
+  double Evaluate(const arma::mat& coordinates) const;
+
+  /**
+   * Evaluate the gradient of the smooth loss with respect to all the
+   * coefficients.
+   *
+   * @param coordinates The coefficients.
+   * @param gradient Matrix to store the gradient into.
+   */
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient) const;
+
+  /**
+   * Evaluate the gradient of the smooth loss with respect to coefficient j.
+   *
+   * @param coordinates The coefficients.
+   * @param j Index of the coefficient.
+   * @param gradient Sparse matrix to store the gradient into.
+   */
+  void PartialGradient(const arma::mat& coordinates,
+                       const size_t j,
+                       arma::sp_mat& gradient) const;
+
+  /**
+   * Compute the duality gap of the L1-penalized problem with the given
+   * penalty, at the given coefficients and at the dual point obtained by
+   * rescaling the residual, theta = r / max(lambda, ||g||_inf), where g is the
+   * gradient.
+   *
+   * @param coordinates The coefficients.
+   * @param gradient The gradient at the coefficients.
+   * @param lambda Weight of the L1 penalty.
+   */
+  double DualityGap(const arma::mat& coordinates,
+                    const arma::mat& gradient,
+                    const double lambda) const;
+
+  //! Compute the duality gap, computing the gradient at the coefficients.
+  double DualityGap(const arma::mat& coordinates, const double lambda) const;
+
+  /**
+   * Return the norms of the columns of the (augmented) design matrix, that is
+   * sqrt(||x_j||^2 / n + l2) for each feature j.
+   */
+  const arma::vec& FeatureNorms() const { return featureNorms; }
+
+  //! Return the smallest L1 penalty for which the solution is zero.
+  double LambdaMax() const;
+
+  //! Return the initial point (zero coefficients).
+  arma::mat GetInitialPoint() const { return arma::zeros(1, NumFeatures()); }
+
+  //! Get the weight of the L2 penalty.
+  double L2() const { return l2; }
+
+ private:
+  //! Compute the residual y - w X.
+  arma::rowvec Residual(const arma::mat& coordinates) const;
+
+  //! The predictors.
+  arma::mat predictors;
+  //! The responses.
+  arma::rowvec responses;
+  //! The weight of the L2 penalty.
+  double l2;
+  //! The norms of the augmented features.
+  arma::vec featureNorms;
+};
+
+} // namespace test
+} // namespace ens
+
+// Include implementation.
+#include "lasso_function_impl.hpp"
+
+#endif // ENSMALLEN_PROBLEMS_LASSO_FUNCTION_HPP
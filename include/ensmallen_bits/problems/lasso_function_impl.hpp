@@ -0,0 +1,111 @@
+/**
+ * @file lasso_function_impl.hpp
+ *
+ * Implementation of the least squares (elastic net) loss.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_LASSO_FUNCTION_IMPL_HPP
+#define ENSMALLEN_PROBLEMS_LASSO_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "lasso_function.hpp"
+
+namespace ens {
+namespace test {
+
+inline LassoFunction::LassoFunction(const arma::mat& predictors,
+                                    const arma::rowvec& responses,
+                                    const double l2) :
+    predictors(predictors),
+    responses(responses),
+    l2(l2)
+{
+  if (responses.n_elem != predictors.n_cols)
+  {
+    throw std::invalid_argument("LassoFunction: the number of responses must "
+        "match the number of points");
+  }
+
+  featureNorms = arma::sqrt(arma::sum(arma::square(predictors), 1) /
+      predictors.n_cols + l2);
+}
+
+inline arma::rowvec LassoFunction::Residual(const arma::mat& coordinates) const
+{
+  const arma::uvec nonzero = arma::find(coordinates);
+  if (nonzero.n_elem == 0)
+    return responses;
+
+  return responses - coordinates.cols(nonzero) * predictors.rows(nonzero);
+}
+
+inline double LassoFunction::Evaluate(const arma::mat& coordinates) const
+{
+  const arma::rowvec residual = Residual(coordinates);
+  return 0.5 * arma::dot(residual, residual) / predictors.n_cols +
+      0.5 * l2 * arma::accu(arma::square(coordinates));
+}
+
+inline void LassoFunction::Gradient(const arma::mat& coordinates,
+                                    arma::mat& gradient) const
+{
+  gradient = -Residual(coordinates) * predictors.t() / predictors.n_cols +
+      l2 * coordinates;
+}
+
+inline void LassoFunction::PartialGradient(const arma::mat& coordinates,
+                                           const size_t j,
+                                           arma::sp_mat& gradient) const
+{
+  gradient.zeros(1, NumFeatures());
+  gradient(0, j) = -arma::dot(Residual(coordinates), predictors.row(j)) /
+      predictors.n_cols + l2 * coordinates(0, j);
+}
+
+inline double LassoFunction::DualityGap(const arma::mat& coordinates,
+                                        const arma::mat& gradient,
+                                        const double lambda) const
+{
+  // In the augmented Lasso form, the residual is
+  // [(y - w X) / sqrt(n), -sqrt(l2) w], and the responses are [y / sqrt(n), 0].
+  const double n = predictors.n_cols;
+  const arma::rowvec residual = Residual(coordinates) / std::sqrt(n);
+  const arma::mat augmentedResidual = -std::sqrt(l2) * coordinates;
+
+  const double scale = std::max(lambda, arma::abs(gradient).max());
+
+  const double primal = 0.5 * arma::dot(residual, residual) +
+      0.5 * arma::accu(arma::square(augmentedResidual)) +
+      lambda * arma::accu(arma::abs(coordinates));
+
+  // D(theta) = ||y||^2 / 2 - ||y - lambda theta||^2 / 2.
+  const double t = lambda / scale;
+  const arma::rowvec y = responses / std::sqrt(n);
+  const double dual = 0.5 * arma::dot(y, y) - 0.5 * (arma::accu(arma::square(
+      y - t * residual)) + t * t * arma::accu(arma::square(
+      augmentedResidual)));
+
+  return std::max(primal - dual, 0.0);
+}
+
+inline double LassoFunction::DualityGap(const arma::mat& coordinates,
+                                        const double lambda) const
+{
+  arma::mat gradient;
+  Gradient(coordinates, gradient);
+  return DualityGap(coordinates, gradient, lambda);
+}
+
+inline double LassoFunction::LambdaMax() const
+{
+  return arma::abs(responses * predictors.t()).max() / predictors.n_cols;
+}
+
+} // namespace test
+} // namespace ens
+
+#endif
@@ -17,12 +17,15 @@
 #include "drop_wave_function.hpp"
 #include "easom_function.hpp"
 #include "eggholder_function.hpp"
+#include "fonseca_fleming_function.hpp"
 #include "fw_test_function.hpp"
 #include "generalized_rosenbrock_function.hpp"
 #include "goldstein_price_function.hpp"
 #include "gradient_descent_test_function.hpp"
+#include "graph_sdp_problems.hpp"
 #include "himmelblau_function.hpp"
 #include "holder_table_function.hpp"
+#include "lasso_function.hpp"
 #include "levy_function_n13.hpp"
 #include "logistic_regression_function.hpp"
 #include "matyas_function.hpp"
@@ -30,9 +33,11 @@
 #include "rastrigin_function.hpp"
 #include "rosenbrock_function.hpp"
 #include "rosenbrock_wood_function.hpp"
+#include "schaffer_function_n1.hpp"
 #include "schaffer_function_n2.hpp"
 #include "schaffer_function_n4.hpp"
 #include "schwefel_function.hpp"
+#include "sampled_softmax_function.hpp"
 #include "sgd_test_function.hpp"
 #include "softmax_regression_function.hpp"
 #include "sparse_test_function.hpp"
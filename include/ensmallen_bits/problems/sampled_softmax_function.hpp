@@ -0,0 +1,250 @@
+/**
+ * @file sampled_softmax_function.hpp
+ *
+ * The sampled softmax objective for softmax regression with very many classes.
+ * Each evaluation only touches the true classes of the batch and a few
+ * classes sampled from a proposal distribution.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_SAMPLED_SOFTMAX_FUNCTION_HPP
+#define ENSMALLEN_PROBLEMS_SAMPLED_SOFTMAX_FUNCTION_HPP
+
+namespace ens {
+namespace test {
+
+/**
+ * An alias table (Walker's alias method, in Vose's formulation) for sampling
+ * from a fixed discrete distribution in O(1) time per sample, after O(n)
+ * construction.
+ */
+class AliasTable
+{
+ public:
+  //! Construct an empty alias table.
+  AliasTable() { }
+
+  /**
+   * Construct the alias table for the distribution proportional to the given
+   * non-negative weights.
+   *
+   * @param weights Unnormalized probabilities.
+   */
+  AliasTable(const arma::vec& weights) { Reset(weights); }
+
+  /**
+   * Rebuild the alias table for the distribution proportional to the given
+   * non-negative weights.
+   *
+   * @param weights Unnormalized probabilities.
+   */
+  void Reset(const arma::vec& weights);
+
+  //! Draw one index from the distribution.
+  size_t Sample() const;
+
+  //! Return the probability of the given index.
+  double Probability(const size_t i) const { return probabilities[i]; }
+
+  //! Return the normalized probabilities.
+  const arma::vec& Probabilities() const { return probabilities; }
+
+ private:
+  //! The normalized probabilities.
+  arma::vec probabilities;
+
+  //! The probability of keeping each bucket's own index.
+  arma::vec threshold;
+
+  //! The alias of each bucket.
+  arma::uvec alias;
+};
+
+/**
+ * The sampled softmax objective of a linear softmax classifier.  The
+ * parameters are a numClasses x numFeatures matrix whose rows are the class
+ * weights.  For each call, numSampled classes S are drawn (with replacement)
+ * from a proposal distribution Q through an alias table; the loss of a point
+ * x with label y is then the cross-entropy over the candidates {y} and S,
+ *
+ *   l(x, y) = -o_y + log(exp(o_y) + sum_{c in S} exp(o_c)),
+ *
+ * with the corrected logits o_c = w_c' x - log(numSampled * Q(c)), and with
+ * sampled classes equal to y removed ("accidental hits").  The log(Q)
+ * correction makes the sampled loss a consistent estimate of the full softmax
+ * loss.
+ *
+ * Both the objective and the gradient only touch the rows of the true classes
+ * of the batch and of the sampled classes, so a call costs
+ * O((batchSize + numSampled) * numFeatures) instead of
+ * O(numClasses * numFeatures).  The gradient is assembled as a row-sparse
+ * matrix; use arma::sp_mat as the gradient type (for instance with
+ * ParallelSGD, or SGD::Optimize<SampledSoftmaxFunction, arma::mat,
+ * arma::sp_mat>()) to keep the updates sparse.  The L2 penalty is applied
+ * lazily, to the touched rows only.
+ *
+ * The same sample of classes is shared by all points of a batch, and it is
+ * drawn anew at every call; the sampled objective is therefore stochastic.
+ * This includes Evaluate(parameters), which optimizers like ParallelSGD call
+ * at every iteration: it returns a sampled estimate of the objective over all
+ * the points, in O(numPoints * numSampled * numFeatures) time.
+ * ExactEvaluate(parameters) computes the exact, full softmax objective, which
+ * costs O(numPoints * numClasses * numFeatures), for monitoring.
+ */
+class SampledSoftmaxFunction
+{
+ public:
+  /**
+   * Construct the sampled softmax function.
+   *
+   * @param data Input data, each column is one point.
+   * @param labels Labels of the points, in [0, numClasses).
+   * @param numClasses Number of classes.
+   * @param numSampled Number of classes to sample for each call.
+   * @param lambda L2-regularization constant.
+   * @param classWeights Unnormalized proposal distribution over the classes;
+   *     if empty, the smoothed label frequencies (count + 1) are used.
+   */
+  SampledSoftmaxFunction(const arma::mat& data,
+                         const arma::Row<size_t>& labels,
+                         const size_t numClasses,
+                         const size_t numSampled = 64,
+                         const double lambda = 0.0001,
+                         const arma::vec& classWeights = arma::vec());
+
+  //! Shuffle the order of the points.
+  void Shuffle();
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return data.n_cols; }
+
+  /**
+   * Evaluate a sampled estimate of the objective over all the points (plus
+   * the full L2 penalty).  The points are processed in blocks, each with its
+   * own sample of classes.
+   *
+   * @param parameters Current values of the model parameters.
+   */
+  double Evaluate(const arma::mat& parameters) const;
+
+  /**
+   * Evaluate the exact softmax objective (mean negative log-likelihood over
+   * all points and all classes, plus the full L2 penalty).  This costs
+   * O(numClasses * numFeatures) per point and is meant for monitoring.
+   *
+   * @param parameters Current values of the model parameters.
+   */
+  double ExactEvaluate(const arma::mat& parameters) const;
+
+  /**
+   * Evaluate the sampled objective on the given points.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin First index of the points to use.
+   * @param batchSize Number of points to use.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the sampled objective on the given points.
+   *
+   * @tparam GradType Type of the gradient (arma::mat or arma::sp_mat).
+   * @param parameters Current values of the model parameters.
+   * @param begin First index of the points to use.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of points to use.
+   */
+  template<typename GradType>
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the sampled objective and its gradient on the given points, with
+   * the same sample of classes.
+   *
+   * @tparam GradType Type of the gradient (arma::mat or arma::sp_mat).
+   * @param parameters Current values of the model parameters.
+   * @param begin First index of the points to use.
+   * @param gradient Matrix to store the gradient into.
+   * @param batchSize Number of points to use.
+   */
+  template<typename GradType>
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              GradType& gradient,
+                              const size_t batchSize = 1) const;
+
+  /**
+   * Predict the class of each of the given points (the arg max of the
+   * logits over all classes).
+   *
+   * @param data Points to classify.
+   * @param parameters Model parameters.
+   * @param predictions Vector to store the predicted classes into.
+   */
+  void Classify(const arma::mat& data,
+                const arma::mat& parameters,
+                arma::Row<size_t>& predictions) const;
+
+  //! Return the initial point for the optimization.
+  const arma::mat& GetInitialPoint() const { return initialPoint; }
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the number of sampled classes.
+  size_t NumSampled() const { return numSampled; }
+  //! Modify the number of sampled classes.
+  size_t& NumSampled() { return numSampled; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the class sampler.
+  const AliasTable& Sampler() const { return sampler; }
+
+ private:
+  /**
+   * Compute the sampled objective on the given points, and if gradient is not
+   * NULL, its gradient.  If penalize is false, the L2 penalty is left out
+   * (only when gradient is NULL).
+   */
+  template<typename GradType>
+  double Compute(const arma::mat& parameters,
+                 const size_t begin,
+                 const size_t batchSize,
+                 GradType* gradient,
+                 const bool penalize = true) const;
+
+  //! The data.
+  arma::mat data;
+  //! The labels of the points.
+  arma::Row<size_t> labels;
+  //! The number of classes.
+  size_t numClasses;
+  //! The number of sampled classes.
+  size_t numSampled;
+  //! The L2-regularization constant.
+  double lambda;
+  //! The proposal distribution over the classes.
+  AliasTable sampler;
+  //! The initial point.
+  arma::mat initialPoint;
+};
+
+} // namespace test
+} // namespace ens
+
+// Include implementation.
+#include "sampled_softmax_function_impl.hpp"
+
+#endif // ENSMALLEN_PROBLEMS_SAMPLED_SOFTMAX_FUNCTION_HPP
@@ -0,0 +1,325 @@
+/**
+ * @file sampled_softmax_function_impl.hpp
+ *
+ * Implementation of the sampled softmax function and of the alias table.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_SAMPLED_SOFTMAX_FUNCTION_IMPL_HPP
+#define ENSMALLEN_PROBLEMS_SAMPLED_SOFTMAX_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sampled_softmax_function.hpp"
+
+namespace ens {
+namespace test {
+
+inline void AliasTable::Reset(const arma::vec& weights)
+{
+  const size_t n = weights.n_elem;
+  if (n == 0 || arma::accu(weights) <= 0.0 || arma::any(weights < 0.0))
+  {
+    throw std::invalid_argument("AliasTable::Reset(): the weights must be "
+        "non-negative and have a positive sum");
+  }
+
+  probabilities = weights / arma::accu(weights);
+  threshold.set_size(n);
+  alias.set_size(n);
+
+  // Split the buckets into those with less and more than the average mass,
+  // and fill each light bucket up with mass from a heavy one.
+  arma::vec scaled = probabilities * n;
+  std::vector<size_t> light, heavy;
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (scaled[i] < 1.0)
+      light.push_back(i);
+    else
+      heavy.push_back(i);
+  }
+
+  while (!light.empty() && !heavy.empty())
+  {
+    const size_t l = light.back();
+    light.pop_back();
+    const size_t h = heavy.back();
+
+    threshold[l] = scaled[l];
+    alias[l] = h;
+    scaled[h] -= 1.0 - scaled[l];
+    if (scaled[h] < 1.0)
+    {
+      heavy.pop_back();
+      light.push_back(h);
+    }
+  }
+
+  // The remaining buckets are full (up to rounding errors).
+  for (size_t i = 0; i < heavy.size(); ++i)
+  {
+    threshold[heavy[i]] = 1.0;
+    alias[heavy[i]] = heavy[i];
+  }
+  for (size_t i = 0; i < light.size(); ++i)
+  {
+    threshold[light[i]] = 1.0;
+    alias[light[i]] = light[i];
+  }
+}
+
+inline size_t AliasTable::Sample() const
+{
+  const size_t n = threshold.n_elem;
+  const size_t i = std::min((size_t) (arma::randu() * n), n - 1);
+  return (arma::randu() < threshold[i]) ? i : alias[i];
+}
+
+inline SampledSoftmaxFunction::SampledSoftmaxFunction(
+    const arma::mat& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numSampled,
+    const double lambda,
+    const arma::vec& classWeights) :
+    data(data),
+    labels(labels),
+    numClasses(numClasses),
+    numSampled(numSampled),
+    lambda(lambda)
+{
+  if (labels.n_elem != data.n_cols)
+  {
+    throw std::invalid_argument("SampledSoftmaxFunction: the number of labels "
+        "must match the number of points");
+  }
+
+  if (numSampled == 0)
+  {
+    throw std::invalid_argument("SampledSoftmaxFunction: numSampled must be "
+        "positive");
+  }
+
+  if (classWeights.is_empty())
+  {
+    // Smoothed label frequencies.
+    arma::vec counts(numClasses, arma::fill::ones);
+    for (size_t i = 0; i < labels.n_elem; ++i)
+      counts[labels[i]] += 1.0;
+    sampler.Reset(counts);
+  }
+  else if (classWeights.n_elem != numClasses)
+  {
+    throw std::invalid_argument("SampledSoftmaxFunction: classWeights must "
+        "have one element per class");
+  }
+  else
+  {
+    sampler.Reset(classWeights);
+  }
+
+  // Small random weights, so that the classes are not all the same.
+  initialPoint.randn(numClasses, data.n_rows);
+  initialPoint *= 0.005;
+}
+
+inline void SampledSoftmaxFunction::Shuffle()
+{
+  const arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      data.n_cols - 1, data.n_cols));
+
+  data = data.cols(ordering).eval();
+  labels = labels.cols(ordering).eval();
+}
+
+inline double SampledSoftmaxFunction::Evaluate(
+    const arma::mat& parameters) const
+{
+  // Sum the sampled losses of blocks of points, each with its own sample of
+  // classes, so that no block of the data is copied at once.
+  const size_t blockSize = 1024;
+  double objective = 0.0;
+  for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
+  {
+    const size_t batchSize = std::min(blockSize, (size_t) data.n_cols - begin);
+    objective += batchSize * Compute<arma::sp_mat>(parameters, begin,
+        batchSize, NULL, false);
+  }
+
+  return objective / data.n_cols + 0.5 * lambda *
+      arma::accu(arma::square(parameters));
+}
+
+inline double SampledSoftmaxFunction::ExactEvaluate(
+    const arma::mat& parameters) const
+{
+  const arma::mat logits = parameters * data;
+
+  double objective = 0.0;
+  for (size_t j = 0; j < data.n_cols; ++j)
+  {
+    // Numerically stable log-sum-exp.
+    const double maxLogit = logits.col(j).max();
+    objective += maxLogit + std::log(arma::accu(arma::exp(logits.col(j) -
+        maxLogit))) - logits(labels[j], j);
+  }
+
+  return objective / data.n_cols + 0.5 * lambda *
+      arma::accu(arma::square(parameters));
+}
+
+inline double SampledSoftmaxFunction::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  return Compute<arma::sp_mat>(parameters, begin, batchSize, NULL);
+}
+
+template<typename GradType>
+inline void SampledSoftmaxFunction::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  Compute(parameters, begin, batchSize, &gradient);
+}
+
+template<typename GradType>
+inline double SampledSoftmaxFunction::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  return Compute(parameters, begin, batchSize, &gradient);
+}
+
+inline void SampledSoftmaxFunction::Classify(
+    const arma::mat& data,
+    const arma::mat& parameters,
+    arma::Row<size_t>& predictions) const
+{
+  const arma::mat logits = parameters * data;
+
+  predictions.set_size(data.n_cols);
+  for (size_t j = 0; j < data.n_cols; ++j)
+    predictions[j] = logits.col(j).index_max();
+}
+
+template<typename GradType>
+inline double SampledSoftmaxFunction::Compute(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize,
+    GradType* gradient,
+    const bool penalize) const
+{
+  const size_t k = numSampled;
+
+  // Draw the classes shared by the whole batch, and their log(Q) corrections.
+  arma::uvec sampled(k);
+  arma::vec sampledCorrection(k);
+  for (size_t s = 0; s < k; ++s)
+  {
+    sampled[s] = sampler.Sample();
+    sampledCorrection[s] = std::log(k * sampler.Probability(sampled[s]));
+  }
+
+  const arma::mat x = data.cols(begin, begin + batchSize - 1);
+  arma::mat logits = parameters.rows(sampled) * x;
+  logits.each_col() -= sampledCorrection;
+
+  // coefficients(s, j) is the derivative of the loss of point j with respect
+  // to the logit of sampled class s; trueCoefficients(j) is the one of the
+  // true class.
+  arma::mat coefficients(k, batchSize);
+  arma::rowvec trueCoefficients(batchSize);
+  double objective = 0.0;
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const size_t y = labels[begin + j];
+    const double trueLogit = arma::as_scalar(parameters.row(y) * x.col(j)) -
+        std::log(k * sampler.Probability(y));
+
+    // Sampled classes equal to the true class are left out.
+    double maxLogit = trueLogit;
+    for (size_t s = 0; s < k; ++s)
+    {
+      if (sampled[s] != y)
+        maxLogit = std::max(maxLogit, logits(s, j));
+    }
+
+    const double trueExp = std::exp(trueLogit - maxLogit);
+    double sum = trueExp;
+    for (size_t s = 0; s < k; ++s)
+    {
+      coefficients(s, j) = (sampled[s] == y) ? 0.0 :
+          std::exp(logits(s, j) - maxLogit);
+      sum += coefficients(s, j);
+    }
+
+    objective += maxLogit + std::log(sum) - trueLogit;
+    coefficients.col(j) /= sum;
+    trueCoefficients[j] = trueExp / sum - 1.0;
+  }
+  objective /= batchSize;
+
+  if (!penalize)
+    return objective;
+
+  // The L2 penalty is only applied to the touched rows.
+  const arma::uvec trueClasses = arma::conv_to<arma::uvec>::from(
+      labels.subvec(begin, begin + batchSize - 1));
+  const arma::uvec touched = arma::unique(arma::join_cols(sampled,
+      trueClasses));
+  objective += 0.5 * lambda * arma::accu(arma::square(
+      parameters.rows(touched)));
+
+  if (gradient == NULL)
+    return objective;
+
+  // Assemble the row-sparse gradient; duplicate locations are summed.
+  const size_t d = parameters.n_cols;
+  const arma::mat sampledGradient = coefficients * x.t() / batchSize;
+  const size_t n = (k + batchSize + touched.n_elem) * d;
+  arma::umat locations(2, n);
+  arma::vec values(n);
+  size_t e = 0;
+  for (size_t c = 0; c < d; ++c)
+  {
+    for (size_t s = 0; s < k; ++s, ++e)
+    {
+      locations(0, e) = sampled[s];
+      locations(1, e) = c;
+      values[e] = sampledGradient(s, c);
+    }
+
+    for (size_t j = 0; j < batchSize; ++j, ++e)
+    {
+      locations(0, e) = trueClasses[j];
+      locations(1, e) = c;
+      values[e] = trueCoefficients[j] * x(c, j) / batchSize;
+    }
+
+    for (size_t t = 0; t < touched.n_elem; ++t, ++e)
+    {
+      locations(0, e) = touched[t];
+      locations(1, e) = c;
+      values[e] = lambda * parameters(touched[t], c);
+    }
+  }
+
+  *gradient = arma::sp_mat(true, locations, values, numClasses, d);
+
+  return objective;
+}
+
+} // namespace test
+} // namespace ens
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file schaffer_function_n1.hpp
+ *
+ * Definition of Schaffer function N.1, a multi-objective test problem.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_SCHAFFER_FUNCTION_N1_HPP
+#define ENSMALLEN_PROBLEMS_SCHAFFER_FUNCTION_N1_HPP
+
+namespace ens {
+namespace test {
+
+/**
+ * The Schaffer function N.1, a multi-objective function of one variable with
+ * the two objectives
+ *
+ * \f[
+ * f_1(x) = x^2, \quad f_2(x) = (x - 2)^2.
+ * \f]
+ *
+ * The Pareto optimal set is 0 <= x <= 2, and the Pareto front is the curve
+ * sqrt(f_1) + sqrt(f_2) = 2.
+ *
+ * For more information, please refer to:
+ *
+ * @code
+ * @inproceedings{Schaffer1985,
+ *   author    = {Schaffer, J. David},
+ *   title     = {Multiple Objective Optimization with Vector Evaluated
+ *                Genetic Algorithms},
+ *   booktitle = {Proceedings of the 1st International Conference on Genetic
+ *                Algorithms},
+ *   pages     = {93--100},
+ *   year      = {1985}
+ * }
+ * @endcode
+ */
+class SchafferFunctionN1
+{
+ public:
+  //! Initialize the SchafferFunctionN1.
+  SchafferFunctionN1();
+
+  //! Return 2 (the number of objectives).
+  size_t NumObjectives() const { return 2; }
+
+  //! Get the starting point.
+  template<typename MatType = arma::mat>
+  MatType GetInitialPoint() const { return MatType("10"); }
+
+  /**
+   * Evaluate both objectives with the given coordinates.
+   *
+   * @param coordinates The function coordinates.
+   * @return The value of each objective.
+   */
+  template<typename MatType>
+  arma::Col<typename MatType::elem_type> Evaluate(
+      const MatType& coordinates) const;
+};
+
+} // namespace test
+} // namespace ens
+
+// Include implementation.
+#include "schaffer_function_n1_impl.hpp"
+
+#endif // ENSMALLEN_PROBLEMS_SCHAFFER_FUNCTION_N1_HPP
@@ -0,0 +1,40 @@
+/**
+ * @file schaffer_function_n1_impl.hpp
+ *
+ * Implementation of Schaffer function N.1.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PROBLEMS_SCHAFFER_FUNCTION_N1_IMPL_HPP
+#define ENSMALLEN_PROBLEMS_SCHAFFER_FUNCTION_N1_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "schaffer_function_n1.hpp"
+
+namespace ens {
+namespace test {
+
+inline SchafferFunctionN1::SchafferFunctionN1() { /* Nothing to do here */ }
+
+template<typename MatType>
+arma::Col<typename MatType::elem_type> SchafferFunctionN1::Evaluate(
+    const MatType& coordinates) const
+{
+  // Convenience typedef.
+  typedef typename MatType::elem_type ElemType;
+
+  const ElemType x = coordinates(0);
+
+  arma::Col<ElemType> objectives(2);
+  objectives(0) = std::pow(x, 2);
+  objectives(1) = std::pow(x - 2, 2);
+  return objectives;
+}
+
+} // namespace test
+} // namespace ens
+
+#endif
@@ -14,6 +14,8 @@
 #define ENSMALLEN_PSO_PSO_HPP
 
 #include "update_policies/lbest_update.hpp"
+#include "update_policies/gbest_update.hpp"
+#include "update_policies/von_neumann_update.hpp"
 #include "init_policies/default_init.hpp"
 
 namespace ens {
@@ -259,6 +261,8 @@ class PSOType
 };
 
 using LBestPSO = PSOType<LBestUpdate>;
+using GBestPSO = PSOType<GBestUpdate>;
+using VonNeumannPSO = PSOType<VonNeumannUpdate>;
 } // ens
 
 #include "pso_impl.hpp"
@@ -0,0 +1,143 @@
+/**
+ * @file gbest_update.hpp
+ *
+ * Implementation of the gbest update policy for particle swarm optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PSO_UPDATE_POLICIES_GBEST_UPDATE_HPP
+#define ENSMALLEN_PSO_UPDATE_POLICIES_GBEST_UPDATE_HPP
+
+#include "swarm_velocity_update.hpp"
+
+namespace ens {
+
+/**
+ * The global best version (gbest) of PSO in which every particle communicates
+ * with the whole swarm, thus forming a star topology amongst them.  This
+ * approach usually converges in fewer iterations than lbest PSO, but is more
+ * likely to converge to a local minimum.
+ *
+ * The gbest update scheme is described as follows:
+ *
+ * \f{equation}{
+ * v_{i+1} = \phi (v_i + c_1 * r_1 * (p_{best} - p_{current}) +
+ *           c_2 * r_2 * (g_{best} - p_{current}))
+ * \f}
+ *
+ * where \f$ g_{best} \f$ is the best position found by any particle of the
+ * swarm, and the other symbols are as for ens::LBestUpdate.
+ *
+ * For more information, refer the following:
+ *
+ * @code
+ * @article{Poli2007,
+ *   author    = {Riccardo Poli and James Kennedy and Tim Blackwell},
+ *   title     = {Particle swarm optimization},
+ *   year      = {2007},
+ *   month     = aug,
+ *   publisher = {Springer},
+ *   volume    = {1},
+ *   number    = {1},
+ *   pages     = {33--57},
+ *   journal   = {Swarm Intelligence}
+ * }
+ * @endcode
+ */
+class GBestUpdate
+{
+ public:
+  /**
+   * Construct the gbest update policy.
+   *
+   * @param maxVelocity Maximum absolute value of each velocity component (0
+   *     means no clamping).
+   */
+  GBestUpdate(const double maxVelocity = 0.0) : maxVelocity(maxVelocity)
+  { /* Do nothing. */ }
+
+  //! Get the maximum velocity component (0 means no clamping).
+  double MaxVelocity() const { return maxVelocity; }
+  //! Modify the maximum velocity component (0 means no clamping).
+  double& MaxVelocity() { return maxVelocity; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType.  This is
+   * instantiated at the start of the optimization, and holds parameters
+   * specific to an individual optimization.
+   */
+  template<typename MatType>
+  class Policy
+  {
+   public:
+    /**
+     * This is called by the optimizer method before the start of the iteration
+     * update process.
+     *
+     * @param parent Instantiated parent class.
+     */
+    Policy(const GBestUpdate& parent) : parent(parent) { /* Do nothing. */ }
+
+    /**
+     * The Initialize method is called by PSO Optimizer method before the
+     * start of the iteration process.
+     *
+     * @param exploitationFactor Influence of personal best achieved.
+     * @param explorationFactor Influence of the best particle of the swarm.
+     * @param numParticles The number of particles in the swarm.
+     * @param iterate The user input.
+     */
+    void Initialize(const double exploitationFactor,
+                    const double explorationFactor,
+                    const size_t numParticles,
+                    MatType& /* iterate */)
+    {
+      velocityUpdate.Initialize(exploitationFactor, explorationFactor,
+          parent.MaxVelocity());
+      globalBestIndices.zeros(numParticles);
+    }
+
+    /**
+     * Update step for GBestPSO.  Finds the particle with the best personal
+     * best fitness and uses it as the neighbour of every particle.
+     *
+     * @param particlePositions The current coordinates of particles.
+     * @param particleVelocities The current velocities (will be modified).
+     * @param particleBestPositions The personal best coordinates of particles.
+     * @param particleBestFitnesses The personal best fitness values of
+     *     particles.
+     */
+    void Update(arma::Cube<typename MatType::elem_type>& particlePositions,
+                arma::Cube<typename MatType::elem_type>& particleVelocities,
+                arma::Cube<typename MatType::elem_type>& particleBestPositions,
+                arma::Col<typename MatType::elem_type>& particleBestFitnesses)
+    {
+      globalBestIndices.fill(particleBestFitnesses.index_min());
+
+      velocityUpdate.Update(particlePositions, particleVelocities,
+          particleBestPositions, globalBestIndices);
+    }
+
+   private:
+    //! Instantiated parent class.
+    const GBestUpdate& parent;
+
+    //! The velocity update of the whole swarm.
+    SwarmVelocityUpdate<typename MatType::elem_type> velocityUpdate;
+
+    //! Index of the best particle, for each particle.
+    arma::uvec globalBestIndices;
+  };
+
+ private:
+  //! The maximum velocity component.
+  double maxVelocity;
+};
+
+} // namespace ens
+
+#endif
@@ -12,7 +12,8 @@
  */
 #ifndef ENSMALLEN_PSO_UPDATE_POLICIES_LBEST_UPDATE_HPP
 #define ENSMALLEN_PSO_UPDATE_POLICIES_LBEST_UPDATE_HPP
-#include <assert.h>
+
+#include "swarm_velocity_update.hpp"
 
 namespace ens {
 
@@ -26,7 +27,7 @@ namespace ens {
  *
  * \f{eqation}{
  * v_{i+1} = \phi (v_i + c_1 * r_1 * (p_{best} - p_{current}) +
- *           c_1 * r_1 * (l_{best} - p_{current}))
+ *           c_2 * r_2 * (l_{best} - p_{current}))
  * \f}
  *
  * where \f$ v_i \f$ is the velocity of a particle in iteration \f$ i \f$,
@@ -57,6 +58,20 @@ namespace ens {
 class LBestUpdate
 {
  public:
+  /**
+   * Construct the lbest update policy.
+   *
+   * @param maxVelocity Maximum absolute value of each velocity component (0
+   *     means no clamping).
+   */
+  LBestUpdate(const double maxVelocity = 0.0) : maxVelocity(maxVelocity)
+  { /* Do nothing. */ }
+
+  //! Get the maximum velocity component (0 means no clamping).
+  double MaxVelocity() const { return maxVelocity; }
+  //! Modify the maximum velocity component (0 means no clamping).
+  double& MaxVelocity() { return maxVelocity; }
+
   /**
    * The UpdatePolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType.  This is
@@ -73,13 +88,13 @@ class LBestUpdate
      *
      * @param parent Instantiated parent class.
      */
-     Policy(const LBestUpdate& /* parent */) { /* Do nothing. */ }
+     Policy(const LBestUpdate& parent) : parent(parent) { /* Do nothing. */ }
 
      /**
       * The Initialize method is called by PSO Optimizer method before the
       * start of the iteration process. It calculates the value of the
-      * constriction coefficent, initializes the local best indices of each
-      * particle to itself, and sets the shape of the r1 and r2 vectors.
+      * constriction coefficent and initializes the local best indices of each
+      * particle to itself.
       *
       * @param exploitationFactor Influence of personal best achieved.
       * @param explorationFactor Influence of neighbouring particles.
@@ -89,38 +104,24 @@ class LBestUpdate
      void Initialize(const double exploitationFactor,
                      const double explorationFactor,
                      const size_t numParticles,
-                     MatType& iterate)
+                     MatType& /* iterate */)
      {
-       // Copy values to aliases.
        n = numParticles;
-       c1 = exploitationFactor;
-       c2 = explorationFactor;
-
-       // Calculate the constriction factor
-       static double phi = c1 + c2;
-       assert(phi > 4.0 && "The sum of the exploitation and exploration "
-           "factors must be greater than 4.");
-
-       chi = 2.0 / std::abs(2.0 - phi - std::sqrt((phi - 4.0) * phi));
+       velocityUpdate.Initialize(exploitationFactor, explorationFactor,
+           parent.MaxVelocity());
 
        // Initialize local best indices to self indices of particles.
-       localBestIndices = arma::linspace<
-           arma::Col<typename MatType::elem_type> >(0, n-1, n);
-
-       // Set sizes r1 and r2.
-       r1.set_size(iterate.n_rows, iterate.n_cols);
-       r2.set_size(iterate.n_rows, iterate.n_cols);
+       localBestIndices = arma::regspace<arma::uvec>(0, n - 1);
      }
 
      /**
       * Update step for LBestPSO. Compares personal best of each particle with
-      * that of its neighbours, and sets the best of the 3 as the lobal best.
+      * that of its neighbours, and sets the best of the 3 as the local best.
       * This particle is then used for calculating the velocity for the update
       * step.
       *
       * @param particlePositions The current coordinates of particles.
       * @param particleVelocities The current velocities (will be modified).
-      * @param particleFitnesses The current fitness values or particles.
       * @param particleBestPositions The personal best coordinates of particles.
       * @param particleBestFitnesses The personal best fitness values of
       *     particles.
@@ -130,53 +131,41 @@ class LBestUpdate
                  arma::Cube<typename MatType::elem_type>& particleBestPositions,
                  arma::Col<typename MatType::elem_type>& particleBestFitnesses)
      {
-       // Velocity update logic.
        for (size_t i = 0; i < n; i++)
        {
-         localBestIndices(i) =
-             particleBestFitnesses(left(i)) < particleBestFitnesses(i) ?
-             left(i) : i;
-         localBestIndices(i) =
-             particleBestFitnesses(right(i)) < particleBestFitnesses(i) ?
-             right(i) : i;
+         size_t best = i;
+         if (particleBestFitnesses(left(i)) < particleBestFitnesses(best))
+           best = left(i);
+         if (particleBestFitnesses(right(i)) < particleBestFitnesses(best))
+           best = right(i);
+         localBestIndices(i) = best;
        }
 
-       for (size_t i = 0; i < n; i++)
-       {
-         // Generate random numbers for current particle.
-         r1.randu();
-         r2.randu();
-         particleVelocities.slice(i) = chi * (particleVelocities.slice(i) +
-             c1 * r1 % (particleBestPositions.slice(i) -
-             particlePositions.slice(i)) + c2 * r2 %
-             (particleBestPositions.slice(localBestIndices(i)) -
-             particlePositions.slice(i)));
-       }
+       velocityUpdate.Update(particlePositions, particleVelocities,
+           particleBestPositions, localBestIndices);
      }
 
     private:
+     //! Instantiated parent class.
+     const LBestUpdate& parent;
+
      //! Number of particles.
      size_t n;
 
-     //! Exploitation factor.
-     typename MatType::elem_type c1;
-
-     //! Exploration factor.
-     typename MatType::elem_type c2;
-
-     //! Constriction factor chi.
-     typename MatType::elem_type chi;
-
-     //! Vectors of random numbers.
-     MatType r1, r2;
+     //! The velocity update of the whole swarm.
+     SwarmVelocityUpdate<typename MatType::elem_type> velocityUpdate;
 
      //! Indices of each particle's best neighbour.
-     arma::Col<typename MatType::elem_type> localBestIndices;
+     arma::uvec localBestIndices;
 
      // Helper functions for calculating neighbours.
     inline size_t left(size_t index) { return (index + n - 1) % n; }
     inline size_t right(size_t index) { return (index + 1) % n; }
   };
+
+ private:
+  //! The maximum velocity component.
+  double maxVelocity;
 };
 
 } // ens
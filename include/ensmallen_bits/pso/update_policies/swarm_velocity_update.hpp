@@ -0,0 +1,120 @@
+/**
+ * @file swarm_velocity_update.hpp
+ *
+ * Velocity update of a whole particle swarm, shared by the PSO update
+ * policies.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PSO_UPDATE_POLICIES_SWARM_VELOCITY_UPDATE_HPP
+#define ENSMALLEN_PSO_UPDATE_POLICIES_SWARM_VELOCITY_UPDATE_HPP
+#include <assert.h>
+
+namespace ens {
+
+/**
+ * SwarmVelocityUpdate performs the constricted velocity update
+ *
+ * \f{equation}{
+ * v_{i+1} = \chi (v_i + c_1 r_1 (p_{best} - p_{current}) +
+ *           c_2 r_2 (n_{best} - p_{current}))
+ * \f}
+ *
+ * for every particle of the swarm, where \f$ n_{best} \f$ is the personal best
+ * position of the best neighbour of the particle, as given by the topology of
+ * the calling update policy.  The random coefficients of all particles are
+ * drawn at once, and all velocities are updated (and optionally clamped to
+ * [-maxVelocity, maxVelocity]) in a single pass over the swarm.
+ *
+ * @tparam ElemType Element type of the particle coordinates.
+ */
+template<typename ElemType>
+class SwarmVelocityUpdate
+{
+ public:
+  /**
+   * Compute the constriction factor and set the size of the swarm.
+   *
+   * @param exploitationFactor Influence of personal best achieved.
+   * @param explorationFactor Influence of neighbouring particles.
+   * @param maxVelocity Maximum absolute value of each velocity component (0
+   *     means no clamping).
+   */
+  void Initialize(const double exploitationFactor,
+                  const double explorationFactor,
+                  const double maxVelocity)
+  {
+    c1 = ElemType(exploitationFactor);
+    c2 = ElemType(explorationFactor);
+    vMax = ElemType(maxVelocity);
+
+    // Calculate the constriction factor.
+    const double phi = exploitationFactor + explorationFactor;
+    assert(phi > 4.0 && "The sum of the exploitation and exploration "
+        "factors must be greater than 4.");
+
+    chi = ElemType(2.0 / std::abs(2.0 - phi - std::sqrt((phi - 4.0) * phi)));
+  }
+
+  /**
+   * Update the velocities of all particles.
+   *
+   * @param particlePositions The current coordinates of particles.
+   * @param particleVelocities The current velocities (will be modified).
+   * @param particleBestPositions The personal best coordinates of particles.
+   * @param neighbourBest Index of the best neighbour of each particle.
+   */
+  void Update(const arma::Cube<ElemType>& particlePositions,
+              arma::Cube<ElemType>& particleVelocities,
+              const arma::Cube<ElemType>& particleBestPositions,
+              const arma::uvec& neighbourBest)
+  {
+    const size_t d = particlePositions.n_rows * particlePositions.n_cols;
+    const size_t n = particlePositions.n_slices;
+
+    // Draw r_1 and r_2 for all particles at once; the storage is reused
+    // between iterations.
+    randoms.randu(2 * d, n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType* x = particlePositions.slice_memptr(i);
+      const ElemType* p = particleBestPositions.slice_memptr(i);
+      const ElemType* l = particleBestPositions.slice_memptr(neighbourBest(i));
+      const ElemType* r1 = randoms.colptr(i);
+      const ElemType* r2 = r1 + d;
+      ElemType* v = particleVelocities.slice_memptr(i);
+
+      for (size_t j = 0; j < d; ++j)
+      {
+        const ElemType vj = chi * (v[j] + c1 * r1[j] * (p[j] - x[j]) +
+            c2 * r2[j] * (l[j] - x[j]));
+        v[j] = (vMax > 0) ? std::min(std::max(vj, -vMax), vMax) : vj;
+      }
+    }
+  }
+
+ private:
+  //! Exploitation factor.
+  ElemType c1;
+
+  //! Exploration factor.
+  ElemType c2;
+
+  //! Constriction factor chi.
+  ElemType chi;
+
+  //! Maximum absolute velocity component (0 means no clamping).
+  ElemType vMax;
+
+  //! Random coefficients r_1 and r_2 of all particles, one column per
+  //! particle.
+  arma::Mat<ElemType> randoms;
+};
+
+} // namespace ens
+
+#endif
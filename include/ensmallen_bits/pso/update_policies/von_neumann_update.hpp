@@ -0,0 +1,164 @@
+/**
+ * @file von_neumann_update.hpp
+ *
+ * Implementation of the von Neumann update policy for particle swarm
+ * optimization.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_PSO_UPDATE_POLICIES_VON_NEUMANN_UPDATE_HPP
+#define ENSMALLEN_PSO_UPDATE_POLICIES_VON_NEUMANN_UPDATE_HPP
+
+#include "swarm_velocity_update.hpp"
+
+namespace ens {
+
+/**
+ * The von Neumann version of PSO, in which the particles are laid out on a
+ * two-dimensional torus and each particle communicates with its four
+ * neighbours (above, below, left and right).  Information spreads faster than
+ * in the ring topology of lbest PSO but slower than in the star topology of
+ * gbest PSO, which is often a good compromise between the two.
+ *
+ * With c columns in the grid (c is the rounded square root of the number of
+ * particles n), the neighbours of particle i are i - 1, i + 1, i - c and
+ * i + c, modulo n.  The velocity update is the same as for ens::LBestUpdate,
+ * with the best of the particle and its four neighbours as the local best.
+ *
+ * For more information, refer the following:
+ *
+ * @code
+ * @inproceedings{Kennedy2002,
+ *   author    = {Kennedy, James and Mendes, Rui},
+ *   title     = {Population structure and particle swarm performance},
+ *   booktitle = {Proceedings of the 2002 Congress on Evolutionary
+ *                Computation},
+ *   pages     = {1671--1676},
+ *   year      = {2002}
+ * }
+ * @endcode
+ */
+class VonNeumannUpdate
+{
+ public:
+  /**
+   * Construct the von Neumann update policy.
+   *
+   * @param maxVelocity Maximum absolute value of each velocity component (0
+   *     means no clamping).
+   */
+  VonNeumannUpdate(const double maxVelocity = 0.0) : maxVelocity(maxVelocity)
+  { /* Do nothing. */ }
+
+  //! Get the maximum velocity component (0 means no clamping).
+  double MaxVelocity() const { return maxVelocity; }
+  //! Modify the maximum velocity component (0 means no clamping).
+  double& MaxVelocity() { return maxVelocity; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType.  This is
+   * instantiated at the start of the optimization, and holds parameters
+   * specific to an individual optimization.
+   */
+  template<typename MatType>
+  class Policy
+  {
+   public:
+    /**
+     * This is called by the optimizer method before the start of the iteration
+     * update process.
+     *
+     * @param parent Instantiated parent class.
+     */
+    Policy(const VonNeumannUpdate& parent) : parent(parent)
+    { /* Do nothing. */ }
+
+    /**
+     * The Initialize method is called by PSO Optimizer method before the
+     * start of the iteration process.  It lays the particles out on the grid.
+     *
+     * @param exploitationFactor Influence of personal best achieved.
+     * @param explorationFactor Influence of neighbouring particles.
+     * @param numParticles The number of particles in the swarm.
+     * @param iterate The user input.
+     */
+    void Initialize(const double exploitationFactor,
+                    const double explorationFactor,
+                    const size_t numParticles,
+                    MatType& /* iterate */)
+    {
+      n = numParticles;
+      columns = std::max<size_t>(1,
+          (size_t) std::round(std::sqrt((double) n)));
+      velocityUpdate.Initialize(exploitationFactor, explorationFactor,
+          parent.MaxVelocity());
+
+      // Initialize local best indices to self indices of particles.
+      localBestIndices = arma::regspace<arma::uvec>(0, n - 1);
+    }
+
+    /**
+     * Update step for von Neumann PSO.  Compares the personal best of each
+     * particle with that of its four neighbours and uses the best of them for
+     * the velocity update.
+     *
+     * @param particlePositions The current coordinates of particles.
+     * @param particleVelocities The current velocities (will be modified).
+     * @param particleBestPositions The personal best coordinates of particles.
+     * @param particleBestFitnesses The personal best fitness values of
+     *     particles.
+     */
+    void Update(arma::Cube<typename MatType::elem_type>& particlePositions,
+                arma::Cube<typename MatType::elem_type>& particleVelocities,
+                arma::Cube<typename MatType::elem_type>& particleBestPositions,
+                arma::Col<typename MatType::elem_type>& particleBestFitnesses)
+    {
+      const size_t step = columns % n;
+      for (size_t i = 0; i < n; i++)
+      {
+        const size_t neighbours[4] = { (i + n - 1) % n, (i + 1) % n,
+            (i + n - step) % n, (i + step) % n };
+
+        size_t best = i;
+        for (size_t k = 0; k < 4; ++k)
+        {
+          if (particleBestFitnesses(neighbours[k]) <
+              particleBestFitnesses(best))
+            best = neighbours[k];
+        }
+        localBestIndices(i) = best;
+      }
+
+      velocityUpdate.Update(particlePositions, particleVelocities,
+          particleBestPositions, localBestIndices);
+    }
+
+   private:
+    //! Instantiated parent class.
+    const VonNeumannUpdate& parent;
+
+    //! Number of particles.
+    size_t n;
+
+    //! Number of columns of the grid.
+    size_t columns;
+
+    //! The velocity update of the whole swarm.
+    SwarmVelocityUpdate<typename MatType::elem_type> velocityUpdate;
+
+    //! Indices of each particle's best neighbour.
+    arma::uvec localBestIndices;
+  };
+
+ private:
+  //! The maximum velocity component.
+  double maxVelocity;
+};
+
+} // namespace ens
+
+#endif
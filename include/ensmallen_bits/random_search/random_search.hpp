@@ -0,0 +1,245 @@
+/**
+ * @file random_search.hpp
+ *
+ * Random search over a box, with uniform, Latin hypercube or Sobol sampling.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_RANDOM_SEARCH_RANDOM_SEARCH_HPP
+#define ENSMALLEN_RANDOM_SEARCH_RANDOM_SEARCH_HPP
+
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+
+#include "samplers/uniform_sampler.hpp"
+#include "samplers/latin_hypercube_sampler.hpp"
+#include "samplers/sobol_sampler.hpp"
+
+namespace ens {
+
+/**
+ * Random search evaluates the function at a fixed budget of points that fill
+ * the box [lowerBound, upperBound], and returns the best of them.  It needs
+ * no gradient, is trivially parallel, and is often competitive with more
+ * elaborate derivative-free methods when only a few of the dimensions matter.
+ *
+ * The points are drawn by the sampler policy: independently and uniformly
+ * (UniformSampler), as a Latin hypercube design (LatinHypercubeSampler), or
+ * from a scrambled Sobol sequence (SobolSampler).  They are evaluated in
+ * batches; if ensmallen is compiled with OpenMP, the points of a batch are
+ * evaluated in parallel, so the function's Evaluate() must then be safe to
+ * call concurrently.
+ *
+ * Optionally, the best numRefinements points are used as starting points for
+ * L-BFGS if the function also provides a gradient; the refined points are not
+ * restricted to the box.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Bergstra2012,
+ *   author  = {Bergstra, James and Bengio, Yoshua},
+ *   title   = {Random Search for Hyper-Parameter Optimization},
+ *   journal = {Journal of Machine Learning Research},
+ *   volume  = {13},
+ *   pages   = {281--305},
+ *   year    = {2012}
+ * }
+ * @endcode
+ *
+ * RandomSearch can optimize arbitrary functions.  For more details, see the
+ * documentation on function types included with this distribution or on the
+ * ensmallen website.
+ *
+ * @tparam SamplerType Policy that draws points from the unit hypercube.
+ */
+template<typename SamplerType = UniformSampler>
+class RandomSearchType
+{
+ public:
+  /**
+   * Construct the random search optimizer with the given parameters.
+   *
+   * @param maxIterations Number of points to evaluate.
+   * @param lowerBound Lower bound of the box; either a single value for all
+   *     dimensions, or one value for each element of the coordinates.
+   * @param upperBound Upper bound of the box; either a single value for all
+   *     dimensions, or one value for each element of the coordinates.
+   * @param batchSize Number of points evaluated together (in parallel, if
+   *     OpenMP is enabled).
+   * @param numRefinements Number of the best points to refine with L-BFGS (0
+   *     means no refinement).
+   * @param lbfgs L-BFGS optimizer used for the refinement.
+   * @param sampler Instantiated sampler policy.
+   */
+  RandomSearchType(const size_t maxIterations = 1000,
+                   const arma::mat& lowerBound = -arma::ones(1, 1),
+                   const arma::mat& upperBound = arma::ones(1, 1),
+                   const size_t batchSize = 64,
+                   const size_t numRefinements = 0,
+                   const L_BFGS& lbfgs = L_BFGS(),
+                   const SamplerType& sampler = SamplerType()) :
+      maxIterations(maxIterations),
+      lowerBound(lowerBound),
+      upperBound(upperBound),
+      batchSize(batchSize),
+      numRefinements(numRefinements),
+      lbfgs(lbfgs),
+      sampler(sampler)
+  { /* Nothing to do. */ }
+
+  /**
+   * Construct the random search optimizer with the given parameters, with the
+   * same bounds for all dimensions.
+   *
+   * @param maxIterations Number of points to evaluate.
+   * @param lowerBound Lower bound of every dimension.
+   * @param upperBound Upper bound of every dimension.
+   * @param batchSize Number of points evaluated together (in parallel, if
+   *     OpenMP is enabled).
+   * @param numRefinements Number of the best points to refine with L-BFGS (0
+   *     means no refinement).
+   * @param lbfgs L-BFGS optimizer used for the refinement.
+   * @param sampler Instantiated sampler policy.
+   */
+  RandomSearchType(const size_t maxIterations,
+                   const double lowerBound,
+                   const double upperBound,
+                   const size_t batchSize = 64,
+                   const size_t numRefinements = 0,
+                   const L_BFGS& lbfgs = L_BFGS(),
+                   const SamplerType& sampler = SamplerType()) :
+      maxIterations(maxIterations),
+      lowerBound(lowerBound * arma::ones(1, 1)),
+      upperBound(upperBound * arma::ones(1, 1)),
+      batchSize(batchSize),
+      numRefinements(numRefinements),
+      lbfgs(lbfgs),
+      sampler(sampler)
+  { /* Nothing to do. */ }
+
+  /**
+   * Optimize the given function using random search.  The given starting
+   * point is evaluated as well, and is overwritten with the best point found;
+   * the objective value of that point is returned.
+   *
+   * @tparam ArbitraryFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value of the final point.
+   */
+  template<typename ArbitraryFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(ArbitraryFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the number of points to evaluate.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of points to evaluate.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the lower bound of the box.
+  const arma::mat& LowerBound() const { return lowerBound; }
+  //! Modify the lower bound of the box.
+  arma::mat& LowerBound() { return lowerBound; }
+
+  //! Get the upper bound of the box.
+  const arma::mat& UpperBound() const { return upperBound; }
+  //! Modify the upper bound of the box.
+  arma::mat& UpperBound() { return upperBound; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of points refined with L-BFGS.
+  size_t NumRefinements() const { return numRefinements; }
+  //! Modify the number of points refined with L-BFGS.
+  size_t& NumRefinements() { return numRefinements; }
+
+  //! Get the L-BFGS optimizer used for refinement.
+  const L_BFGS& LBFGS() const { return lbfgs; }
+  //! Modify the L-BFGS optimizer used for refinement.
+  L_BFGS& LBFGS() { return lbfgs; }
+
+  //! Get the sampler.
+  const SamplerType& Sampler() const { return sampler; }
+  //! Modify the sampler.
+  SamplerType& Sampler() { return sampler; }
+
+ private:
+  /**
+   * Refine the given candidates with L-BFGS, and store the best result in
+   * iterate if it improves on bestObjective.  This overload is used when the
+   * function provides a gradient.
+   */
+  template<typename FunctionType, typename MatType, typename ElemType>
+  void Refine(FunctionType& function,
+              const std::vector<MatType>& candidates,
+              MatType& iterate,
+              ElemType& bestObjective,
+              std::true_type /* differentiable */);
+
+  /**
+   * Refinement is not possible without a gradient; warn if it was requested.
+   */
+  template<typename FunctionType, typename MatType, typename ElemType>
+  void Refine(FunctionType& function,
+              const std::vector<MatType>& candidates,
+              MatType& iterate,
+              ElemType& bestObjective,
+              std::false_type /* differentiable */);
+
+  //! The number of points to evaluate.
+  size_t maxIterations;
+
+  //! Lower bound of the box.
+  arma::mat lowerBound;
+
+  //! Upper bound of the box.
+  arma::mat upperBound;
+
+  //! The number of points evaluated together.
+  size_t batchSize;
+
+  //! The number of the best points refined with L-BFGS.
+  size_t numRefinements;
+
+  //! The L-BFGS optimizer used for refinement.
+  L_BFGS lbfgs;
+
+  //! The sampler policy.
+  SamplerType sampler;
+};
+
+// Convenience typedefs.
+
+/**
+ * Random search with independent uniform samples.
+ */
+using RandomSearch = RandomSearchType<UniformSampler>;
+
+/**
+ * Random search with a Latin hypercube design.
+ */
+using LatinHypercubeSearch = RandomSearchType<LatinHypercubeSampler>;
+
+/**
+ * Random search with a scrambled Sobol sequence.
+ */
+using SobolSearch = RandomSearchType<SobolSampler>;
+
+} // namespace ens
+
+// Include implementation.
+#include "random_search_impl.hpp"
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file random_search_impl.hpp
+ *
+ * Implementation of random search.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_RANDOM_SEARCH_RANDOM_SEARCH_IMPL_HPP
+#define ENSMALLEN_RANDOM_SEARCH_RANDOM_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "random_search.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+//! Optimize the function (minimize).
+template<typename SamplerType>
+template<typename ArbitraryFunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+typename MatType::elem_type RandomSearchType<SamplerType>::Optimize(
+    ArbitraryFunctionType& function,
+    MatType& iterateIn,
+    CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+
+  // Make sure that we have the methods that we need.
+  traits::CheckArbitraryFunctionTypeAPI<ArbitraryFunctionType,
+      BaseMatType>();
+  RequireDenseFloatingPointType<BaseMatType>();
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  const size_t n = iterate.n_elem;
+
+  // Expand the bounds to one value per element.
+  arma::Col<ElemType> lower(n), upper(n);
+  if (lowerBound.n_elem == 1)
+    lower.fill(ElemType(lowerBound(0)));
+  else if (lowerBound.n_elem == n)
+    lower = arma::conv_to<arma::Col<ElemType>>::from(arma::vectorise(
+        lowerBound));
+  else
+    throw std::invalid_argument("RandomSearch::Optimize(): the lower bound "
+        "must have one element or as many elements as the coordinates");
+
+  if (upperBound.n_elem == 1)
+    upper.fill(ElemType(upperBound(0)));
+  else if (upperBound.n_elem == n)
+    upper = arma::conv_to<arma::Col<ElemType>>::from(arma::vectorise(
+        upperBound));
+  else
+    throw std::invalid_argument("RandomSearch::Optimize(): the upper bound "
+        "must have one element or as many elements as the coordinates");
+
+  if (arma::any(upper < lower))
+  {
+    throw std::invalid_argument("RandomSearch::Optimize(): the upper bound "
+        "must not be smaller than the lower bound");
+  }
+  const arma::Col<ElemType> range = upper - lower;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+
+  // The starting point is a candidate too.
+  ElemType bestObjective = function.Evaluate(iterate);
+  terminate |= Callback::Evaluate(*this, function, iterate, bestObjective,
+      callbacks...);
+
+  // The best numRefinements points, sorted by objective.
+  std::vector<BaseMatType> topPoints;
+  std::vector<ElemType> topObjectives;
+
+  sampler.Reset(n, maxIterations);
+
+  const size_t actualBatchSize = std::max<size_t>(1, batchSize);
+  arma::Mat<ElemType> points;
+  arma::Col<ElemType> objectives;
+  for (size_t i = 0; i < maxIterations && !terminate; i += actualBatchSize)
+  {
+    const size_t effectiveBatchSize = std::min(actualBatchSize,
+        maxIterations - i);
+
+    // Draw the next batch of points, one per column, and map them to the box.
+    points.set_size(n, effectiveBatchSize);
+    sampler.Sample(points);
+    points.each_col() %= range;
+    points.each_col() += lower;
+
+    // Evaluate the whole batch; the candidates are aliases of the columns.
+    objectives.set_size(effectiveBatchSize);
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t j = 0; j < (ptrdiff_t) effectiveBatchSize; ++j)
+    {
+      const BaseMatType candidate(points.colptr(j), iterate.n_rows,
+          iterate.n_cols, false, true);
+      objectives(j) = function.Evaluate(candidate);
+    }
+
+    for (size_t j = 0; j < effectiveBatchSize; ++j)
+    {
+      const BaseMatType candidate(points.colptr(j), iterate.n_rows,
+          iterate.n_cols, false, true);
+      terminate |= Callback::Evaluate(*this, function, candidate,
+          objectives(j), callbacks...);
+
+      if (objectives(j) < bestObjective)
+      {
+        bestObjective = objectives(j);
+        iterate = candidate;
+      }
+
+      // Keep track of the best points for the refinement.
+      if (numRefinements > 0 && (topObjectives.size() < numRefinements ||
+          objectives(j) < topObjectives.back()))
+      {
+        const size_t pos = std::upper_bound(topObjectives.begin(),
+            topObjectives.end(), objectives(j)) - topObjectives.begin();
+        topObjectives.insert(topObjectives.begin() + pos, objectives(j));
+        topPoints.insert(topPoints.begin() + pos, candidate);
+        if (topObjectives.size() > numRefinements)
+        {
+          topObjectives.pop_back();
+          topPoints.pop_back();
+        }
+      }
+    }
+
+    terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
+  }
+
+  Info << "RandomSearch: best objective after sampling " << bestObjective
+      << "." << std::endl;
+
+  // Hand the best points off to L-BFGS, if the function has a gradient.
+  typedef std::integral_constant<bool,
+      traits::CheckGradient<ArbitraryFunctionType, BaseMatType,
+          BaseMatType>::value ||
+      traits::CheckEvaluateWithGradient<ArbitraryFunctionType, BaseMatType,
+          BaseMatType>::value> IsDifferentiable;
+  if (!terminate)
+    Refine(function, topPoints, iterate, bestObjective, IsDifferentiable());
+
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return bestObjective;
+}
+
+template<typename SamplerType>
+template<typename FunctionType, typename MatType, typename ElemType>
+void RandomSearchType<SamplerType>::Refine(
+    FunctionType& function,
+    const std::vector<MatType>& candidates,
+    MatType& iterate,
+    ElemType& bestObjective,
+    std::true_type /* differentiable */)
+{
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    MatType refined(candidates[i]);
+    const ElemType objective = lbfgs.Optimize(function, refined);
+    if (std::isfinite(objective) && objective < bestObjective)
+    {
+      bestObjective = objective;
+      iterate = std::move(refined);
+    }
+  }
+}
+
+template<typename SamplerType>
+template<typename FunctionType, typename MatType, typename ElemType>
+void RandomSearchType<SamplerType>::Refine(
+    FunctionType& /* function */,
+    const std::vector<MatType>& candidates,
+    MatType& /* iterate */,
+    ElemType& /* bestObjective */,
+    std::false_type /* differentiable */)
+{
+  if (!candidates.empty())
+  {
+    Warn << "RandomSearch: the function does not provide a gradient; the "
+        << "L-BFGS refinement is skipped." << std::endl;
+  }
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file latin_hypercube_sampler.hpp
+ *
+ * Latin hypercube sampling of the unit hypercube for RandomSearch.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_RANDOM_SEARCH_SAMPLERS_LATIN_HYPERCUBE_SAMPLER_HPP
+#define ENSMALLEN_RANDOM_SEARCH_SAMPLERS_LATIN_HYPERCUBE_SAMPLER_HPP
+
+namespace ens {
+
+/**
+ * Draw a Latin hypercube design from the unit hypercube: for a budget of n
+ * points, each axis is split into n intervals of equal width, and every
+ * interval of every axis contains exactly one point.  The design is stratified
+ * over the whole budget given to Reset(), so its points can be drawn in any
+ * number of batches.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{McKay1979,
+ *   author  = {McKay, Michael D. and Beckman, Richard J. and Conover,
+ *              William J.},
+ *   title   = {A Comparison of Three Methods for Selecting Values of Input
+ *              Variables in the Analysis of Output from a Computer Code},
+ *   journal = {Technometrics},
+ *   volume  = {21},
+ *   number  = {2},
+ *   pages   = {239--245},
+ *   year    = {1979}
+ * }
+ * @endcode
+ */
+class LatinHypercubeSampler
+{
+ public:
+  //! Construct the Latin hypercube sampler.
+  LatinHypercubeSampler() : next(0) { /* Nothing to do. */ }
+
+  /**
+   * Draw a random permutation of the intervals for every axis.
+   *
+   * @param dimensions Dimensionality of the points.
+   * @param numPoints Total number of points that will be drawn.
+   */
+  void Reset(const size_t dimensions, const size_t numPoints)
+  {
+    strata.set_size(dimensions, numPoints);
+    for (size_t i = 0; i < dimensions; ++i)
+      strata.row(i) = arma::randperm<arma::urowvec>(numPoints);
+
+    next = 0;
+  }
+
+  /**
+   * Draw the next points.cols points of the design, one per column.  The
+   * matrix must already have the right size.  If more points than the budget
+   * given to Reset() are drawn, a new design is started.
+   *
+   * @param points Matrix to store the points in [0, 1)^d into.
+   */
+  template<typename MatType>
+  void Sample(MatType& points)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    points.randu();
+    for (size_t j = 0; j < points.n_cols; ++j, ++next)
+    {
+      if (next == strata.n_cols)
+        Reset(strata.n_rows, strata.n_cols);
+
+      // Place the point uniformly within its interval on each axis.
+      for (size_t i = 0; i < points.n_rows; ++i)
+        points(i, j) = (ElemType(strata(i, next)) + points(i, j)) /
+            ElemType(strata.n_cols);
+    }
+  }
+
+ private:
+  //! The interval of each point on each axis, one column per point.
+  arma::umat strata;
+
+  //! The index of the next point of the design.
+  size_t next;
+};
+
+} // namespace ens
+
+#endif
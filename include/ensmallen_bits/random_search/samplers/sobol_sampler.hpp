@@ -0,0 +1,182 @@
+/**
+ * @file sobol_sampler.hpp
+ *
+ * Scrambled Sobol sequence sampling of the unit hypercube for RandomSearch.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_RANDOM_SEARCH_SAMPLERS_SOBOL_SAMPLER_HPP
+#define ENSMALLEN_RANDOM_SEARCH_SAMPLERS_SOBOL_SAMPLER_HPP
+
+namespace ens {
+
+/**
+ * Draw points of the Sobol low-discrepancy sequence from the unit hypercube.
+ * The points are generated in Gray code order, so each new point costs O(d),
+ * and the sequence is scrambled with a random digital shift (an XOR of every
+ * coordinate with a random bit pattern), which keeps its low discrepancy.  The
+ * direction numbers are those of Joe and Kuo for the first 21 dimensions.
+ *
+ * For more information, see the following:
+ *
+ * @code
+ * @article{Joe2008,
+ *   author  = {Joe, Stephen and Kuo, Frances Y.},
+ *   title   = {Constructing Sobol Sequences with Better Two-Dimensional
+ *              Projections},
+ *   journal = {SIAM Journal on Scientific Computing},
+ *   volume  = {30},
+ *   number  = {5},
+ *   pages   = {2635--2654},
+ *   year    = {2008}
+ * }
+ * @endcode
+ */
+class SobolSampler
+{
+ public:
+  //! The maximum supported dimensionality.
+  static const size_t MaxDimensions = 21;
+
+  /**
+   * Construct the Sobol sampler.
+   *
+   * @param scramble Whether to apply a random digital shift to the sequence.
+   */
+  SobolSampler(const bool scramble = true) : scramble(scramble), index(0)
+  { /* Nothing to do. */ }
+
+  //! Get whether the sequence is scrambled.
+  bool Scramble() const { return scramble; }
+  //! Modify whether the sequence is scrambled.
+  bool& Scramble() { return scramble; }
+
+  /**
+   * Compute the direction numbers and restart the sequence.
+   *
+   * @param dimensions Dimensionality of the points.
+   * @param numPoints Total number of points that will be drawn.
+   */
+  void Reset(const size_t dimensions, const size_t /* numPoints */)
+  {
+    if (dimensions > MaxDimensions)
+    {
+      std::ostringstream oss;
+      oss << "SobolSampler::Reset(): only up to " << MaxDimensions
+          << " dimensions are supported, but " << dimensions << " were given";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Degree s, coefficients a and initial direction numbers m_1, ..., m_s
+    // of the primitive polynomials for dimensions 2 to 21.
+    static const unsigned int s[MaxDimensions - 1] = { 1, 2, 3, 3, 4, 4, 5, 5,
+        5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7 };
+    static const unsigned int a[MaxDimensions - 1] = { 0, 1, 1, 2, 1, 4, 2, 4,
+        7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4 };
+    static const unsigned int m[MaxDimensions - 1][7] = {
+        { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 },
+        { 1, 3, 5, 13 }, { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 },
+        { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 }, { 1, 1, 1, 3, 11 },
+        { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 }, { 1, 1, 1, 15, 21, 21 },
+        { 1, 3, 1, 13, 27, 49 }, { 1, 1, 1, 15, 7, 5 },
+        { 1, 3, 1, 15, 13, 25 }, { 1, 1, 5, 5, 19, 61 },
+        { 1, 3, 7, 11, 23, 15, 103 }, { 1, 3, 7, 13, 13, 15, 69 } };
+
+    directions.set_size(Bits, dimensions);
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+      // The first dimension is the van der Corput sequence.
+      if (d == 0)
+      {
+        for (size_t k = 0; k < Bits; ++k)
+          directions(k, d) = uint32_t(1) << (Bits - 1 - k);
+        continue;
+      }
+
+      const unsigned int deg = s[d - 1];
+      for (size_t k = 0; k < deg; ++k)
+        directions(k, d) = uint32_t(m[d - 1][k]) << (Bits - 1 - k);
+
+      for (size_t k = deg; k < Bits; ++k)
+      {
+        uint32_t v = directions(k - deg, d) ^ (directions(k - deg, d) >> deg);
+        for (size_t j = 1; j < deg; ++j)
+        {
+          if ((a[d - 1] >> (deg - 1 - j)) & 1)
+            v ^= directions(k - j, d);
+        }
+        directions(k, d) = v;
+      }
+    }
+
+    state.zeros(dimensions);
+    shift.zeros(dimensions);
+    if (scramble)
+    {
+      // Draw the 32-bit shifts as pairs of 16-bit halves.
+      const arma::uvec halves = arma::randi<arma::uvec>(2 * dimensions,
+          arma::distr_param(0, 0xFFFF));
+      for (size_t d = 0; d < dimensions; ++d)
+      {
+        shift(d) = (uint32_t(halves(2 * d)) << 16) |
+            uint32_t(halves(2 * d + 1));
+      }
+    }
+
+    index = 0;
+  }
+
+  /**
+   * Draw the next points.cols points of the sequence, one per column.  The
+   * matrix must already have the right size.
+   *
+   * @param points Matrix to store the points in [0, 1)^d into.
+   */
+  template<typename MatType>
+  void Sample(MatType& points)
+  {
+    typedef typename MatType::elem_type ElemType;
+
+    for (size_t j = 0; j < points.n_cols; ++j, ++index)
+    {
+      // Gray code: the next point flips the direction number of the lowest
+      // zero bit of the current index.  After 2^32 points, the sequence
+      // repeats.
+      size_t c = 0;
+      for (size_t i = index; (i & 1) && (c < Bits - 1); i >>= 1)
+        ++c;
+
+      for (size_t d = 0; d < points.n_rows; ++d)
+      {
+        points(d, j) = ElemType(double(state(d) ^ shift(d)) / 4294967296.0);
+        state(d) ^= directions(c, d);
+      }
+    }
+  }
+
+ private:
+  //! The number of bits of the generated integers.
+  static const size_t Bits = 32;
+
+  //! Whether to apply a random digital shift.
+  bool scramble;
+
+  //! The direction numbers, one column per dimension.
+  arma::Mat<uint32_t> directions;
+
+  //! The next point of the (unshifted) sequence, as integers.
+  arma::Col<uint32_t> state;
+
+  //! The digital shift of each dimension.
+  arma::Col<uint32_t> shift;
+
+  //! The index of the next point of the sequence.
+  size_t index;
+};
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file uniform_sampler.hpp
+ *
+ * Uniform random sampling of the unit hypercube for RandomSearch.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_RANDOM_SEARCH_SAMPLERS_UNIFORM_SAMPLER_HPP
+#define ENSMALLEN_RANDOM_SEARCH_SAMPLERS_UNIFORM_SAMPLER_HPP
+
+namespace ens {
+
+/**
+ * Draw independent, uniformly distributed points from the unit hypercube.
+ * This is the sampler used by plain random search.  Any class that is used in
+ * place of this sampler must implement the same methods.
+ */
+class UniformSampler
+{
+ public:
+  /**
+   * Prepare to draw the given number of points of the given dimensionality.
+   *
+   * @param dimensions Dimensionality of the points.
+   * @param numPoints Total number of points that will be drawn.
+   */
+  void Reset(const size_t /* dimensions */, const size_t /* numPoints */)
+  { /* Nothing to do. */ }
+
+  /**
+   * Draw the next points.cols points, one per column.  The matrix must
+   * already have the right size.
+   *
+   * @param points Matrix to store the points in [0, 1)^d into.
+   */
+  template<typename MatType>
+  void Sample(MatType& points)
+  {
+    points.randu();
+  }
+};
+
+} // namespace ens
+
+#endif
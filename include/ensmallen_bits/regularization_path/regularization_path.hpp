@@ -0,0 +1,212 @@
+/**
+ * @file regularization_path.hpp
+ *
+ * Solve a problem for a sequence of regularization strengths, warm starting
+ * each solve from the previous one.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_REGULARIZATION_PATH_REGULARIZATION_PATH_HPP
+#define ENSMALLEN_REGULARIZATION_PATH_REGULARIZATION_PATH_HPP
+
+#include <ensmallen_bits/lbfgs/lbfgs.hpp>
+
+namespace ens {
+
+/**
+ * RegularizationPath solves a problem for a grid of regularization strengths
+ * (a regularization path), from the largest to the smallest.  The solution for
+ * each strength is the starting point for the next one, and the state of the
+ * optimizer is kept across solves:
+ *
+ *  - L_BFGS has its curvature history cleared before the first solve of a
+ *    segment, and kept (with its reset policy disabled) across the solves;
+ *  - the other optimizers with a ResetPolicy() (like the SGD family) have
+ *    their policy disabled after the first solve, so that the update policy
+ *    state (e.g. the Adam moments) carries over;
+ *  - ScreenedSCD uses the previous penalty in its strong rule, and its working
+ *    set starts from the nonzero features of the previous solution.
+ *
+ * The regularization strength is set with the Lambda() method of the function
+ * if it has one (e.g. LogisticRegressionFunction), and with the Lambda()
+ * method of the optimizer otherwise (e.g. ScreenedSCD with LassoFunction).
+ *
+ * The grid can optionally be split into contiguous segments that are solved in
+ * parallel (with OpenMP).  Each segment starts from the given initial point,
+ * and uses its own copy of the optimizer and of the function; the copies must
+ * be safe to use concurrently.  Note that some functions share their data
+ * between copies (e.g. LogisticRegressionFunction), so optimizers that modify
+ * the function (like SGD-type optimizers that shuffle the data) must not
+ * shuffle in that case.
+ *
+ * @tparam OptimizerType Type of the optimizer used for each solve.
+ */
+template<typename OptimizerType = L_BFGS>
+class RegularizationPath
+{
+ public:
+  /**
+   * Construct the RegularizationPath object with the given optimizer.
+   *
+   * @param optimizer Optimizer used for each solve (it is copied for each
+   *     segment, so it is not modified).
+   * @param numSegments Number of segments of the grid to solve in parallel.
+   * @param warmStart If true, warm start each solve from the previous one;
+   *     otherwise, solve each problem independently from the initial point.
+   */
+  RegularizationPath(const OptimizerType& optimizer = OptimizerType(),
+                     const size_t numSegments = 1,
+                     const bool warmStart = true);
+
+  /**
+   * Solve the given function for each of the given regularization strengths.
+   * The strengths are visited from the largest to the smallest, but the
+   * solutions and objectives are stored in the order of the given strengths.
+   * The given starting point will be modified to store the solution for the
+   * smallest strength.
+   *
+   * @tparam FunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param lambdas Regularization strengths.
+   * @param iterate Starting point (will be modified).
+   * @param path Solution for each regularization strength.
+   * @param callbacks Callback functions, passed to each solve (concurrently if
+   *     numSegments is greater than 1).
+   * @return Final objective value for each regularization strength.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  arma::Col<typename MatType::elem_type> Optimize(
+      FunctionType& function,
+      const arma::vec& lambdas,
+      MatType& iterate,
+      std::vector<MatType>& path,
+      CallbackTypes&&... callbacks);
+
+  /**
+   * Create a grid of regularization strengths, logarithmically spaced from
+   * lambdaMax down to ratio * lambdaMax.
+   *
+   * @param lambdaMax Largest regularization strength (e.g.
+   *     LassoFunction::LambdaMax()).
+   * @param numLambdas Number of regularization strengths.
+   * @param ratio Ratio of the smallest to the largest strength.
+   */
+  static arma::vec LogGrid(const double lambdaMax,
+                           const size_t numLambdas = 100,
+                           const double ratio = 1e-3);
+
+  //! Get the optimizer.
+  const OptimizerType& Optimizer() const { return optimizer; }
+  //! Modify the optimizer.
+  OptimizerType& Optimizer() { return optimizer; }
+
+  //! Get the number of segments solved in parallel.
+  size_t NumSegments() const { return numSegments; }
+  //! Modify the number of segments solved in parallel.
+  size_t& NumSegments() { return numSegments; }
+
+  //! Get whether each solve is warm started from the previous one.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether each solve is warm started from the previous one.
+  bool& WarmStart() { return warmStart; }
+
+ private:
+  /**
+   * Solve the given contiguous range of the sorted grid, starting from the
+   * given point.
+   */
+  template<typename FunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  void Segment(OptimizerType& segmentOptimizer,
+               FunctionType& segmentFunction,
+               const arma::vec& lambdas,
+               const arma::uvec& order,
+               const size_t begin,
+               const size_t end,
+               const MatType& initialPoint,
+               std::vector<MatType>& path,
+               arma::Col<typename MatType::elem_type>& objectives,
+               CallbackTypes&... callbacks);
+
+  /**
+   * Set the regularization strength on the function, if it has a Lambda()
+   * method.
+   */
+  template<typename FunctionType>
+  static typename std::enable_if<traits::HasLambdaSignature<
+      FunctionType>::value, void>::type
+  SetLambda(OptimizerType& /* optimizer */,
+            FunctionType& function,
+            const double lambda)
+  {
+    function.Lambda() = lambda;
+  }
+
+  //! Otherwise, set the regularization strength on the optimizer.
+  template<typename FunctionType>
+  static typename std::enable_if<!traits::HasLambdaSignature<
+      FunctionType>::value, void>::type
+  SetLambda(OptimizerType& optimizer,
+            FunctionType& /* function */,
+            const double lambda)
+  {
+    static_assert(traits::HasLambdaSignature<OptimizerType>::value,
+        "RegularizationPath: either the function or the optimizer must have a "
+        "double& Lambda() method");
+    optimizer.Lambda() = lambda;
+  }
+
+  /**
+   * Prepare the optimizer for the next solve.  Optimizers with a kept history
+   * (like L_BFGS) have it cleared explicitly before a cold solve, and keep it
+   * after every solve when warm starting.
+   */
+  template<typename T>
+  typename std::enable_if<traits::HasClearHistorySignature<T>::value &&
+      traits::HasResetPolicySignature<T>::value, void>::type
+  Reset(T& optimizer, const bool cold) const
+  {
+    if (cold)
+      optimizer.ClearHistory();
+    optimizer.ResetPolicy() = !warmStart;
+  }
+
+  //! Otherwise, reset the optimizer through its reset policy, if it has one.
+  template<typename T>
+  typename std::enable_if<!traits::HasClearHistorySignature<T>::value &&
+      traits::HasResetPolicySignature<T>::value, void>::type
+  Reset(T& optimizer, const bool cold) const
+  {
+    optimizer.ResetPolicy() = cold;
+  }
+
+  template<typename T>
+  typename std::enable_if<!traits::HasResetPolicySignature<T>::value,
+      void>::type
+  Reset(T& /* optimizer */, const bool /* cold */) const
+  { /* Nothing to do. */ }
+
+  //! The optimizer used for each solve.
+  OptimizerType optimizer;
+
+  //! The number of segments solved in parallel.
+  size_t numSegments;
+
+  //! Whether to warm start each solve from the previous one.
+  bool warmStart;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "regularization_path_impl.hpp"
+
+#endif
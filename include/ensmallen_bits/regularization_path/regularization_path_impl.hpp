@@ -0,0 +1,142 @@
+/**
+ * @file regularization_path_impl.hpp
+ *
+ * Implementation of the regularization path driver.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_REGULARIZATION_PATH_REGULARIZATION_PATH_IMPL_HPP
+#define ENSMALLEN_REGULARIZATION_PATH_REGULARIZATION_PATH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "regularization_path.hpp"
+
+namespace ens {
+
+template<typename OptimizerType>
+RegularizationPath<OptimizerType>::RegularizationPath(
+    const OptimizerType& optimizer,
+    const size_t numSegments,
+    const bool warmStart) :
+    optimizer(optimizer),
+    numSegments(numSegments),
+    warmStart(warmStart)
+{ /* Nothing to do. */ }
+
+template<typename OptimizerType>
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+arma::Col<typename MatType::elem_type>
+RegularizationPath<OptimizerType>::Optimize(
+    FunctionType& function,
+    const arma::vec& lambdas,
+    MatType& iterate,
+    std::vector<MatType>& path,
+    CallbackTypes&&... callbacks)
+{
+  if (lambdas.n_elem == 0)
+  {
+    throw std::invalid_argument("RegularizationPath::Optimize(): no "
+        "regularization strengths given");
+  }
+
+  if (numSegments == 0)
+  {
+    throw std::invalid_argument("RegularizationPath::Optimize(): the number "
+        "of segments must be positive");
+  }
+
+  // Visit the strengths from the largest to the smallest.
+  const arma::uvec order = arma::sort_index(lambdas, "descend");
+  const size_t segments = std::min(numSegments, (size_t) lambdas.n_elem);
+
+  path.resize(lambdas.n_elem);
+  arma::Col<typename MatType::elem_type> objectives(lambdas.n_elem);
+
+  if (segments == 1)
+  {
+    OptimizerType segmentOptimizer(optimizer);
+    Segment(segmentOptimizer, function, lambdas, order, 0, lambdas.n_elem,
+        iterate, path, objectives, callbacks...);
+  }
+  else
+  {
+    // Each segment gets its own copy of the optimizer and the function, since
+    // both may be modified by the solves.
+    ENS_PRAGMA_OMP_PARALLEL_FOR
+    for (ptrdiff_t s = 0; s < (ptrdiff_t) segments; ++s)
+    {
+      const size_t begin = s * lambdas.n_elem / segments;
+      const size_t end = (s + 1) * lambdas.n_elem / segments;
+
+      OptimizerType segmentOptimizer(optimizer);
+      FunctionType segmentFunction(function);
+      Segment(segmentOptimizer, segmentFunction, lambdas, order, begin, end,
+          iterate, path, objectives, callbacks...);
+    }
+  }
+
+  iterate = path[order[order.n_elem - 1]];
+  return objectives;
+}
+
+template<typename OptimizerType>
+template<typename FunctionType,
+         typename MatType,
+         typename... CallbackTypes>
+void RegularizationPath<OptimizerType>::Segment(
+    OptimizerType& segmentOptimizer,
+    FunctionType& segmentFunction,
+    const arma::vec& lambdas,
+    const arma::uvec& order,
+    const size_t begin,
+    const size_t end,
+    const MatType& initialPoint,
+    std::vector<MatType>& path,
+    arma::Col<typename MatType::elem_type>& objectives,
+    CallbackTypes&... callbacks)
+{
+  MatType coordinates(initialPoint);
+  for (size_t k = begin; k < end; ++k)
+  {
+    const size_t index = order[k];
+
+    // The first solve of a segment (or every solve, without warm starts)
+    // starts from scratch.
+    const bool cold = (k == begin) || !warmStart;
+    if (cold && k != begin)
+      coordinates = initialPoint;
+    Reset(segmentOptimizer, cold);
+
+    SetLambda(segmentOptimizer, segmentFunction, lambdas[index]);
+    objectives[index] = segmentOptimizer.Optimize(segmentFunction,
+        coordinates, callbacks...);
+    path[index] = coordinates;
+
+    Info << "RegularizationPath: lambda " << lambdas[index] << ", objective "
+        << objectives[index] << "." << std::endl;
+  }
+}
+
+template<typename OptimizerType>
+arma::vec RegularizationPath<OptimizerType>::LogGrid(const double lambdaMax,
+                                                     const size_t numLambdas,
+                                                     const double ratio)
+{
+  if (lambdaMax <= 0.0 || ratio <= 0.0)
+  {
+    throw std::invalid_argument("RegularizationPath::LogGrid(): lambdaMax and "
+        "ratio must be positive");
+  }
+
+  return arma::exp(arma::linspace<arma::vec>(std::log(lambdaMax),
+      std::log(lambdaMax * ratio), numLambdas));
+}
+
+} // namespace ens
+
+#endif
@@ -52,10 +52,11 @@ class SARAHPlusUpdate
               const double stepSize,
               const double vNorm)
   {
-    v += (gradient - gradient0) / (double) batchSize;
-    iterate -= stepSize * v;
+    // Update v and the iterate and compute the norm of v in a single pass.
+    const double norm = RecursiveGradientStep(iterate, v, gradient, gradient0,
+        1.0 / (double) batchSize, stepSize);
 
-    if (arma::norm(v) <= gamma * vNorm)
+    if (norm <= gamma * vNorm)
       return true;
 
     return false;
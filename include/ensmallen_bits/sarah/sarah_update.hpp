@@ -41,8 +41,8 @@ class SARAHUpdate
               const double stepSize,
               const double /* vNorm */)
   {
-    v += (gradient - gradient0) / (double) batchSize;
-    iterate -= stepSize * v;
+    RecursiveGradientStep(iterate, v, gradient, gradient0,
+        1.0 / (double) batchSize, stepSize);
     return false;
   }
 };
@@ -0,0 +1,297 @@
+/**
+ * @file screened_scd.hpp
+ *
+ * Coordinate descent for L1-regularized problems with strong rules, gap safe
+ * screening rules and an active set strategy.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SCD_SCREENED_SCD_HPP
+#define ENSMALLEN_SCD_SCREENED_SCD_HPP
+
+namespace ens {
+
+/**
+ * ScreenedSCD minimizes L1-regularized (Lasso or elastic net) problems of the
+ * form
+ *
+ *   min_w f(w) + lambda ||w||_1
+ *
+ * with proximal coordinate descent, where f is a smooth resolvable function
+ * whose features are the columns of the coordinates.  Since most features of
+ * such problems are zero at the solution, the optimizer avoids visiting them:
+ *
+ *  - The sequential strong rule builds the initial working set from the
+ *    features whose correlation with the residual (the absolute value of the
+ *    gradient) is at least 2 lambda - lambda_prev, where lambda_prev is the
+ *    penalty of the previous solve.  The strong rule may be wrong, so the
+ *    other features are only discarded temporarily.
+ *
+ *  - Cyclic passes are done over the working set only.  Every kktInterval
+ *    passes, the full gradient is computed; the features that violate the KKT
+ *    conditions are added to the working set, and if the function provides a
+ *    duality gap, the gap safe rules permanently discard the features that are
+ *    guaranteed to be zero at the solution.
+ *
+ * The gap safe rules are used if the function provides
+ *
+ * @code
+ * double DualityGap(const arma::mat& coordinates,
+ *                   const arma::mat& gradient,
+ *                   const double lambda);
+ * const arma::vec& FeatureNorms();
+ * @endcode
+ *
+ * where DualityGap() returns the duality gap of the L1-regularized problem at
+ * the dual point theta = r / max(lambda, ||g||_inf) (with r the residual and g
+ * the given gradient of f at the coordinates), and FeatureNorms() returns the
+ * norm of the design column of each feature.  In that case, the duality gap is
+ * also used as stopping criterion.  See ens::test::LassoFunction for an example.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Tibshirani2012,
+ *   author  = {Tibshirani, Robert and Bien, Jacob and Friedman, Jerome and
+ *              Hastie, Trevor and Simon, Noah and Taylor, Jonathan and
+ *              Tibshirani, Ryan J.},
+ *   title   = {Strong rules for discarding predictors in lasso-type problems},
+ *   journal = {Journal of the Royal Statistical Society: Series B},
+ *   volume  = {74},
+ *   number  = {2},
+ *   pages   = {245--266},
+ *   year    = {2012}
+ * }
+ *
+ * @article{Ndiaye2017,
+ *   author  = {Ndiaye, Eugene and Fercoq, Olivier and Gramfort, Alexandre and
+ *              Salmon, Joseph},
+ *   title   = {Gap Safe Screening Rules for Sparsity Enforcing Penalties},
+ *   journal = {Journal of Machine Learning Research},
+ *   volume  = {18},
+ *   number  = {128},
+ *   pages   = {1--33},
+ *   year    = {2017}
+ * }
+ * @endcode
+ *
+ * ScreenedSCD can optimize resolvable functions that also provide a full
+ * Gradient().  For more details, see the documentation on function types
+ * included with this distribution or on the ensmallen website.
+ */
+class ScreenedSCD
+{
+ public:
+  /**
+   * Construct the ScreenedSCD optimizer with the given parameters.  The
+   * maximum number of iterations refers to the maximum number of coordinate
+   * updates.
+   *
+   * @param lambda Weight of the L1 penalty.
+   * @param stepSize Step size for each coordinate update.
+   * @param maxIterations Maximum number of coordinate updates allowed (0 means
+   *     no limit).
+   * @param tolerance Maximum duality gap (or absolute change of the objective,
+   *     if the function has no duality gap) to terminate the algorithm.
+   * @param kktInterval Number of passes over the working set between KKT
+   *     checks.
+   * @param strongRules If true, build the initial working set with the
+   *     sequential strong rule; otherwise, start with all features.
+   * @param gapSafeRules If true and the function provides a duality gap,
+   *     permanently discard features with the gap safe rules.
+   * @param shuffle If true, visit the working set in a random order in each
+   *     pass.
+   */
+  ScreenedSCD(const double lambda = 0.01,
+              const double stepSize = 0.01,
+              const size_t maxIterations = 100000,
+              const double tolerance = 1e-5,
+              const size_t kktInterval = 10,
+              const bool strongRules = true,
+              const bool gapSafeRules = true,
+              const bool shuffle = true);
+
+  /**
+   * Optimize the given function using screened coordinate descent.  The given
+   * starting point will be modified to store the finishing point of the
+   * optimization, and the final objective value (including the L1 penalty) is
+   * returned.  After optimization, PreviousLambda() is set to Lambda(), so
+   * that solving a sequence of problems with decreasing penalties (and warm
+   * starts) uses the sequential strong rule.
+   *
+   * @tparam ResolvableFunctionType Type of the function to be optimized.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam GradType Type of matrix to use to represent partial gradients.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param function Function to optimize.
+   * @param iterate Starting point (will be modified).
+   * @param callbacks Callback functions.
+   * @return Objective value at the final point.
+   */
+  template<typename ResolvableFunctionType,
+           typename MatType,
+           typename GradType,
+           typename... CallbackTypes>
+  typename std::enable_if<IsArmaType<GradType>::value,
+      typename MatType::elem_type>::type
+  Optimize(ResolvableFunctionType& function,
+           MatType& iterate,
+           CallbackTypes&&... callbacks);
+
+  //! Forward arma::SpMat<typename MatType::elem_type> as GradType.
+  template<typename ResolvableFunctionType,
+           typename MatType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(ResolvableFunctionType& function,
+                                       MatType& iterate,
+                                       CallbackTypes&&... callbacks)
+  {
+    return Optimize<ResolvableFunctionType, MatType,
+        arma::SpMat<typename MatType::elem_type>, CallbackTypes...>(
+        function, iterate, std::forward<CallbackTypes>(callbacks)...);
+  }
+
+  //! Get the weight of the L1 penalty.
+  double Lambda() const { return lambda; }
+  //! Modify the weight of the L1 penalty.
+  double& Lambda() { return lambda; }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of passes over the working set between KKT checks.
+  size_t KKTInterval() const { return kktInterval; }
+  //! Modify the number of passes over the working set between KKT checks.
+  size_t& KKTInterval() { return kktInterval; }
+
+  //! Get whether the strong rule is used.
+  bool StrongRules() const { return strongRules; }
+  //! Modify whether the strong rule is used.
+  bool& StrongRules() { return strongRules; }
+
+  //! Get whether the gap safe rules are used.
+  bool GapSafeRules() const { return gapSafeRules; }
+  //! Modify whether the gap safe rules are used.
+  bool& GapSafeRules() { return gapSafeRules; }
+
+  //! Get whether the working set is shuffled in each pass.
+  bool Shuffle() const { return shuffle; }
+  //! Modify whether the working set is shuffled in each pass.
+  bool& Shuffle() { return shuffle; }
+
+  //! Get the penalty of the previous solve (0 if unknown).
+  double PreviousLambda() const { return previousLambda; }
+  //! Modify the penalty of the previous solve (0 if unknown).
+  double& PreviousLambda() { return previousLambda; }
+
+  //! Get the number of features discarded by the gap safe rules in the last
+  //! optimization.
+  size_t NumDiscarded() const { return numDiscarded; }
+
+  //! Get the size of the working set at the end of the last optimization.
+  size_t WorkingSetSize() const { return workingSetSize; }
+
+ private:
+  /**
+   * Get the feature norms of the given function, if it provides a duality gap.
+   * Returns false otherwise.
+   */
+  template<typename FunctionType, typename MatType>
+  static typename std::enable_if<traits::HasDualityGapSignature<
+      FunctionType, MatType>::value, bool>::type
+  FeatureNorms(FunctionType& function, arma::vec& norms)
+  {
+    norms = function.FeatureNorms();
+    return true;
+  }
+
+  template<typename FunctionType, typename MatType>
+  static typename std::enable_if<!traits::HasDualityGapSignature<
+      FunctionType, MatType>::value, bool>::type
+  FeatureNorms(FunctionType& /* function */, arma::vec& /* norms */)
+  {
+    return false;
+  }
+
+  /**
+   * Get the duality gap of the given function at the given coordinates (where
+   * the full gradient is the given one), if it provides one.  Returns the
+   * largest representable value otherwise.
+   */
+  template<typename FunctionType, typename MatType>
+  static typename std::enable_if<traits::HasDualityGapSignature<
+      FunctionType, MatType>::value, typename MatType::elem_type>::type
+  DualityGap(FunctionType& function,
+             const MatType& iterate,
+             const MatType& gradient,
+             const double lambda)
+  {
+    return function.DualityGap(iterate, gradient, lambda);
+  }
+
+  template<typename FunctionType, typename MatType>
+  static typename std::enable_if<!traits::HasDualityGapSignature<
+      FunctionType, MatType>::value, typename MatType::elem_type>::type
+  DualityGap(FunctionType& /* function */,
+             const MatType& /* iterate */,
+             const MatType& /* gradient */,
+             const double /* lambda */)
+  {
+    return std::numeric_limits<typename MatType::elem_type>::max();
+  }
+
+  //! The weight of the L1 penalty.
+  double lambda;
+
+  //! The step size for each coordinate update.
+  double stepSize;
+
+  //! The maximum number of allowed coordinate updates.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! The number of passes over the working set between KKT checks.
+  size_t kktInterval;
+
+  //! Whether to use the strong rule.
+  bool strongRules;
+
+  //! Whether to use the gap safe rules.
+  bool gapSafeRules;
+
+  //! Whether to shuffle the working set in each pass.
+  bool shuffle;
+
+  //! The penalty of the previous solve.
+  double previousLambda;
+
+  //! The number of features discarded in the last optimization.
+  size_t numDiscarded;
+
+  //! The size of the working set at the end of the last optimization.
+  size_t workingSetSize;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "screened_scd_impl.hpp"
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ * @file screened_scd_impl.hpp
+ *
+ * Implementation of coordinate descent with screening rules for L1-regularized
+ * problems.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SCD_SCREENED_SCD_IMPL_HPP
+#define ENSMALLEN_SCD_SCREENED_SCD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "screened_scd.hpp"
+
+#include <ensmallen_bits/function.hpp>
+
+namespace ens {
+
+inline ScreenedSCD::ScreenedSCD(
+    const double lambda,
+    const double stepSize,
+    const size_t maxIterations,
+    const double tolerance,
+    const size_t kktInterval,
+    const bool strongRules,
+    const bool gapSafeRules,
+    const bool shuffle) :
+    lambda(lambda),
+    stepSize(stepSize),
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    kktInterval(kktInterval),
+    strongRules(strongRules),
+    gapSafeRules(gapSafeRules),
+    shuffle(shuffle),
+    previousLambda(0.0),
+    numDiscarded(0),
+    workingSetSize(0)
+{ /* Nothing to do */ }
+
+//! Optimize the function (minimize).
+template<typename ResolvableFunctionType,
+         typename MatType,
+         typename GradType,
+         typename... CallbackTypes>
+typename std::enable_if<IsArmaType<GradType>::value,
+typename MatType::elem_type>::type
+ScreenedSCD::Optimize(ResolvableFunctionType& function,
+                      MatType& iterateIn,
+                      CallbackTypes&&... callbacks)
+{
+  // Convenience typedefs.
+  typedef typename MatType::elem_type ElemType;
+  typedef typename MatTypeTraits<MatType>::BaseMatType BaseMatType;
+  typedef typename MatTypeTraits<GradType>::BaseMatType BaseGradType;
+
+  // Make sure we have the methods that we need.  The full gradient is needed
+  // for the KKT checks.
+  traits::CheckResolvableFunctionTypeAPI<ResolvableFunctionType, BaseMatType,
+      BaseGradType>();
+  traits::CheckFunctionTypeAPI<ResolvableFunctionType, BaseMatType,
+      BaseMatType>();
+  RequireFloatingPointType<BaseMatType>();
+  RequireFloatingPointType<BaseGradType>();
+
+  if (lambda <= 0.0)
+  {
+    throw std::invalid_argument("ScreenedSCD::Optimize(): lambda must be "
+        "positive");
+  }
+
+  if (kktInterval == 0)
+  {
+    throw std::invalid_argument("ScreenedSCD::Optimize(): kktInterval must be "
+        "positive");
+  }
+
+  BaseMatType& iterate = (BaseMatType&) iterateIn;
+  BaseGradType gradient;
+  BaseMatType fullGradient;
+
+  const size_t numFeatures = function.NumFeatures();
+  arma::vec norms;
+  const bool hasGap = FeatureNorms<ResolvableFunctionType, BaseMatType>(
+      function, norms);
+  const bool screen = gapSafeRules && hasGap;
+
+  // The correlation of each feature with the residual.
+  function.Gradient(iterate, fullGradient);
+  arma::Row<ElemType> correlations = arma::max(arma::abs(fullGradient), 0);
+
+  // If the previous penalty is unknown, the smallest penalty with a zero
+  // solution is the natural previous penalty for a zero starting point.
+  double lambdaPrev = previousLambda;
+  if (lambdaPrev <= 0.0)
+  {
+    lambdaPrev = arma::any(arma::vectorise(iterate)) ? lambda :
+        (double) correlations.max();
+  }
+
+  // Build the initial working set with the sequential strong rule.  Features
+  // that are already nonzero are always kept.
+  const double strongThreshold = strongRules ? 2 * lambda - lambdaPrev : 0.0;
+  std::vector<bool> inWorkingSet(numFeatures, false);
+  std::vector<bool> discarded(numFeatures, false);
+  for (size_t j = 0; j < numFeatures; ++j)
+  {
+    if (correlations[j] >= strongThreshold ||
+        arma::any(arma::vectorise(iterate.col(j))))
+    {
+      inWorkingSet[j] = true;
+    }
+  }
+
+  std::vector<arma::uword> indices;
+  for (size_t j = 0; j < numFeatures; ++j)
+  {
+    if (inWorkingSet[j])
+      indices.push_back(j);
+  }
+  arma::uvec workingSet(indices);
+
+  numDiscarded = 0;
+  ElemType objective = std::numeric_limits<ElemType>::max();
+  ElemType lastObjective = std::numeric_limits<ElemType>::max();
+  const ElemType threshold = stepSize * lambda;
+  size_t i = 0;
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+
+  // Start iterating.
+  terminate |= Callback::BeginOptimization(*this, function, iterate,
+      callbacks...);
+  for (size_t pass = 1; !terminate; ++pass)
+  {
+    if (shuffle)
+      workingSet = arma::shuffle(workingSet);
+
+    for (size_t k = 0; k < workingSet.n_elem && !terminate; ++k)
+    {
+      const size_t j = workingSet[k];
+
+      // Get the partial gradient with respect to this feature.
+      function.PartialGradient(iterate, j, gradient);
+
+      terminate |= Callback::Gradient(*this, function, iterate, gradient,
+          callbacks...);
+
+      // Take a gradient step on the smooth part, then apply the proximal
+      // operator of the L1 penalty (soft thresholding).
+      iterate.col(j) -= stepSize * gradient.col(j);
+      iterate.col(j) = arma::sign(iterate.col(j)) % arma::clamp(
+          arma::abs(iterate.col(j)) - threshold, ElemType(0),
+          std::numeric_limits<ElemType>::max());
+
+      terminate |= Callback::StepTaken(*this, function, iterate,
+          callbacks...);
+
+      if (++i == maxIterations)
+        break;
+    }
+
+    if (i == maxIterations)
+    {
+      Info << "ScreenedSCD: maximum iterations (" << maxIterations << ") "
+          << "reached; terminating optimization." << std::endl;
+      break;
+    }
+
+    // An empty working set has nothing to update, so check the KKT conditions
+    // right away.
+    if (terminate || (pass % kktInterval != 0 && workingSet.n_elem > 0))
+      continue;
+
+    // Check the KKT conditions over all the features.
+    function.Gradient(iterate, fullGradient);
+    correlations = arma::max(arma::abs(fullGradient), 0);
+
+    objective = function.Evaluate(iterate) +
+        lambda * arma::accu(arma::abs(iterate));
+    terminate |= Callback::Evaluate(*this, function, iterate, objective,
+        callbacks...);
+
+    // Output current objective function.
+    Info << "ScreenedSCD: iteration " << i << ", objective " << objective
+        << ", working set size " << workingSet.n_elem << "." << std::endl;
+
+    if (std::isnan(objective) || std::isinf(objective))
+    {
+      Warn << "ScreenedSCD: converged to " << objective << "; terminating"
+          << " with failure.  Try a smaller step size?" << std::endl;
+
+      workingSetSize = workingSet.n_elem;
+      previousLambda = lambda;
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return objective;
+    }
+
+    const ElemType gap = DualityGap<ResolvableFunctionType, BaseMatType>(
+        function, iterate, fullGradient, lambda);
+    if (hasGap && gap <= tolerance)
+    {
+      Info << "ScreenedSCD: duality gap " << gap << " within tolerance "
+          << tolerance << "; terminating optimization." << std::endl;
+
+      workingSetSize = workingSet.n_elem;
+      previousLambda = lambda;
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return objective;
+    }
+
+    // Permanently discard the features that the gap safe sphere test proves
+    // to be zero at the solution.
+    if (screen)
+    {
+      const double scale = std::max(lambda, (double) correlations.max());
+      const double radius = std::sqrt(2 * std::max(gap, ElemType(0))) /
+          lambda;
+      for (size_t j = 0; j < numFeatures; ++j)
+      {
+        if (!discarded[j] && correlations[j] / scale + radius * norms[j] < 1)
+        {
+          discarded[j] = true;
+          inWorkingSet[j] = false;
+          iterate.col(j).zeros();
+          ++numDiscarded;
+        }
+      }
+    }
+
+    // Add the features that violate the KKT conditions to the working set.
+    size_t violators = 0;
+    for (size_t j = 0; j < numFeatures; ++j)
+    {
+      if (!discarded[j] && !inWorkingSet[j] && correlations[j] > lambda)
+      {
+        inWorkingSet[j] = true;
+        ++violators;
+      }
+    }
+
+    indices.clear();
+    for (size_t j = 0; j < numFeatures; ++j)
+    {
+      if (inWorkingSet[j])
+        indices.push_back(j);
+    }
+    workingSet = arma::uvec(indices);
+
+    // Without violators, the solution over an empty working set is final.
+    if (workingSet.n_elem == 0)
+    {
+      Info << "ScreenedSCD: empty working set with no KKT violations; "
+          << "terminating optimization." << std::endl;
+
+      workingSetSize = 0;
+      previousLambda = lambda;
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return objective;
+    }
+
+    if (!hasGap && violators == 0 &&
+        std::abs(lastObjective - objective) < tolerance)
+    {
+      Info << "ScreenedSCD: minimized within tolerance " << tolerance << "; "
+          << "terminating optimization." << std::endl;
+
+      workingSetSize = workingSet.n_elem;
+      previousLambda = lambda;
+      Callback::EndOptimization(*this, function, iterate, callbacks...);
+      return objective;
+    }
+
+    lastObjective = objective;
+  }
+
+  // Calculate and return final objective.
+  objective = function.Evaluate(iterate) +
+      lambda * arma::accu(arma::abs(iterate));
+  Callback::Evaluate(*this, function, iterate, objective, callbacks...);
+
+  workingSetSize = workingSet.n_elem;
+  previousLambda = lambda;
+  Callback::EndOptimization(*this, function, iterate, callbacks...);
+  return objective;
+}
+
+} // namespace ens
+
+#endif
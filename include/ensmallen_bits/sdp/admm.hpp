@@ -0,0 +1,217 @@
+/**
+ * @file admm.hpp
+ *
+ * An operator splitting (ADMM) solver for semidefinite programs.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_ADMM_HPP
+#define ENSMALLEN_SDP_ADMM_HPP
+
+#include "sdp.hpp"
+
+namespace ens {
+
+/**
+ * ADMMSolver is a first-order solver for semidefinite programs, based on the
+ * alternating direction augmented Lagrangian method applied to the dual SDP
+ *
+ *     max    b^T y
+ *     s.t.   sum_i y_i Ai + S = C, S >= 0.
+ *
+ * Each iteration minimizes the augmented Lagrangian over y (one solve with the
+ * m x m matrix A A^T), then over S (one projection onto the positive
+ * semidefinite cone), and then updates the primal matrix X, which is the
+ * multiplier of the equality constraint.  The Cholesky factorization of A A^T
+ * does not depend on the penalty parameter, so it is computed once and cached;
+ * it is reused by later calls to Optimize() on an SDP with the same
+ * constraints (for instance, when warm starting).
+ *
+ * The projection onto the PSD cone costs a full eigendecomposition of an
+ * n x n matrix.  If the solution X is known to have low rank, projectionRank
+ * may be set to r > 0; then only the (at most r) negative eigenpairs that
+ * make up X are computed, with a subspace iteration that is warm started
+ * from the previous iteration.  If the negative part turns out to have rank
+ * larger than r, or if the subspace iteration does not converge, the full
+ * eigendecomposition is used for that iteration.
+ *
+ * Compared to PrimalDualSolver, each iteration is much cheaper (no Schur
+ * complement has to be formed), but many more iterations are needed; this
+ * solver is meant for large SDPs that only have to be solved to moderate
+ * accuracy.  For more details, see the following paper:
+ *
+ * @code
+ * @article{Wen2010,
+ *   author  = {Wen, Zaiwen and Goldfarb, Donald and Yin, Wotao},
+ *   title   = {Alternating direction augmented {L}agrangian methods for
+ *              semidefinite programming},
+ *   journal = {Mathematical Programming Computation},
+ *   volume  = {2},
+ *   number  = {3},
+ *   pages   = {203--230},
+ *   year    = {2010}
+ * }
+ * @endcode
+ */
+class ADMMSolver
+{
+ public:
+  /**
+   * Construct a new solver instance with the given optimization parameters.
+   *
+   * @param maxIterations Maximum number of iterations (0 means no limit).
+   * @param tolerance Tolerance on the relative primal infeasibility, dual
+   *     infeasibility and duality gap required before terminating.
+   * @param penalty Initial penalty parameter mu.
+   * @param relaxation Step size of the update of X; values larger than 1
+   *     over-relax the update.  It must be in (0, (1 + sqrt(5)) / 2).
+   * @param adaptivePenalty If true, the penalty parameter is adapted to
+   *     balance the primal and dual infeasibilities.
+   * @param projectionRank Maximum rank of X used for partial projections
+   *     onto the PSD cone; 0 means full eigendecompositions are used.
+   */
+  ADMMSolver(const size_t maxIterations = 10000,
+             const double tolerance = 1e-5,
+             const double penalty = 1.0,
+             const double relaxation = 1.6,
+             const bool adaptivePenalty = true,
+             const size_t projectionRank = 0);
+
+  /**
+   * Optimize the given SDP, starting from the given primal coordinates.  The
+   * primal objective is returned, and the final coordinates are stored in the
+   * given coordinates matrix.
+   *
+   * @tparam SDPType Type of SDP to optimize.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param sdp The SDP to optimize.
+   * @param coordinates The primal SDP coordinates to optimize.
+   * @param callbacks Callback functions.
+   */
+  template<typename SDPType, typename MatType, typename... CallbackTypes>
+  typename MatType::elem_type Optimize(const SDPType& sdp,
+                                       MatType& coordinates,
+                                       CallbackTypes&&... callbacks);
+
+  /**
+   * Optimize the given SDP, warm starting from the given primal and dual
+   * coordinates (X and S).  The primal objective is returned, and the final
+   * primal and dual variables are stored in the given matrices.  The input
+   * values of ySparse and yDense are ignored.
+   *
+   * @tparam SDPType Type of SDP to optimize.
+   * @tparam MatType Type of matrix to optimize with.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param sdp The SDP to optimize.
+   * @param coordinates The initial primal SDP coordinates to optimize.
+   * @param ySparse Vector to store the final sparse y values into.
+   * @param yDense Vector to store the final dense y values into.
+   * @param dualCoordinates The initial dual SDP coordinates to optimize.
+   * @param callbacks Callback functions.
+   */
+  template<typename SDPType, typename MatType, typename... CallbackTypes>
+  typename MatType::elem_type Optimize(const SDPType& sdp,
+                                       MatType& coordinates,
+                                       MatType& ySparse,
+                                       MatType& yDense,
+                                       MatType& dualCoordinates,
+                                       CallbackTypes&&... callbacks);
+
+  //! Get the maximum number of iterations (0 indicates no limit).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations (0 indicates no limit).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the tolerance for termination.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for termination.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the initial penalty parameter.
+  double Penalty() const { return penalty; }
+  //! Modify the initial penalty parameter.
+  double& Penalty() { return penalty; }
+
+  //! Get the relaxation step size.
+  double Relaxation() const { return relaxation; }
+  //! Modify the relaxation step size.
+  double& Relaxation() { return relaxation; }
+
+  //! Get whether the penalty parameter is adapted.
+  bool AdaptivePenalty() const { return adaptivePenalty; }
+  //! Modify whether the penalty parameter is adapted.
+  bool& AdaptivePenalty() { return adaptivePenalty; }
+
+  //! Get the maximum rank used for partial projections (0 for full).
+  size_t ProjectionRank() const { return projectionRank; }
+  //! Modify the maximum rank used for partial projections (0 for full).
+  size_t& ProjectionRank() { return projectionRank; }
+
+  //! Get the number of iterations of the last optimization.
+  size_t Iterations() const { return iterations; }
+
+ private:
+  /**
+   * Form the svec'd constraint matrix A of the given SDP and, if it differs
+   * from the cached one, compute and cache the Cholesky factor of A A^T.
+   */
+  template<typename SDPType>
+  void Factorize(const SDPType& sdp);
+
+  /**
+   * Compute the negative part sum_{lambda_i < 0} lambda_i u_i u_i^T of the
+   * given symmetric matrix.
+   *
+   * @return false if the eigendecomposition failed.
+   */
+  bool NegativePart(const arma::mat& v, arma::mat& negative);
+
+  /**
+   * Compute the negative part of the given symmetric matrix from at most
+   * projectionRank eigenpairs, with a warm started subspace iteration.
+   *
+   * @return false if the negative part could not be computed this way.
+   */
+  bool PartialNegativePart(const arma::mat& v, arma::mat& negative);
+
+  //! The maximum number of iterations.
+  size_t maxIterations;
+
+  //! The tolerance for termination.
+  double tolerance;
+
+  //! The initial penalty parameter.
+  double penalty;
+
+  //! The relaxation step size.
+  double relaxation;
+
+  //! Whether the penalty parameter is adapted.
+  bool adaptivePenalty;
+
+  //! The maximum rank used for partial projections.
+  size_t projectionRank;
+
+  //! The number of iterations of the last optimization.
+  size_t iterations;
+
+  //! The cached svec'd constraint matrix (one row per constraint).
+  arma::sp_mat constraints;
+
+  //! The cached upper Cholesky factor of A A^T.
+  arma::mat factor;
+
+  //! The basis of the subspace iteration for partial projections.
+  arma::mat basis;
+};
+
+} // namespace ens
+
+// Include implementation.
+#include "admm_impl.hpp"
+
+#endif
@@ -0,0 +1,355 @@
+/**
+ * @file admm_impl.hpp
+ *
+ * Implementation of the ADMM solver for semidefinite programs.  We follow
+ * Algorithm 1 of
+ *
+ *   Alternating direction augmented Lagrangian methods for semidefinite
+ *   programming.
+ *   Zaiwen Wen, Donald Goldfarb, and Wotao Yin.
+ *   Math. Prog. Comp. 2010.
+ *
+ * which we refer to as [WGY10] in this file.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_ADMM_IMPL_HPP
+#define ENSMALLEN_SDP_ADMM_IMPL_HPP
+
+#include "admm.hpp"
+#include "lin_alg.hpp"
+
+namespace ens {
+
+inline ADMMSolver::ADMMSolver(const size_t maxIterations,
+                              const double tolerance,
+                              const double penalty,
+                              const double relaxation,
+                              const bool adaptivePenalty,
+                              const size_t projectionRank) :
+    maxIterations(maxIterations),
+    tolerance(tolerance),
+    penalty(penalty),
+    relaxation(relaxation),
+    adaptivePenalty(adaptivePenalty),
+    projectionRank(projectionRank),
+    iterations(0)
+{
+  // Nothing to do.
+}
+
+template<typename SDPType, typename MatType, typename... CallbackTypes>
+typename MatType::elem_type ADMMSolver::Optimize(
+    const SDPType& sdp,
+    MatType& coordinates,
+    CallbackTypes&&... callbacks)
+{
+  // Start from zero multipliers.
+  MatType ySparse, yDense;
+  MatType dualCoordinates(arma::zeros<MatType>(sdp.N(), sdp.N()));
+
+  return Optimize(sdp, coordinates, ySparse, yDense, dualCoordinates,
+      callbacks...);
+}
+
+template<typename SDPType, typename MatType, typename... CallbackTypes>
+typename MatType::elem_type ADMMSolver::Optimize(
+    const SDPType& sdp,
+    MatType& coordinates,
+    MatType& ySparse,
+    MatType& yDense,
+    MatType& dualCoordinates,
+    CallbackTypes&&... callbacks)
+{
+  if (coordinates.n_rows != sdp.N() || coordinates.n_cols != sdp.N())
+  {
+    throw std::logic_error("ADMMSolver::Optimize(): coordinates needs to be "
+        "square n x n matrix.");
+  }
+
+  if (dualCoordinates.n_rows != sdp.N() || dualCoordinates.n_cols != sdp.N())
+  {
+    throw std::logic_error("ADMMSolver::Optimize(): dualCoordinates needs to "
+        "be square n x n matrix.");
+  }
+
+  if (penalty <= 0.0)
+  {
+    throw std::invalid_argument("ADMMSolver::Optimize(): penalty must be "
+        "positive.");
+  }
+
+  // See Theorem 2 of [WGY10].
+  if (relaxation <= 0.0 || relaxation >= (1.0 + std::sqrt(5.0)) / 2.0)
+  {
+    throw std::invalid_argument("ADMMSolver::Optimize(): relaxation must be in "
+        "(0, (1 + sqrt(5)) / 2).");
+  }
+
+  const size_t numSparse = sdp.NumSparseConstraints();
+  const size_t numConstraints = sdp.NumConstraints();
+
+  Factorize(sdp);
+  basis.reset();
+
+  arma::vec b(numConstraints);
+  if (numSparse > 0)
+    b.subvec(0, numSparse - 1) = sdp.SparseB();
+  if (numConstraints > numSparse)
+    b.subvec(numSparse, numConstraints - 1) = sdp.DenseB();
+
+  const arma::mat c(sdp.C());
+  const double normB = arma::norm(b, 2);
+  const double normC = arma::norm(c, "fro");
+
+  arma::vec sx, sv, y;
+  arma::mat aty, v, negative, dualResidual;
+  double mu = penalty;
+  double primalObj = arma::dot(c, coordinates);
+
+  // Controls early termination of the optimization process.
+  bool terminate = false;
+  terminate |= Callback::BeginOptimization(*this, sdp, coordinates,
+      callbacks...);
+  for (iterations = 1; iterations != maxIterations && !terminate;
+      ++iterations)
+  {
+    // Minimize over y, (2.3a) of [WGY10]: A A^T y = mu (b - A(X)) + A(C - S).
+    math::Svec(coordinates, sx);
+    math::Svec(c - dualCoordinates, sv);
+    y = mu * (b - constraints * sx) + constraints * sv;
+    y = arma::solve(arma::trimatu(factor), arma::solve(
+        arma::trimatl(factor.t()), y));
+
+    // Minimize over S, (2.3b): S is the projection of V = C - A^T(y) - mu X
+    // onto the PSD cone, that is V minus its negative part.
+    math::Smat(arma::vec(constraints.t() * y), aty);
+    v = c - aty - mu * coordinates;
+    if (!PartialNegativePart(v, negative) && !NegativePart(v, negative))
+    {
+      Warn << "ADMMSolver::Optimize(): eigendecomposition failed!  "
+          << "Terminating optimization." << std::endl;
+      break;
+    }
+    dualCoordinates = v - negative;
+
+    // Update X, (2.3c); the unrelaxed new X is -negative / mu, which is PSD.
+    dualResidual = negative + mu * coordinates;
+    coordinates = (1.0 - relaxation) * coordinates -
+        (relaxation / mu) * negative;
+    terminate |= Callback::StepTaken(*this, sdp, coordinates, callbacks...);
+
+    // Check the relative primal and dual infeasibilities and duality gap.
+    math::Svec(coordinates, sx);
+    primalObj = arma::dot(c, coordinates);
+    const double dualObj = arma::dot(b, y);
+    const double primalInfeas = arma::norm(constraints * sx - b, 2) /
+        (1.0 + normB);
+    const double dualInfeas = arma::norm(dualResidual, "fro") / (1.0 + normC);
+    const double gap = std::abs(primalObj - dualObj) /
+        (1.0 + std::abs(primalObj) + std::abs(dualObj));
+
+    if (primalInfeas <= tolerance && dualInfeas <= tolerance &&
+        gap <= tolerance)
+    {
+      Info << "ADMMSolver::Optimize(): converged after " << iterations
+          << " iterations." << std::endl;
+      break;
+    }
+
+    // Balance the infeasibilities, as in Section 3.2 of [WGY10]: a large
+    // mu favors primal feasibility, and a small mu dual feasibility.
+    if (adaptivePenalty && iterations % 10 == 0)
+    {
+      if (primalInfeas > 5.0 * dualInfeas)
+        mu = std::min(2.0 * mu, 1e4 * penalty);
+      else if (dualInfeas > 5.0 * primalInfeas)
+        mu = std::max(0.5 * mu, 1e-4 * penalty);
+    }
+  }
+
+  if (iterations == maxIterations)
+  {
+    Warn << "ADMMSolver::Optimize(): did not converge after "
+        << maxIterations << " iterations!" << std::endl;
+  }
+
+  if (y.n_elem == numConstraints)
+  {
+    ySparse = (numSparse > 0) ? MatType(y.subvec(0, numSparse - 1)) :
+        MatType(0, 1);
+    yDense = (numConstraints > numSparse) ? MatType(y.subvec(numSparse,
+        numConstraints - 1)) : MatType(0, 1);
+  }
+
+  Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
+  return primalObj;
+}
+
+template<typename SDPType>
+void ADMMSolver::Factorize(const SDPType& sdp)
+{
+  const size_t n = sdp.N();
+
+  // Collect the upper triangles of the svec'd constraint matrices.
+  std::vector<arma::uword> rows, cols;
+  std::vector<double> values;
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+  {
+    const typename SDPType::SparseConstraintType& ai = sdp.SparseA()[i];
+    for (auto it = ai.begin(); it != ai.end(); ++it)
+    {
+      if (it.row() > it.col())
+        continue;
+
+      rows.push_back(i);
+      cols.push_back(math::SvecIndex(it.row(), it.col(), n));
+      values.push_back((it.row() == it.col()) ? (*it) :
+          arma::datum::sqrt2 * (*it));
+    }
+  }
+
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+  {
+    const typename SDPType::DenseConstraintType& ai = sdp.DenseA()[i];
+    for (size_t col = 0; col < n; ++col)
+    {
+      for (size_t row = 0; row <= col; ++row)
+      {
+        if (ai(row, col) == 0)
+          continue;
+
+        rows.push_back(sdp.NumSparseConstraints() + i);
+        cols.push_back(math::SvecIndex(row, col, n));
+        values.push_back((row == col) ? ai(row, col) :
+            arma::datum::sqrt2 * ai(row, col));
+      }
+    }
+  }
+
+  arma::umat locations(2, values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    locations(0, i) = rows[i];
+    locations(1, i) = cols[i];
+  }
+  const arma::sp_mat a(true, locations, arma::vec(values), sdp.NumConstraints(),
+      sdp.N2bar());
+
+  // Reuse the cached factorization if the constraints did not change.
+  if (a.n_rows == constraints.n_rows && a.n_cols == constraints.n_cols &&
+      a.n_nonzero == constraints.n_nonzero && factor.n_rows == a.n_rows &&
+      arma::accu(arma::abs(a - constraints)) == 0.0)
+  {
+    return;
+  }
+
+  const arma::mat aat(a * a.t());
+  if (!arma::chol(factor, aat))
+  {
+    constraints.reset();
+    factor.reset();
+    throw std::invalid_argument("ADMMSolver::Optimize(): the constraint "
+        "matrices must be linearly independent.");
+  }
+
+  constraints = a;
+}
+
+inline bool ADMMSolver::NegativePart(const arma::mat& v, arma::mat& negative)
+{
+  arma::vec eigval;
+  arma::mat eigvec;
+  if (!arma::eig_sym(eigval, eigvec, v))
+    return false;
+
+  // The eigenvalues are in ascending order.
+  const arma::uvec indices = arma::find(eigval < 0.0);
+  if (indices.n_elem == 0)
+  {
+    negative.zeros(v.n_rows, v.n_cols);
+    return true;
+  }
+
+  const arma::mat u = eigvec.cols(indices);
+  negative = u * arma::diagmat(eigval.elem(indices)) * u.t();
+  return true;
+}
+
+inline bool ADMMSolver::PartialNegativePart(const arma::mat& v,
+                                            arma::mat& negative)
+{
+  const size_t n = v.n_rows;
+  const size_t k = projectionRank;
+  // A few extra vectors speed up the convergence of the subspace iteration.
+  const size_t p = std::min(n, k + std::max(k, (size_t) 5));
+  if (k == 0 || p >= n)
+    return false;
+
+  if (basis.n_rows != n || basis.n_cols != p)
+    basis.randn(n, p);
+
+  // The eigenvalues of shift * I - v are non-negative, and its largest ones
+  // belong to the most negative eigenvalues of v.
+  const double shift = arma::norm(v, 1);
+  if (shift == 0.0)
+  {
+    negative.zeros(n, n);
+    return true;
+  }
+
+  arma::mat q, r, w, ritz;
+  arma::vec theta;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    if (!arma::qr_econ(q, r, shift * basis - v * basis))
+      return false;
+
+    // Rayleigh-Ritz: the eigenvalues of q^T v q are in ascending order.
+    const arma::mat vq = v * q;
+    if (!arma::eig_sym(theta, w, arma::symmatu(q.t() * vq)))
+      return false;
+
+    ritz = q * w;
+    basis = ritz;
+
+    // The negative part must be spanned by the first k Ritz vectors.
+    const size_t numNegative = arma::accu(theta < 0.0);
+    if (numNegative > k)
+      return false;
+
+    // The first non-negative Ritz pair must have converged too: otherwise a
+    // negative eigenvalue may still hide behind a positive Ritz value.  Since
+    // numNegative <= k < p, that pair always exists.
+    bool converged = true;
+    for (size_t j = 0; j <= numNegative && converged; ++j)
+    {
+      converged = (arma::norm(vq * w.col(j) - theta[j] * ritz.col(j), 2) <=
+          0.1 * tolerance * shift);
+    }
+
+    if (converged)
+    {
+      if (numNegative == 0)
+      {
+        negative.zeros(n, n);
+      }
+      else
+      {
+        const arma::mat u = ritz.head_cols(numNegative);
+        negative = u * arma::diagmat(theta.head(numNegative)) * u.t();
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace ens
+
+#endif
@@ -23,6 +23,40 @@ inline size_t SvecIndex(size_t i, size_t j, size_t n)
   return (j - i) + (n * (n + 1) - (n - i) * (n - i + 1)) / 2;
 }
 
+/**
+ * Return the given dense matrix as-is, without making a copy.
+ *
+ * @param input Dense matrix.
+ */
+template<typename ElemType>
+inline const arma::Mat<ElemType>& DenseView(const arma::Mat<ElemType>& input)
+{
+  return input;
+}
+
+/**
+ * Return the given dense column vector as a matrix, without making a copy.
+ *
+ * @param input Dense column vector.
+ */
+template<typename ElemType>
+inline const arma::Mat<ElemType>& DenseView(const arma::Col<ElemType>& input)
+{
+  return input;
+}
+
+/**
+ * Evaluate the given Armadillo expression into a dense matrix.  This is only
+ * used when the input is not already a dense matrix.
+ *
+ * @param input Armadillo expression or matrix.
+ */
+template<typename ElemType, typename MatType>
+inline arma::Mat<ElemType> DenseView(const MatType& input)
+{
+  return arma::Mat<ElemType>(input);
+}
+
 /**
  * Upper triangular representation of a symmetric matrix, scaled such that,
  * dot(Svec(A), Svec(B)) == dot(A, B) for symmetric A, B. Specifically,
@@ -30,28 +64,28 @@ inline size_t SvecIndex(size_t i, size_t j, size_t n)
  * Svec(K) = [ K_11, sqrt(2) K_12, ..., sqrt(2) K_1n, K_22, ..., sqrt(2)
  * K_2n, ..., K_nn ]^T
  *
+ * If the input is already a dense matrix, it is read in-place; no copy is
+ * made.
+ *
  * @param input A symmetric matrix.
  * @param output Upper triangular representation.
  */
 template<typename MatAType, typename MatBType>
 inline void Svec(const MatAType& input, MatBType& output)
 {
-  MatBType iMat(input);
+  typedef typename MatBType::elem_type ElemType;
+  const arma::Mat<ElemType>& iMat = DenseView<ElemType>(input);
   const size_t n = iMat.n_rows;
   const size_t n2bar = n * (n + 1) / 2;
 
-  output.zeros(n2bar, 1);
+  output.set_size(n2bar, 1);
 
   size_t idx = 0;
   for (size_t i = 0; i < n; i++)
   {
-    for (size_t j = i; j < n; j++)
-    {
-      if (i == j)
-        output(idx++, 0) = iMat(i, j);
-      else
-        output(idx++, 0) = arma::datum::sqrt2 * iMat(i, j);
-    }
+    output(idx++, 0) = iMat(i, i);
+    for (size_t j = i + 1; j < n; j++)
+      output(idx++, 0) = arma::datum::sqrt2 * iMat(i, j);
   }
 }
 
@@ -81,7 +115,8 @@ inline void Svec(const MatAType& input,
 }
 
 /**
- * The inverse of Svec. That is, Smat(Svec(A)) == A.
+ * The inverse of Svec. That is, Smat(Svec(A)) == A.  If the input is already a
+ * dense matrix, it is read in-place; no copy is made.
  *
  * @param input Input matrix.
  * @param output The inverse of the input matrix.
@@ -89,23 +124,20 @@ inline void Svec(const MatAType& input,
 template<typename MatAType, typename MatBType>
 inline void Smat(const MatAType& input, MatBType& output)
 {
-  MatBType iMat(input);
+  typedef typename MatBType::elem_type ElemType;
+  const arma::Mat<ElemType>& iMat = DenseView<ElemType>(input);
 
   const size_t n = static_cast<size_t>
       (ceil((-1. + sqrt(1. + 8. * iMat.n_elem))/2.));
 
-  output.zeros(n, n);
+  output.set_size(n, n);
 
   size_t idx = 0;
   for (size_t i = 0; i < n; i++)
   {
-    for (size_t j = i; j < n; j++)
-    {
-      if (i == j)
-        output(i, j) = iMat(idx++);
-      else
-        output(i, j) = output(j, i) = 0.5 * arma::datum::sqrt2 * iMat(idx++);
-    }
+    output(i, i) = iMat(idx++);
+    for (size_t j = i + 1; j < n; j++)
+      output(i, j) = output(j, i) = 0.5 * arma::datum::sqrt2 * iMat(idx++);
   }
 }
 
@@ -150,6 +182,50 @@ inline void SymKronId(const MatAType& A, MatBType& op)
   }
 }
 
+/**
+ * Compute
+ *
+ *    output == 0.5 * (AX + XA)
+ *
+ * for symmetric A and X, without going through the svec representation.  Only
+ * one product is formed, since XA == (AX)^T.  The output may alias X.
+ *
+ * @param A A symmetric matrix.
+ * @param X A symmetric matrix.
+ * @param output Matrix to store 0.5 * (AX + XA) into.
+ */
+template<typename MatAType, typename MatBType, typename MatCType>
+inline void SymKronIdApplyMat(const MatAType& A,
+                              const MatBType& X,
+                              MatCType& output)
+{
+  const MatCType ax = A * X;
+  output = 0.5 * (ax + ax.t());
+}
+
+/**
+ * Apply the operator given by SymKronId(A) to svec(X) without forming the
+ * operator, which would take O(n^4) memory.  That is, compute
+ *
+ *    output == svec(0.5 * (AX + XA))
+ *
+ * in O(n^3) time and O(n^2) memory.
+ *
+ * @param A A symmetric matrix.
+ * @param x Svec representation of a symmetric matrix X.
+ * @param output Svec representation of 0.5 * (AX + XA).
+ */
+template<typename MatAType, typename MatBType, typename MatCType>
+inline void SymKronIdApply(const MatAType& A,
+                           const MatBType& x,
+                           MatCType& output)
+{
+  arma::Mat<typename MatCType::elem_type> xMat;
+  Smat(x, xMat);
+  SymKronIdApplyMat(A, xMat, xMat);
+  Svec(xMat, output);
+}
+
 } // namespace math
 } // namespace ens
 
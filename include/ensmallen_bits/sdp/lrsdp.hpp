@@ -27,8 +27,24 @@ namespace ens {
  * LRSDP can optimize semidefinite programs.  For more details, see the
  * documentation on function types included with this distribution or on the
  * ensmallen website.
+ *
+ * By default the rank of the solution is fixed to the number of columns of the
+ * initial point.  If MaxRank() is set to a nonzero value, the rank is instead
+ * adapted during optimization: after each solve, small singular directions of
+ * R are truncated, and if the dual certificate
+ *
+ *     S = C - sum_i y_i A_i
+ *
+ * is not positive semidefinite, R is grown by columns along the eigenvectors of
+ * S with negative eigenvalues (up to MaxRank() columns), and the optimization
+ * is restarted from the current R and Lagrange multipliers.  This way the
+ * optimization runs at close to the minimal rank.
+ *
+ * @tparam SDPType Type of SDP to solve.
+ * @tparam InnerOptimizerType Optimizer used by the augmented Lagrangian for
+ *     its inner problems.
  */
-template <typename SDPType>
+template <typename SDPType, typename InnerOptimizerType = L_BFGS>
 class LRSDP
 {
  public:
@@ -86,22 +102,67 @@ class LRSDP
   LRSDPFunction<SDPType>& Function() { return function; }
 
   //! Return the augmented Lagrangian object.
-  const AugLagrangian& AugLag() const { return augLag; }
+  const AugLagrangianType<InnerOptimizerType>& AugLag() const
+  { return augLag; }
   //! Modify the augmented Lagrangian object.
-  AugLagrangian& AugLag() { return augLag; }
+  AugLagrangianType<InnerOptimizerType>& AugLag() { return augLag; }
 
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the maximum rank for rank-adaptive optimization (0 means the rank is
+  //! fixed).
+  size_t MaxRank() const { return maxRank; }
+  //! Modify the maximum rank for rank-adaptive optimization (0 means the rank
+  //! is fixed).
+  size_t& MaxRank() { return maxRank; }
+
+  //! Get the relative singular value tolerance below which directions of R are
+  //! truncated.
+  double RankTolerance() const { return rankTolerance; }
+  //! Modify the relative singular value tolerance below which directions of R
+  //! are truncated.
+  double& RankTolerance() { return rankTolerance; }
+
+  //! Get the tolerance on the smallest eigenvalue of the dual certificate.
+  double CertificateTolerance() const { return certificateTolerance; }
+  //! Modify the tolerance on the smallest eigenvalue of the dual certificate.
+  double& CertificateTolerance() { return certificateTolerance; }
+
+  //! Get the maximum number of rank updates (restarts) in rank-adaptive mode.
+  size_t MaxRankUpdates() const { return maxRankUpdates; }
+  //! Modify the maximum number of rank updates (restarts) in rank-adaptive
+  //! mode.
+  size_t& MaxRankUpdates() { return maxRankUpdates; }
+
  private:
+  /**
+   * Compute the dual certificate S = C - sum_i y_i A_i at the given
+   * coordinates, where y_i are the multiplier estimates of the augmented
+   * Lagrangian.  The R * R^T cache of the function must be up to date.
+   */
+  template<typename MatType>
+  void DualCertificate(const MatType& coordinates,
+                       const arma::vec& lambda,
+                       const double sigma,
+                       MatType& s) const;
+
   //! Augmented lagrangian optimizer.
-  AugLagrangian augLag;
+  AugLagrangianType<InnerOptimizerType> augLag;
   //! Function to optimize, which the AugLagrangian object holds.
   LRSDPFunction<SDPType> function;
   //! The maximum number of iterations for optimization.
   size_t maxIterations;
+  //! The maximum rank in rank-adaptive mode (0 means the rank is fixed).
+  size_t maxRank;
+  //! The relative singular value tolerance for truncating R.
+  double rankTolerance;
+  //! The tolerance on the smallest eigenvalue of the dual certificate.
+  double certificateTolerance;
+  //! The maximum number of rank updates in rank-adaptive mode.
+  size_t maxRankUpdates;
 };
 
 } // namespace ens
@@ -17,18 +17,23 @@
 
 namespace ens {
 
-template<typename SDPType>
-LRSDP<SDPType>::LRSDP(const size_t numSparseConstraints,
-                      const size_t numDenseConstraints,
-                      const arma::Mat<typename SDPType::ElemType>& initialPoint,
-                      const size_t maxIterations) :
+template<typename SDPType, typename InnerOptimizerType>
+LRSDP<SDPType, InnerOptimizerType>::LRSDP(
+    const size_t numSparseConstraints,
+    const size_t numDenseConstraints,
+    const arma::Mat<typename SDPType::ElemType>& initialPoint,
+    const size_t maxIterations) :
     function(numSparseConstraints, numDenseConstraints, initialPoint),
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    maxRank(0),
+    rankTolerance(1e-6),
+    certificateTolerance(1e-5),
+    maxRankUpdates(20)
 { }
 
-template<typename SDPType>
+template<typename SDPType, typename InnerOptimizerType>
 template<typename MatType, typename... CallbackTypes>
-typename MatType::elem_type LRSDP<SDPType>::Optimize(
+typename MatType::elem_type LRSDP<SDPType, InnerOptimizerType>::Optimize(
     MatType& coordinates, CallbackTypes&&... callbacks)
 {
   function.RRTAny().Clean();
@@ -39,9 +44,124 @@ typename MatType::elem_type LRSDP<SDPType>::Optimize(
   augLag.MaxIterations() = maxIterations;
   augLag.Optimize(function, coordinates, callbacks...);
 
+  if (maxRank == 0)
+    return function.Evaluate(coordinates);
+
+  // Rank-adaptive mode.  Each round truncates R to its numerical rank, checks
+  // the dual certificate, and if it is not PSD grows R along the negative
+  // eigendirections of S and warm starts the next solve.
+  for (size_t round = 0; round < maxRankUpdates; ++round)
+  {
+    const arma::vec lambda = augLag.Lambda();
+    const double sigma = augLag.Sigma();
+
+    // Shrink R by truncating small singular directions; R R^T is unchanged up
+    // to the truncated directions.
+    MatType u, v;
+    arma::Col<typename MatType::elem_type> sv;
+    if (arma::svd_econ(u, sv, v, coordinates, "left") && sv.n_elem > 0 &&
+        sv(0) > 0)
+    {
+      const size_t rank = std::max((size_t) 1, (size_t) arma::accu(sv >
+          rankTolerance * sv(0)));
+      if (rank < coordinates.n_cols)
+      {
+        Info << "LRSDP::Optimize(): truncating rank from "
+            << coordinates.n_cols << " to " << rank << "." << std::endl;
+        coordinates = u.cols(0, rank - 1) *
+            arma::diagmat(sv.subvec(0, rank - 1));
+      }
+    }
+
+    function.RRTAny().Clean();
+    function.RRTAny().template Set<MatType>(
+        new MatType(coordinates * coordinates.t()));
+
+    // If S is PSD, (R R^T, y) is an optimal primal-dual pair.
+    MatType s;
+    DualCertificate(coordinates, lambda, sigma, s);
+    arma::Col<typename MatType::elem_type> eigval;
+    MatType eigvec;
+    if (!arma::eig_sym(eigval, eigvec, s))
+    {
+      Warn << "LRSDP::Optimize(): eigendecomposition of the dual certificate "
+          << "failed; terminating rank updates." << std::endl;
+      break;
+    }
+
+    if (eigval(0) >= -certificateTolerance)
+    {
+      Info << "LRSDP::Optimize(): dual certificate is PSD at rank "
+          << coordinates.n_cols << "." << std::endl;
+      break;
+    }
+
+    if (coordinates.n_cols >= maxRank)
+    {
+      Info << "LRSDP::Optimize(): maximum rank " << maxRank << " reached."
+          << std::endl;
+      break;
+    }
+
+    // Grow R by (at most) doubling its rank, with one new column per negative
+    // eigenvalue of S.  The new columns are small steps along the descent
+    // directions given by the corresponding eigenvectors.
+    const size_t numNegative = (size_t) arma::accu(eigval <
+        -certificateTolerance);
+    const size_t numNew = std::min(std::min(numNegative,
+        std::max(coordinates.n_cols, (size_t) 1)),
+        maxRank - coordinates.n_cols);
+    const typename MatType::elem_type scale = 1e-3 *
+        std::max(arma::norm(coordinates, "fro"),
+        (typename MatType::elem_type) 1) / std::sqrt(coordinates.n_rows);
+
+    Info << "LRSDP::Optimize(): dual certificate has smallest eigenvalue "
+        << eigval(0) << "; growing rank from " << coordinates.n_cols << " to "
+        << coordinates.n_cols + numNew << "." << std::endl;
+
+    coordinates = arma::join_rows(coordinates,
+        scale * eigvec.cols(0, numNew - 1));
+
+    function.RRTAny().Clean();
+    function.RRTAny().template Set<MatType>(
+        new MatType(coordinates * coordinates.t()));
+
+    augLag.Optimize(function, coordinates, lambda, sigma, callbacks...);
+  }
+
+  function.RRTAny().Clean();
+  function.RRTAny().template Set<MatType>(
+      new MatType(coordinates * coordinates.t()));
   return function.Evaluate(coordinates);
 }
 
+template<typename SDPType, typename InnerOptimizerType>
+template<typename MatType>
+void LRSDP<SDPType, InnerOptimizerType>::DualCertificate(
+    const MatType& coordinates,
+    const arma::vec& lambda,
+    const double sigma,
+    MatType& s) const
+{
+  // y_i = lambda_i - sigma * (Tr(A_i * (R R^T)) - b_i); see GradientImpl() in
+  // lrsdp_function_impl.hpp.
+  s = MatType(function.SDP().C());
+  for (size_t i = 0; i < function.NumConstraints(); ++i)
+  {
+    const double y = lambda[i] - sigma *
+        function.EvaluateConstraint(i, coordinates);
+    if (i < function.SDP().NumSparseConstraints())
+    {
+      s -= y * function.SDP().SparseA()[i];
+    }
+    else
+    {
+      s -= y * function.SDP().DenseA()[i -
+          function.SDP().NumSparseConstraints()];
+    }
+  }
+}
+
 } // namespace ens
 
 #endif
@@ -0,0 +1,137 @@
+/**
+ * @file lyapunov_solver.hpp
+ *
+ * A solver for the Lyapunov equation AX + XA = H, for symmetric A and H, that
+ * caches the eigendecomposition of A so that many right-hand sides can be
+ * solved against the same A.  See Lemma 7.2 of
+ *
+ *   Primal-dual interior-point methods for semidefinite programming:
+ *   Convergence rates, stability and numerical results.
+ *   Farid Alizadeh, Jean-Pierre Haeberly, and Michael Overton.
+ *   SIAM J. Optim. 1998.
+ *   https://www.cs.nyu.edu/overton/papers/pdffiles/pdsdp.pdf
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_LYAPUNOV_SOLVER_HPP
+#define ENSMALLEN_SDP_LYAPUNOV_SOLVER_HPP
+
+namespace ens {
+
+/**
+ * LyapunovSolver solves AX + XA = H for symmetric A and H.  If A = Q D Q^T is
+ * the eigendecomposition of A, then
+ *
+ *     X = Q ((Q^T H Q) ./ (d_i + d_j)) Q^T,
+ *
+ * so after a single O(n^3) call to Factorize(), each solve only takes matrix
+ * products.  SolveBatch() solves many right-hand sides at once, stored as the
+ * slices of a cube, with four large matrix products in total.
+ *
+ * @tparam MatType Type of matrix to solve with.
+ */
+template<typename MatType = arma::mat>
+class LyapunovSolver
+{
+ public:
+  typedef typename MatType::elem_type ElemType;
+  typedef arma::Cube<ElemType> CubeType;
+
+  /**
+   * Compute and cache the eigendecomposition of the given symmetric matrix.
+   *
+   * @param a Symmetric matrix A of the Lyapunov equation.
+   * @return false if the eigendecomposition failed.
+   */
+  bool Factorize(const MatType& a)
+  {
+    arma::Col<ElemType> eigval;
+    if (!arma::eig_sym(eigval, q, a))
+      return false;
+
+    // The Lyapunov equation has a unique solution if d_i + d_j != 0 for all
+    // i, j; this is always the case for positive definite A.
+    denominators = arma::repmat(eigval, 1, eigval.n_elem) +
+        arma::repmat(eigval.t(), eigval.n_elem, 1);
+    return true;
+  }
+
+  /**
+   * Solve AX + XA = H for the A given to the last call to Factorize().
+   *
+   * @param x Matrix to store the solution X into.
+   * @param h Symmetric right-hand side H.
+   */
+  template<typename HType>
+  void Solve(MatType& x, const HType& h) const
+  {
+    const MatType hq = h * q;
+    const MatType c = (q.t() * hq) / denominators;
+    x = q * c * q.t();
+  }
+
+  /**
+   * Solve AX_k + X_kA = H_k for each slice H_k of the given cube, for the A
+   * given to the last call to Factorize().  The solutions overwrite the
+   * corresponding slices.  Since the slices of a cube are stored
+   * contiguously, all slices are multiplied by the eigenbasis at once.
+   *
+   * @param h Cube of symmetric right-hand sides; overwritten by the solutions.
+   */
+  void SolveBatch(CubeType& h) const
+  {
+    const size_t n = q.n_rows;
+    const size_t k = h.n_slices;
+    if (k == 0)
+      return;
+
+    // View the cube as the n x nk matrix [ H_1 H_2 ... H_k ].  The buffer
+    // matrix is used for the intermediate products.
+    MatType hAll(h.memptr(), n, n * k, false, true);
+    MatType buffer(n, n * k);
+
+    // [ Q^T H_1 ... Q^T H_k ].
+    buffer = q.t() * hAll;
+    // Since H_k is symmetric, (Q^T H_k)^T = H_k Q.
+    TransposeBlocks(buffer, n, k);
+    // [ Q^T H_1 Q ... Q^T H_k Q ], then divide by (d_i + d_j).
+    hAll = q.t() * buffer;
+    for (size_t i = 0; i < k; ++i)
+      hAll.cols(i * n, (i + 1) * n - 1) /= denominators;
+
+    // With C_k the scaled blocks, Q (Q C_k)^T = Q C_k Q^T = X_k since C_k is
+    // symmetric.
+    buffer = q * hAll;
+    TransposeBlocks(buffer, n, k);
+    hAll = q * buffer;
+  }
+
+  //! Get the cached eigenvectors of A.
+  const MatType& Eigenvectors() const { return q; }
+
+ private:
+  //! Transpose each of the k consecutive n x n blocks of the given matrix in
+  //! place.
+  static void TransposeBlocks(MatType& m, const size_t n, const size_t k)
+  {
+    for (size_t b = 0; b < k; ++b)
+    {
+      ElemType* block = m.colptr(b * n);
+      for (size_t j = 0; j < n; ++j)
+        for (size_t i = j + 1; i < n; ++i)
+          std::swap(block[i + j * n], block[j + i * n]);
+    }
+  }
+
+  //! The eigenvectors Q of A.
+  MatType q;
+  //! The matrix of eigenvalue sums d_i + d_j.
+  MatType denominators;
+};
+
+} // namespace ens
+
+#endif
@@ -39,12 +39,22 @@ class PrimalDualSolver
    *      the primal coordinates, Z is the dual coordinates.)
    * @param primalInfeasTol Primal infeasibility tolerance for termination.
    * @param dualInfeasTol Dual infeasibility tolerance for termination.
+   * @param maxSchurIterations Maximum number of iterations of the iterative
+   *      Schur complement solver.  If 0, the m x m Schur complement matrix is
+   *      formed and solved directly, which costs O(m^3) time and O(m^2)
+   *      memory.  Otherwise, the system is solved with preconditioned BiCGSTAB
+   *      using matrix-free products, which is preferable when the number of
+   *      constraints m is large.
+   * @param schurTolerance Relative residual tolerance of the iterative Schur
+   *      complement solver.
    */
   PrimalDualSolver(const size_t maxIterations = 1000,
                    const double tau = 0.99,
                    const double normXzTol = 1e-7,
                    const double primalInfeasTol = 1e-7,
-                   const double dualInfeasTol = 1e-7);
+                   const double dualInfeasTol = 1e-7,
+                   const size_t maxSchurIterations = 0,
+                   const double schurTolerance = 1e-10);
 
   /**
    * Construct a new solver instance from a given SDP instance.  Uses a random,
@@ -180,6 +190,17 @@ class PrimalDualSolver
   //! Modify the dual infeasibility tolerance.
   double& DualInfeasTol() { return dualInfeasTol; }
 
+  //! Get the maximum number of iterative Schur complement solver iterations.
+  size_t MaxSchurIterations() const { return maxSchurIterations; }
+  //! Modify the maximum number of iterative Schur complement solver iterations
+  //! (0 means the Schur complement system is solved directly).
+  size_t& MaxSchurIterations() { return maxSchurIterations; }
+
+  //! Get the tolerance of the iterative Schur complement solver.
+  double SchurTolerance() const { return schurTolerance; }
+  //! Modify the tolerance of the iterative Schur complement solver.
+  double& SchurTolerance() { return schurTolerance; }
+
  private:
   /**
    * These are deprecated and will be removed in ensmallen 2.10.0.
@@ -205,6 +226,13 @@ class PrimalDualSolver
 
   //! The tolerance required on the dual constraint required before terminating.
   double dualInfeasTol;
+
+  //! The maximum number of iterations of the iterative Schur complement
+  //! solver; 0 means the system is solved directly.
+  size_t maxSchurIterations;
+
+  //! The relative residual tolerance of the iterative Schur complement solver.
+  double schurTolerance;
 };
 
 } // namespace ens
@@ -31,6 +31,7 @@
 
 #include "primal_dual.hpp"
 #include "lin_alg.hpp"
+#include "lyapunov_solver.hpp"
 
 namespace ens {
 
@@ -47,7 +48,9 @@ PrimalDualSolver<DeprecatedSDPType>::PrimalDualSolver(
     tau(0.99),
     normXzTol(1e-7),
     primalInfeasTol(1e-7),
-    dualInfeasTol(1e-7)
+    dualInfeasTol(1e-7),
+    maxSchurIterations(0),
+    schurTolerance(1e-10)
 { /* Nothing to do. */ }
 
 template<typename DeprecatedSDPType>
@@ -67,7 +70,9 @@ PrimalDualSolver<DeprecatedSDPType>::PrimalDualSolver(
     tau(0.99),
     normXzTol(1e-7),
     primalInfeasTol(1e-7),
-    dualInfeasTol(1e-7)
+    dualInfeasTol(1e-7),
+    maxSchurIterations(0),
+    schurTolerance(1e-10)
 {
   // Nothing to do.
 }
@@ -78,12 +83,16 @@ PrimalDualSolver<DeprecatedSDPType>::PrimalDualSolver(
     const double tau,
     const double normXzTol,
     const double primalInfeasTol,
-    const double dualInfeasTol) :
+    const double dualInfeasTol,
+    const size_t maxSchurIterations,
+    const double schurTolerance) :
     maxIterations(maxIterations),
     tau(tau),
     normXzTol(normXzTol),
     primalInfeasTol(primalInfeasTol),
-    dualInfeasTol(dualInfeasTol)
+    dualInfeasTol(dualInfeasTol),
+    maxSchurIterations(maxSchurIterations),
+    schurTolerance(schurTolerance)
 {
   // Nothing to do.
 }
@@ -127,22 +136,124 @@ Alpha(const MatType& a, const MatType& dA, double tau, double& alpha)
 }
 
 /**
- * Solve the following Lyapunov equation (for X)
+ * Compute the product of the Schur complement matrix (2.15)
  *
- *   AX + XA = H
- *
- * where A, H are symmetric matrices.
- *
- * TODO(stephentu): Note this method current uses arma's builtin arma::syl
- * method, which is overkill for this situation. See Lemma 7.2 of [AHO98] for
- * how to solve this Lyapunov equation using an eigenvalue decomposition of A.
+ *     M = A E^(-1) F A^T
  *
+ * with the vector v, without forming M.  This costs one Lyapunov solve and
+ * O(n^3 + nnz(A)) work.
  */
-template<typename MatType, typename AType, typename BType>
+template<typename MatType,
+         typename SparseConstraintType,
+         typename DenseConstraintType>
 static inline void
-SolveLyapunov(MatType& x, const AType& a, const BType& h)
+SchurProduct(const SparseConstraintType& aSparse,
+             const DenseConstraintType& aDense,
+             const MatType& coordinates,
+             const LyapunovSolver<MatType>& lyapunov,
+             const MatType& v,
+             MatType& out)
 {
-  arma::syl(x, a, a, -h);
+  const size_t numConstraints = aSparse.n_rows + aDense.n_rows;
+
+  MatType aTv(aSparse.n_cols, 1);
+  aTv.zeros();
+  if (aSparse.n_rows)
+    aTv += aSparse.t() * v.rows(0, aSparse.n_rows - 1);
+  if (aDense.n_rows)
+    aTv += aDense.t() * v.rows(aSparse.n_rows, numConstraints - 1);
+
+  MatType aTvMat, faTvMat, gMat, g;
+  math::Smat(aTv, aTvMat);
+  math::SymKronIdApplyMat(coordinates, aTvMat, faTvMat);
+  lyapunov.Solve(gMat, 2. * faTvMat);
+  math::Svec(gMat, g);
+
+  out.set_size(numConstraints, 1);
+  if (aSparse.n_rows)
+    out.rows(0, aSparse.n_rows - 1) = aSparse * g;
+  if (aDense.n_rows)
+    out.rows(aSparse.n_rows, numConstraints - 1) = aDense * g;
+}
+
+/**
+ * Solve the Schur complement system M dy = rhs iteratively, using products
+ * computed by SchurProduct() and the diagonal (Jacobi) preconditioner given in
+ * schurDiag.  Since M is not symmetric for the XZ+ZX direction, BiCGSTAB is
+ * used instead of conjugate gradients.  The input value of dy is used as the
+ * initial guess.
+ *
+ * @return false if the given tolerance was not reached.
+ */
+template<typename MatType,
+         typename SparseConstraintType,
+         typename DenseConstraintType>
+static inline bool
+SolveSchurSystem(const SparseConstraintType& aSparse,
+                 const DenseConstraintType& aDense,
+                 const MatType& coordinates,
+                 const LyapunovSolver<MatType>& lyapunov,
+                 const MatType& schurDiag,
+                 const MatType& rhs,
+                 const size_t maxIterations,
+                 const double tolerance,
+                 MatType& dy)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  if (dy.n_rows != rhs.n_rows || dy.n_cols != 1)
+    dy.zeros(rhs.n_rows, 1);
+
+  const ElemType normRhs = arma::norm(rhs, 2);
+  if (normRhs == 0)
+  {
+    dy.zeros();
+    return true;
+  }
+
+  MatType r, rHat, p, v, y, s, z, t;
+  SchurProduct(aSparse, aDense, coordinates, lyapunov, dy, v);
+  r = rhs - v;
+  if (arma::norm(r, 2) <= tolerance * normRhs)
+    return true;
+
+  rHat = r;
+  p.zeros(rhs.n_rows, 1);
+  v.zeros(rhs.n_rows, 1);
+  ElemType rho = 1, alpha = 1, omega = 1;
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    const ElemType rhoNew = arma::dot(rHat, r);
+    if (rhoNew == 0)
+      return false;
+
+    const ElemType beta = (rhoNew / rho) * (alpha / omega);
+    p = r + beta * (p - omega * v);
+    rho = rhoNew;
+
+    y = p / schurDiag;
+    SchurProduct(aSparse, aDense, coordinates, lyapunov, y, v);
+    alpha = rho / arma::dot(rHat, v);
+
+    dy += alpha * y;
+    s = r - alpha * v;
+    if (arma::norm(s, 2) <= tolerance * normRhs)
+      return true;
+
+    z = s / schurDiag;
+    SchurProduct(aSparse, aDense, coordinates, lyapunov, z, t);
+    const ElemType tt = arma::dot(t, t);
+    if (tt == 0)
+      return false;
+
+    omega = arma::dot(t, s) / tt;
+    dy += omega * z;
+    r = s - omega * t;
+    if (arma::norm(r, 2) <= tolerance * normRhs)
+      return true;
+  }
+
+  return false;
 }
 
 /**
@@ -161,6 +272,13 @@ SolveLyapunov(MatType& x, const AType& a, const BType& h)
  *     E  = Z sym I
  *     F  = X sym I
  *
+ * The operator F is never formed explicitly (it is n2bar x n2bar, so O(n^4)
+ * memory); it is applied in matrix form with math::SymKronIdApplyMat().  The
+ * complementarity residual rc is passed in matrix form as rcMat.
+ *
+ * If maxSchurIterations is 0, the Schur complement system is solved directly
+ * with the given matrix m.  Otherwise, it is solved with SolveSchurSystem(),
+ * m is ignored, and the input value of dy is used as a warm start.
  */
 template<typename MatType,
          typename SparseConstraintType,
@@ -168,26 +286,33 @@ template<typename MatType,
 static inline void
 SolveKKTSystem(const SparseConstraintType& aSparse,
                const DenseConstraintType& aDense,
-               const MatType& dualCoordinates,
+               const MatType& coordinates,
+               const LyapunovSolver<MatType>& lyapunov,
                const MatType& m,
-               const MatType& fMat,
+               const MatType& schurDiag,
+               const size_t maxSchurIterations,
+               const double schurTolerance,
                const MatType& rp,
                const MatType& rd,
-               const MatType& rc,
+               const MatType& rcMat,
+               MatType& dy,
                MatType& dsX,
                MatType& dySparse,
                MatType& dyDense,
                MatType& dsZ)
 {
-  MatType frdRcMat, eInvFrdRcMat, eInvFrdATdyRcMat, frdATdyRcMat;
-  MatType eInvFrdRc, eInvFrdATdyRc, dy;
+  MatType rdMat, frdRcMat, eInvFrdRcMat, eInvFrdATdyRcMat, frdATdyRcMat;
+  MatType eInvFrdRc, eInvFrdATdyRc;
 
   // Note: Whenever a formula calls for E^(-1) v for some v, we solve Lyapunov
-  // equations instead of forming an explicit inverse.
+  // equations (using the cached eigendecomposition of Z) instead of forming an
+  // explicit inverse.
 
   // Compute the RHS of (2.12)
-  math::Smat(fMat * rd - rc, frdRcMat);
-  SolveLyapunov(eInvFrdRcMat, dualCoordinates, 2. * frdRcMat);
+  math::Smat(rd, rdMat);
+  math::SymKronIdApplyMat(coordinates, rdMat, frdRcMat);
+  frdRcMat -= rcMat;
+  lyapunov.Solve(eInvFrdRcMat, 2. * frdRcMat);
   math::Svec(eInvFrdRcMat, eInvFrdRc);
 
   MatType rhs = rp;
@@ -197,10 +322,28 @@ SolveKKTSystem(const SparseConstraintType& aSparse,
   if (aDense.n_rows)
     rhs(arma::span(aSparse.n_rows, numConstraints - 1), 0) += aDense * eInvFrdRc;
 
-  if (!arma::solve(dy, m, rhs, arma::solve_opts::fast))
+  if (maxSchurIterations == 0)
   {
-    throw std::logic_error("PrimalDualSolver::SolveKKTSystem(): Could not "
-        "solve KKT system.");
+    if (!arma::solve(dy, m, rhs, arma::solve_opts::fast))
+    {
+      throw std::logic_error("PrimalDualSolver::SolveKKTSystem(): Could not "
+          "solve KKT system.");
+    }
+  }
+  else if (!SolveSchurSystem(aSparse, aDense, coordinates, lyapunov,
+      schurDiag, rhs, maxSchurIterations, schurTolerance, dy))
+  {
+    if (!dy.is_finite())
+    {
+      throw std::logic_error("PrimalDualSolver::SolveKKTSystem(): Could not "
+          "solve KKT system.");
+    }
+
+    // An inexact search direction is still usable; the step lengths are
+    // computed from the resulting dX and dZ anyway.
+    Warn << "PrimalDualSolver::SolveKKTSystem(): iterative Schur complement "
+        << "solve did not reach tolerance " << schurTolerance << " in "
+        << maxSchurIterations << " iterations." << std::endl;
   }
 
   MatType subTerm(aSparse.n_cols, 1);
@@ -217,9 +360,10 @@ SolveKKTSystem(const SparseConstraintType& aSparse,
   }
 
   // Compute dx from (2.13)
-  math::Smat(fMat * (rd - subTerm) - rc,
-      frdATdyRcMat);
-  SolveLyapunov(eInvFrdATdyRcMat, dualCoordinates, 2. * frdATdyRcMat);
+  math::Smat(rd - subTerm, rdMat);
+  math::SymKronIdApplyMat(coordinates, rdMat, frdATdyRcMat);
+  frdATdyRcMat -= rcMat;
+  lyapunov.Solve(eInvFrdATdyRcMat, 2. * frdATdyRcMat);
   math::Svec(eInvFrdATdyRcMat, eInvFrdATdyRc);
   dsX = -eInvFrdATdyRc;
 
@@ -374,16 +518,20 @@ typename MatType::elem_type PrimalDualSolver<DeprecatedSDPType>::Optimize(
   math::Svec(coordinates, sx);
   math::Svec(dualCoordinates, sz);
 
-  MatType rp, rd, rc, gk;
+  MatType rp, rd, gk;
 
-  MatType rcMat, fMat, eInvFaSparseT, eInvFaDenseT, gkMat,
-      m, dualCheck;
+  MatType rcMat, m, schurDiag, dy, dualCheck;
 
-  rp.set_size(sdp.NumConstraints(), 1);
+  // The eigendecomposition of Z is computed once per iteration and shared by
+  // all Lyapunov solves against it.
+  LyapunovSolver<MatType> lyapunov;
+  typename LyapunovSolver<MatType>::CubeType gkCube;
 
-  eInvFaSparseT.set_size(n2bar, sdp.NumSparseConstraints());
-  eInvFaDenseT.set_size(n2bar, sdp.NumDenseConstraints());
-  m.set_size(sdp.NumConstraints(), sdp.NumConstraints());
+  rp.set_size(sdp.NumConstraints(), 1);
+  if (maxSchurIterations == 0)
+    m.set_size(sdp.NumConstraints(), sdp.NumConstraints());
+  else
+    schurDiag.set_size(sdp.NumConstraints(), 1);
 
   // Controls early termination of the optimization process.
   bool terminate = false;
@@ -414,60 +562,101 @@ typename MatType::elem_type PrimalDualSolver<DeprecatedSDPType>::Optimize(
     // Rd = C - Z - smat A^T y
     rd = sc - sz - aSparse.t() * ySparse - aDense.t() * yDense;
 
-    math::SymKronId(coordinates, fMat);
-
-    // We compute E^(-1) F A^T by solving Lyapunov equations.
-    // See (2.16).
-    for (size_t i = 0; i < sdp.NumSparseConstraints(); i++)
+    if (!lyapunov.Factorize(dualCoordinates))
     {
-      SolveLyapunov(gkMat, dualCoordinates, coordinates * sdp.SparseA()[i] +
-          sdp.SparseA()[i] * coordinates);
-      math::Svec(gkMat, gk);
-      eInvFaSparseT.col(i) = gk;
-    }
+      Warn << "PrimalDualSolver::Optimize(): eigendecomposition of Z "
+          << "failed!  Terminating optimization.";
 
-    for (size_t i = 0; i < sdp.NumDenseConstraints(); i++)
-    {
-      SolveLyapunov(gkMat, dualCoordinates, coordinates * sdp.DenseA()[i] +
-          sdp.DenseA()[i] * coordinates);
-      math::Svec(gkMat, gk);
-      eInvFaDenseT.col(i) = gk;
+      Callback::EndOptimization(*this, sdp, coordinates, callbacks...);
+      return primalObj;
     }
 
-    // Form the M = A E^(-1) F A^T matrix (2.15)
-    //
-    // Since we split A up into its sparse and dense components,
-    // we have to handle each block separately.
-    if (sdp.NumSparseConstraints())
+    if (maxSchurIterations == 0)
     {
-      m.submat(arma::span(0, sdp.NumSparseConstraints() - 1),
-               arma::span(0, sdp.NumSparseConstraints() - 1)) =
-          aSparse * eInvFaSparseT;
-      if (sdp.NumDenseConstraints())
+      // We compute E^(-1) F A^T by solving Lyapunov equations (see (2.16)), and
+      // form the M = A E^(-1) F A^T matrix (2.15) a block of columns at a
+      // time.  This way neither F nor E^(-1) F A^T (which is n2bar x m) is
+      // ever stored, and each block of Lyapunov equations is solved with a
+      // few large matrix products.
+      //
+      // Since we split A up into its sparse and dense components, we have to
+      // handle each block separately.
+      const size_t blockSize = std::min(sdp.NumConstraints(), (size_t) 32);
+      for (size_t begin = 0; begin < sdp.NumConstraints(); begin += blockSize)
       {
-        m.submat(arma::span(0, sdp.NumSparseConstraints() - 1),
-                 arma::span(sdp.NumSparseConstraints(),
-                            sdp.NumConstraints() - 1)) =
-            aSparse * eInvFaDenseT;
+        const size_t end = std::min(begin + blockSize, sdp.NumConstraints());
+        gkCube.set_size(n, n, end - begin);
+        for (size_t i = begin; i < end; i++)
+        {
+          if (i < sdp.NumSparseConstraints())
+          {
+            const typename SDPType::SparseConstraintType& ai =
+                sdp.SparseA()[i];
+            gkCube.slice(i - begin) = coordinates * ai + ai * coordinates;
+          }
+          else
+          {
+            const typename SDPType::DenseConstraintType& ai =
+                sdp.DenseA()[i - sdp.NumSparseConstraints()];
+            gkCube.slice(i - begin) = coordinates * ai + ai * coordinates;
+          }
+        }
+
+        lyapunov.SolveBatch(gkCube);
+
+        for (size_t i = begin; i < end; i++)
+        {
+          math::Svec(gkCube.slice(i - begin), gk);
+
+          if (sdp.NumSparseConstraints())
+          {
+            m.submat(0, i, sdp.NumSparseConstraints() - 1, i) = aSparse * gk;
+          }
+          if (sdp.NumDenseConstraints())
+          {
+            m.submat(sdp.NumSparseConstraints(), i,
+                     sdp.NumConstraints() - 1, i) = aDense * gk;
+          }
+        }
       }
     }
-    if (sdp.NumDenseConstraints())
+    else
     {
-      if (sdp.NumSparseConstraints())
+      // M is never formed; we only need a diagonal preconditioner for it.  We
+      // use the diagonal of the Schur complement of the HKM direction,
+      //
+      //     M_ii ~= tr(A_i X A_i Z^(-1)),
+      //
+      // which is close to the diagonal of (2.15) near the central path.  It
+      // costs O(nnz(A_i) n) per sparse constraint, but O(n^3) per dense
+      // constraint (two dense matrix products), plus one O(n^3) inversion.
+      MatType zInv;
+      if (!arma::inv_sympd(zInv, dualCoordinates))
+        zInv = arma::pinv(dualCoordinates);
+
+      for (size_t i = 0; i < sdp.NumConstraints(); i++)
       {
-        m.submat(arma::span(sdp.NumSparseConstraints(),
-                            sdp.NumConstraints() - 1),
-                 arma::span(0,
-                            sdp.NumSparseConstraints() - 1)) =
-            aDense * eInvFaSparseT;
+        MatType aiX, aiZInv;
+        if (i < sdp.NumSparseConstraints())
+        {
+          aiX = sdp.SparseA()[i] * coordinates;
+          aiZInv = sdp.SparseA()[i] * zInv;
+        }
+        else
+        {
+          aiX = sdp.DenseA()[i - sdp.NumSparseConstraints()] * coordinates;
+          aiZInv = sdp.DenseA()[i - sdp.NumSparseConstraints()] * zInv;
+        }
+
+        const typename MatType::elem_type d = arma::accu(aiX % aiZInv.t());
+        schurDiag(i) = (d > 0) ? d : 1;
       }
-      m.submat(arma::span(sdp.NumSparseConstraints(),
-                          sdp.NumConstraints() - 1),
-               arma::span(sdp.NumSparseConstraints(),
-                          sdp.NumConstraints() - 1)) =
-          aDense * eInvFaDenseT;
     }
 
+    // The predictor solve starts from scratch; the corrector solve is warm
+    // started from the predictor's solution.
+    dy.zeros(sdp.NumConstraints(), 1);
+
     const typename MatType::elem_type sxdotsz = arma::dot(sx, sz);
 
     // TODO(stephentu): computing these alphahats should take advantage of
@@ -475,10 +664,11 @@ typename MatType::elem_type PrimalDualSolver<DeprecatedSDPType>::Optimize(
     // when we use more efficient methods above.
 
     // This solves step (1) of Section 7, the "predictor" step.
-    rcMat = -0.5 * (coordinates * dualCoordinates + dualCoordinates * coordinates);
-    math::Svec(rcMat, rc);
-    SolveKKTSystem(aSparse, aDense, dualCoordinates, m, fMat, rp, rd, rc, dsx,
-        dySparse, dyDense, dsz);
+    math::SymKronIdApplyMat(coordinates, dualCoordinates, rcMat);
+    rcMat *= -1.;
+    SolveKKTSystem(aSparse, aDense, coordinates, lyapunov, m, schurDiag,
+        maxSchurIterations, schurTolerance, rp, rd, rcMat, dy, dsx, dySparse,
+        dyDense, dsz);
     math::Smat(dsx, dX);
     math::Smat(dsz, dZ);
 
@@ -515,9 +705,9 @@ typename MatType::elem_type PrimalDualSolver<DeprecatedSDPType>::Optimize(
          dualCoordinates * coordinates +
          dX * dZ +
          dZ * dX);
-    math::Svec(rcMat, rc);
-    SolveKKTSystem(aSparse, aDense, dualCoordinates, m, fMat, rp, rd, rc, dsx,
-        dySparse, dyDense, dsz);
+    SolveKKTSystem(aSparse, aDense, coordinates, lyapunov, m, schurDiag,
+        maxSchurIterations, schurTolerance, rp, rd, rcMat, dy, dsx, dySparse,
+        dyDense, dsz);
     math::Smat(dsx, dX);
     math::Smat(dsz, dZ);
     if (!Alpha(coordinates, dX, tau, alpha))
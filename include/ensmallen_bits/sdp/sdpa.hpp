@@ -0,0 +1,75 @@
+/**
+ * @file sdpa.hpp
+ *
+ * Reading and writing semidefinite programs in the sparse SDPA format.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_SDPA_HPP
+#define ENSMALLEN_SDP_SDPA_HPP
+
+#include "sdp.hpp"
+
+namespace ens {
+
+/**
+ * Load an SDP from a file in the sparse SDPA format (.dat-s).  An SDPA file
+ * describes the problem
+ *
+ *     max    dot(F0, Y)
+ *     s.t.   dot(Fi, Y) = ci, i=1,...,m, Y >= 0,
+ *
+ * which is stored as the SDP<> with C = -F0, Ai = Fi and bi = ci; the optimal
+ * objective of the SDP<> is therefore the negated SDPA optimum.  All the
+ * constraints are stored as sparse constraints.  Block-diagonal problems are
+ * stored as one matrix; the blocks (and the diagonal, linear programming,
+ * blocks) are placed along the diagonal.  Since the objective and constraints
+ * do not involve the entries outside of the blocks, this gives an equivalent
+ * problem.
+ *
+ * The file is parsed in a single pass, and each constraint matrix is then
+ * built at once in compressed sparse column form (in parallel, when OpenMP is
+ * enabled) and moved into the SDP.
+ *
+ * If cacheFilename is not empty, the parsed SDP is stored in that file in
+ * Armadillo's binary format, and later calls load it from there instead of
+ * parsing the SDPA file again.  The cache is keyed on the size and a hash of
+ * the contents of the SDPA file, and is ignored (and rewritten) if either
+ * changed since the cache was written.
+ *
+ * A std::runtime_error is thrown if the file cannot be read or is malformed.
+ *
+ * @tparam SDPType Type of SDP to load into.
+ * @param filename Name of the SDPA file.
+ * @param sdp SDP to store the problem into.
+ * @param cacheFilename Name of the binary cache file (empty for no cache).
+ */
+template<typename SDPType>
+void LoadSDPA(const std::string& filename,
+              SDPType& sdp,
+              const std::string& cacheFilename = "");
+
+/**
+ * Save an SDP to a file in the sparse SDPA format (.dat-s), as a single block;
+ * see LoadSDPA() for the correspondence between the two forms.  The sparse
+ * constraints are written first, followed by the dense constraints.  Only
+ * the upper triangles of the (symmetric) matrices are written.
+ *
+ * A std::runtime_error is thrown if the file cannot be written.
+ *
+ * @tparam SDPType Type of SDP to save.
+ * @param filename Name of the SDPA file.
+ * @param sdp SDP to save.
+ */
+template<typename SDPType>
+void SaveSDPA(const std::string& filename, const SDPType& sdp);
+
+} // namespace ens
+
+// Include implementation.
+#include "sdpa_impl.hpp"
+
+#endif
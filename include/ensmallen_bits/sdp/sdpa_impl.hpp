@@ -0,0 +1,394 @@
+/**
+ * @file sdpa_impl.hpp
+ *
+ * Implementation of the SDPA reader and writer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SDP_SDPA_IMPL_HPP
+#define ENSMALLEN_SDP_SDPA_IMPL_HPP
+
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+
+// In case it hasn't been included yet.
+#include "sdpa.hpp"
+
+namespace ens {
+
+/**
+ * Skip whitespace and the punctuation that SDPA files may use as separators
+ * ("{2, -3}").  Return false at the end of the input.
+ */
+inline bool SDPASkipSeparators(const char*& p)
+{
+  while (*p != '\0' && (std::isspace((unsigned char) *p) || *p == ',' ||
+      *p == '(' || *p == ')' || *p == '{' || *p == '}'))
+  {
+    ++p;
+  }
+
+  return (*p != '\0');
+}
+
+//! Skip the rest of the current line (SDPA headers may end with comments).
+inline void SDPASkipLine(const char*& p)
+{
+  while (*p != '\0' && *p != '\n')
+    ++p;
+}
+
+//! Read one integer, or throw if there is none.
+inline long SDPAReadInteger(const char*& p,
+                            const std::string& filename)
+{
+  char* end = NULL;
+  const long value = SDPASkipSeparators(p) ? std::strtol(p, &end, 10) : 0;
+  if (end == NULL || end == p)
+  {
+    throw std::runtime_error("LoadSDPA(): expected an integer in '" +
+        filename + "'.");
+  }
+
+  p = end;
+  return value;
+}
+
+//! Read one floating-point number, or throw if there is none.
+inline double SDPAReadDouble(const char*& p,
+                             const std::string& filename)
+{
+  char* end = NULL;
+  const double value = SDPASkipSeparators(p) ? std::strtod(p, &end) : 0.0;
+  if (end == NULL || end == p)
+  {
+    throw std::runtime_error("LoadSDPA(): expected a number in '" + filename +
+        "'.");
+  }
+
+  p = end;
+  return value;
+}
+
+//! Hash the contents of an SDPA file (64-bit FNV-1a), to key the cache.
+inline unsigned long long SDPAHash(const std::string& buffer)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < buffer.size(); ++i)
+  {
+    hash ^= (unsigned char) buffer[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * Load the SDP from the given binary cache, if it exists and was written for
+ * an SDPA file of the given size and contents hash.  Return false otherwise.
+ */
+template<typename SDPType>
+inline bool SDPALoadCache(const std::string& cacheFilename,
+                          const unsigned long long sourceSize,
+                          const unsigned long long sourceHash,
+                          SDPType& sdp)
+{
+  std::ifstream in(cacheFilename.c_str(), std::ios::binary);
+  if (!in.is_open())
+    return false;
+
+  char magic[8];
+  unsigned long long size = 0, hash = 0, numConstraints = 0;
+  in.read(magic, 8);
+  in.read((char*) &size, sizeof(size));
+  in.read((char*) &hash, sizeof(hash));
+  in.read((char*) &numConstraints, sizeof(numConstraints));
+  if (!in || std::string(magic, 8) != "ENSSDPA2" || size != sourceSize ||
+      hash != sourceHash)
+  {
+    return false;
+  }
+
+  arma::vec b;
+  arma::sp_mat c;
+  if (!b.load(in, arma::arma_binary) || !c.load(in, arma::arma_binary))
+    return false;
+
+  std::vector<typename SDPType::SparseConstraintType> a(numConstraints);
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    if (!a[i].load(in, arma::arma_binary))
+      return false;
+  }
+
+  sdp.C() = typename SDPType::ObjectiveType(c);
+  sdp.SparseA() = std::move(a);
+  sdp.SparseB() = b;
+  sdp.DenseA().clear();
+  sdp.DenseB().reset();
+  return true;
+}
+
+//! Write the SDP to the given binary cache.
+template<typename SDPType>
+inline void SDPASaveCache(const std::string& cacheFilename,
+                          const unsigned long long sourceSize,
+                          const unsigned long long sourceHash,
+                          const SDPType& sdp)
+{
+  std::ofstream out(cacheFilename.c_str(), std::ios::binary);
+  const unsigned long long numConstraints = sdp.NumSparseConstraints();
+  out.write("ENSSDPA2", 8);
+  out.write((const char*) &sourceSize, sizeof(sourceSize));
+  out.write((const char*) &sourceHash, sizeof(sourceHash));
+  out.write((const char*) &numConstraints, sizeof(numConstraints));
+
+  bool success = out.good();
+  success = success && arma::vec(sdp.SparseB()).save(out, arma::arma_binary);
+  success = success && arma::sp_mat(sdp.C()).save(out, arma::arma_binary);
+  for (size_t i = 0; i < sdp.NumSparseConstraints() && success; ++i)
+    success = sdp.SparseA()[i].save(out, arma::arma_binary);
+
+  if (!success)
+  {
+    Warn << "LoadSDPA(): could not write cache file '" << cacheFilename
+        << "'." << std::endl;
+  }
+}
+
+template<typename SDPType>
+void LoadSDPA(const std::string& filename,
+              SDPType& sdp,
+              const std::string& cacheFilename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+  if (!in.is_open())
+  {
+    throw std::runtime_error("LoadSDPA(): could not open '" + filename +
+        "'.");
+  }
+
+  const unsigned long long sourceSize = (unsigned long long) in.tellg();
+
+  // Read the whole file at once.
+  std::string buffer(sourceSize, '\0');
+  in.seekg(0);
+  in.read(&buffer[0], sourceSize);
+  if (!in)
+  {
+    throw std::runtime_error("LoadSDPA(): could not read '" + filename +
+        "'.");
+  }
+
+  // The cache is keyed on the contents of the file; hashing is much cheaper
+  // than parsing.
+  const unsigned long long sourceHash = cacheFilename.empty() ? 0 :
+      SDPAHash(buffer);
+  if (!cacheFilename.empty() &&
+      SDPALoadCache(cacheFilename, sourceSize, sourceHash, sdp))
+  {
+    return;
+  }
+
+  // Skip the comment lines at the top of the file.
+  const char* p = buffer.c_str();
+  while (SDPASkipSeparators(p) && (*p == '"' || *p == '*'))
+    SDPASkipLine(p);
+
+  const long numConstraints = SDPAReadInteger(p, filename);
+  SDPASkipLine(p);
+  const long numBlocks = SDPAReadInteger(p, filename);
+  SDPASkipLine(p);
+  if (numConstraints < 0 || numBlocks <= 0)
+  {
+    throw std::runtime_error("LoadSDPA(): invalid problem dimensions in '" +
+        filename + "'.");
+  }
+
+  // Block k starts at row offsets[k]; negative sizes denote diagonal blocks.
+  std::vector<long> blockSizes(numBlocks);
+  std::vector<size_t> offsets(numBlocks + 1, 0);
+  for (long k = 0; k < numBlocks; ++k)
+  {
+    blockSizes[k] = SDPAReadInteger(p, filename);
+    if (blockSizes[k] == 0)
+    {
+      throw std::runtime_error("LoadSDPA(): invalid block size in '" +
+          filename + "'.");
+    }
+
+    offsets[k + 1] = offsets[k] + std::abs(blockSizes[k]);
+  }
+  SDPASkipLine(p);
+  const size_t n = offsets[numBlocks];
+
+  arma::vec b(numConstraints);
+  for (long i = 0; i < numConstraints; ++i)
+    b[i] = SDPAReadDouble(p, filename);
+  SDPASkipLine(p);
+
+  // Read the entries "matrix block row column value" in one pass.
+  std::vector<size_t> matrixIndices;
+  std::vector<arma::uword> rows, cols;
+  std::vector<double> values;
+  std::vector<size_t> counts(numConstraints + 2, 0);
+  while (SDPASkipSeparators(p))
+  {
+    const long matrix = SDPAReadInteger(p, filename);
+    const long block = SDPAReadInteger(p, filename) - 1;
+    long i = SDPAReadInteger(p, filename) - 1;
+    long j = SDPAReadInteger(p, filename) - 1;
+    const double value = SDPAReadDouble(p, filename);
+
+    if (i > j)
+      std::swap(i, j);
+
+    if (matrix < 0 || matrix > numConstraints || block < 0 ||
+        block >= numBlocks || i < 0 || j >= std::abs(blockSizes[block]) ||
+        (blockSizes[block] < 0 && i != j))
+    {
+      throw std::runtime_error("LoadSDPA(): invalid entry in '" + filename +
+          "'.");
+    }
+
+    matrixIndices.push_back(matrix);
+    rows.push_back(offsets[block] + i);
+    cols.push_back(offsets[block] + j);
+    values.push_back(value);
+    ++counts[matrix + 1];
+  }
+
+  // Group the entries by matrix with a counting sort.
+  for (long k = 0; k <= numConstraints; ++k)
+    counts[k + 1] += counts[k];
+
+  std::vector<size_t> order(values.size());
+  std::vector<size_t> next(counts.begin(), counts.end() - 1);
+  for (size_t e = 0; e < values.size(); ++e)
+    order[next[matrixIndices[e]]++] = e;
+
+  // Build each matrix in compressed sparse column form at once; the upper
+  // triangle is mirrored into the lower triangle.
+  std::vector<arma::sp_mat> matrices(numConstraints + 1);
+  ENS_PRAGMA_OMP_PARALLEL_FOR
+  for (ptrdiff_t k = 0; k < (ptrdiff_t) matrices.size(); ++k)
+  {
+    size_t count = 0;
+    for (size_t e = counts[k]; e < counts[k + 1]; ++e)
+      count += (rows[order[e]] == cols[order[e]]) ? 1 : 2;
+
+    arma::umat locations(2, count);
+    arma::vec entries(count);
+    size_t l = 0;
+    for (size_t e = counts[k]; e < counts[k + 1]; ++e)
+    {
+      const size_t s = order[e];
+      locations(0, l) = rows[s];
+      locations(1, l) = cols[s];
+      entries[l++] = values[s];
+      if (rows[s] != cols[s])
+      {
+        locations(0, l) = cols[s];
+        locations(1, l) = rows[s];
+        entries[l++] = values[s];
+      }
+    }
+
+    // Repeated entries are summed.
+    matrices[k] = arma::sp_mat(true, locations, entries, n, n);
+  }
+
+  // The SDPA objective is maximized.
+  sdp.C() = typename SDPType::ObjectiveType(-matrices[0]);
+  sdp.SparseA().assign(std::make_move_iterator(matrices.begin() + 1),
+      std::make_move_iterator(matrices.end()));
+  sdp.SparseB() = b;
+  sdp.DenseA().clear();
+  sdp.DenseB().reset();
+
+  if (!cacheFilename.empty())
+    SDPASaveCache(cacheFilename, sourceSize, sourceHash, sdp);
+}
+
+//! Write the upper triangle of a sparse matrix as SDPA entries.
+template<typename ElemType>
+inline void SDPAWriteMatrix(std::ostream& out,
+                            const size_t index,
+                            const arma::SpMat<ElemType>& matrix,
+                            const double scale)
+{
+  for (auto it = matrix.begin(); it != matrix.end(); ++it)
+  {
+    if (it.row() <= it.col() && (*it) != ElemType(0))
+    {
+      out << index << " 1 " << (it.row() + 1) << " " << (it.col() + 1) << " "
+          << scale * (*it) << "\n";
+    }
+  }
+}
+
+//! Write the upper triangle of a dense matrix as SDPA entries.
+template<typename ElemType>
+inline void SDPAWriteMatrix(std::ostream& out,
+                            const size_t index,
+                            const arma::Mat<ElemType>& matrix,
+                            const double scale)
+{
+  for (size_t col = 0; col < matrix.n_cols; ++col)
+  {
+    for (size_t row = 0; row <= col; ++row)
+    {
+      if (matrix(row, col) != ElemType(0))
+      {
+        out << index << " 1 " << (row + 1) << " " << (col + 1) << " "
+            << scale * matrix(row, col) << "\n";
+      }
+    }
+  }
+}
+
+template<typename SDPType>
+void SaveSDPA(const std::string& filename, const SDPType& sdp)
+{
+  std::ofstream out(filename.c_str());
+  if (!out.is_open())
+  {
+    throw std::runtime_error("SaveSDPA(): could not open '" + filename +
+        "' for writing.");
+  }
+
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  out << "\"Written by ensmallen.\"\n";
+  out << sdp.NumConstraints() << " = mDIM\n";
+  out << "1 = nBLOCK\n";
+  out << sdp.N() << " = bLOCKsTRUCT\n";
+
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+    out << sdp.SparseB()[i] << " ";
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+    out << sdp.DenseB()[i] << " ";
+  out << "\n";
+
+  SDPAWriteMatrix(out, 0, sdp.C(), -1.0);
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+    SDPAWriteMatrix(out, i + 1, sdp.SparseA()[i], 1.0);
+  for (size_t i = 0; i < sdp.NumDenseConstraints(); ++i)
+  {
+    SDPAWriteMatrix(out, sdp.NumSparseConstraints() + i + 1, sdp.DenseA()[i],
+        1.0);
+  }
+
+  if (!out)
+  {
+    throw std::runtime_error("SaveSDPA(): could not write '" + filename +
+        "'.");
+  }
+}
+
+} // namespace ens
+
+#endif
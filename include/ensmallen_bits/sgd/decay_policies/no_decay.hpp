@@ -59,20 +59,22 @@ class NoDecay
     }
 
     /**
-     * This function is called in each iteration after the SVRG update step.
+     * This function is called by SVRG after the full gradient at a new
+     * snapshot is computed (except for the first snapshot).
      *
-     * @param iterate Parameters that minimize the function.
-     * @param iterate0 The last function parameters at time t - 1.
-     * @param gradient The current gradient matrix at time t.
-     * @param fullGradient The computed full gradient.
+     * @param iterate The current snapshot at time t.
+     * @param iterate0 The last snapshot at time t - 1.
+     * @param fullGradient0 The full gradient at the last snapshot.
+     * @param fullGradient The full gradient at the current snapshot.
+     * @param numBatches The number of batches.
      * @param stepSize Step size to be used for the given iteration.
      */
-    void Update(const MatType& /* iterate */,
-                const MatType& /* iterate0 */,
-                const GradType& /* gradient */,
-                const GradType& /* fullGradient */,
-                const size_t /* numBatches */,
-                double& /* stepSize */)
+    void SnapshotUpdate(const MatType& /* iterate */,
+                        const MatType& /* iterate0 */,
+                        const GradType& /* fullGradient0 */,
+                        const GradType& /* fullGradient */,
+                        const size_t /* numBatches */,
+                        double& /* stepSize */)
     {
       // Nothing to do here.
     }
@@ -43,11 +43,19 @@ class BarzilaiBorweinDecay
    * @param maxStepSize The maximum step size.
    * @param eps The eps coefficient to avoid division by zero (numerical
    *    stability).
+   * @param alternate If true, alternate between the long (BB1) step size
+   *    s^T s / s^T y and the short (BB2) step size s^T y / y^T y between
+   *    epochs; otherwise, always use the BB1 step size.
+   * @param minStepSize The minimum step size.
    */
   BarzilaiBorweinDecay(const double maxStepSize = DBL_MAX,
-                       const double epsilon = 1e-7) :
+                       const double epsilon = 1e-7,
+                       const bool alternate = false,
+                       const double minStepSize = 0.0) :
       epsilon(epsilon),
-      maxStepSize(maxStepSize)
+      maxStepSize(maxStepSize),
+      alternate(alternate),
+      minStepSize(minStepSize)
   { /* Nothing to do. */}
 
   //! Get the numerical stability parameter.
@@ -60,6 +68,16 @@ class BarzilaiBorweinDecay
   //! Modify the maximum step size.
   double& MaxStepSize() { return maxStepSize; }
 
+  //! Get whether BB1 and BB2 step sizes are alternated.
+  bool Alternate() const { return alternate; }
+  //! Modify whether BB1 and BB2 step sizes are alternated.
+  bool& Alternate() { return alternate; }
+
+  //! Get the minimum step size.
+  double MinStepSize() const { return minStepSize; }
+  //! Modify the minimum step size.
+  double& MinStepSize() { return minStepSize; }
+
   /**
    * The DecayPolicyType policy classes must contain an internal 'Policy'
    * template class with two template arguments: MatType and GradType.  This is
@@ -74,44 +92,54 @@ class BarzilaiBorweinDecay
      * This constructor is called by the SGD Optimize() method before the start
      * of the iteration update process.
      */
-    Policy(BarzilaiBorweinDecay& parent) : parent(parent) { /* Do nothing. */ }
+    Policy(BarzilaiBorweinDecay& parent) : parent(parent), numUpdates(0)
+    { /* Do nothing. */ }
 
     /**
-     * Barzilai-Borwein update step for SVRG.
+     * Barzilai-Borwein update step for SVRG.  All needed inner products are
+     * computed in a single pass over the iterates and full gradients; no copy
+     * of the full gradient is kept.
      *
-     * @param iterate The current function parameter at time t.
-     * @param iterate0 The last function parameters at time t - 1.
-     * @param gradient The current gradient matrix at time t.
-     * @param fullGradient The computed full gradient.
+     * @param iterate The current snapshot at time t.
+     * @param iterate0 The last snapshot at time t - 1.
+     * @param fullGradient0 The full gradient at the last snapshot.
+     * @param fullGradient The full gradient at the current snapshot.
      * @param numBatches The number of batches.
      * @param stepSize Step size to be used for the given iteration.
      */
-    void Update(const MatType& iterate,
-                const MatType& iterate0,
-                const GradType& /* gradient */,
-                const GradType& fullGradient,
-                const size_t numBatches,
-                double& stepSize)
+    void SnapshotUpdate(const MatType& iterate,
+                        const MatType& iterate0,
+                        const GradType& fullGradient0,
+                        const GradType& fullGradient,
+                        const size_t numBatches,
+                        double& stepSize)
     {
-      if (!fullGradient0.is_empty())
-      {
-        // Step size selection based on Barzilai-Borwein (BB).
-        stepSize = std::pow(arma::norm(iterate - iterate0), 2.0) /
-            (arma::dot(iterate - iterate0, fullGradient - fullGradient0) +
-             parent.epsilon) / (double) numBatches;
+      double ss, sy, yy;
+      BarzilaiBorweinProducts(iterate, iterate0, fullGradient, fullGradient0,
+          ss, sy, yy);
+
+      // Without positive curvature along s neither step size is meaningful,
+      // so keep the current step size.
+      if (sy <= 0.0)
+        return;
 
-        stepSize = std::min(stepSize, parent.maxStepSize);
-      }
+      // Step size selection based on Barzilai-Borwein (BB).
+      if (parent.alternate && (numUpdates % 2 == 1))
+        stepSize = sy / (yy + parent.epsilon) / (double) numBatches;
+      else
+        stepSize = ss / (sy + parent.epsilon) / (double) numBatches;
 
-      fullGradient0 = std::move(fullGradient);
+      stepSize = std::min(std::max(stepSize, parent.minStepSize),
+          parent.maxStepSize);
+      ++numUpdates;
     }
 
    private:
     //! Reference to instantiated parent object.
     BarzilaiBorweinDecay& parent;
 
-    //! Locally-stored full gradient.
-    GradType fullGradient0;
+    //! The number of step size updates so far.
+    size_t numUpdates;
   };
 
   //! The value used for numerical stability.
@@ -119,6 +147,12 @@ class BarzilaiBorweinDecay
 
   //! The maximum step size.
   double maxStepSize;
+
+  //! Whether to alternate between BB1 and BB2 step sizes.
+  bool alternate;
+
+  //! The minimum step size.
+  double minStepSize;
 };
 
 } // namespace ens
@@ -15,6 +15,7 @@
 #include <ensmallen_bits/sgd/decay_policies/no_decay.hpp>
 
 #include "svrg_update.hpp"
+#include "svrg_lazy_update.hpp"
 #include "barzilai_borwein_decay.hpp"
 
 namespace ens {
@@ -263,6 +264,11 @@ using SVRG = SVRGType<SVRGUpdate, NoDecay>;
  */
 using SVRG_BB = SVRGType<SVRGUpdate, BarzilaiBorweinDecay>;
 
+/**
+ * Stochastic variance reduced gradient with lazy updates for sparse gradients.
+ */
+using SVRGLazy = SVRGType<SVRGLazyUpdate, NoDecay>;
+
 } // namespace ens
 
 // Include implementation.
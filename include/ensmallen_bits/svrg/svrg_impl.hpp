@@ -113,6 +113,8 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
   // Now iterate!
   BaseGradType gradient(iterate.n_rows, iterate.n_cols);
   BaseGradType gradient0(iterate.n_rows, iterate.n_cols);
+  BaseGradType fullGradient(iterate.n_rows, iterate.n_cols);
+  BaseGradType fullGradient0;
   BaseMatType iterate0;
 
   // Find the number of batches.
@@ -158,9 +160,11 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
 
     lastObjective = overallObjective;
 
-    // Compute the full gradient.
+    // Compute the full gradient.  The previous one is kept for the decay
+    // policy; swapping avoids a copy.
+    std::swap(fullGradient, fullGradient0);
+    fullGradient.set_size(iterate.n_rows, iterate.n_cols);
     size_t effectiveBatchSize = std::min(batchSize, numFunctions);
-    BaseGradType fullGradient(iterate.n_rows, iterate.n_cols);
     function.Gradient(iterate, 0, fullGradient, effectiveBatchSize);
 
     terminate |= Callback::Gradient(*this, function, iterate, fullGradient,
@@ -181,10 +185,22 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
     }
     fullGradient /= (double) numFunctions;
 
+    // Update the learning rate if requested by the user, using the previous
+    // and the current snapshot.
+    if (i > 0)
+    {
+      instDecayPolicy.As<InstDecayPolicyType>().SnapshotUpdate(iterate,
+          iterate0, fullGradient0, fullGradient, numBatches, stepSize);
+    }
+
     // Store current parameter for the calculation of the variance reduced
     // gradient.
     iterate0 = iterate;
 
+    InstUpdatePolicyType& instPolicy =
+        instUpdatePolicy.As<InstUpdatePolicyType>();
+    LazyBeginEpoch(instPolicy, fullGradient);
+
     for (size_t f = 0, currentFunction = 0; f < innerIterations;
         /* incrementing done manually */)
     {
@@ -202,19 +218,39 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
       effectiveBatchSize = std::min(batchSize, numFunctions - currentFunction);
 
       // Calculate variance reduced gradient.
-      function.Gradient(iterate, currentFunction, gradient,
-          effectiveBatchSize);
-      terminate |= Callback::Gradient(*this, function, iterate, gradient,
-        callbacks...);
-
-      function.Gradient(iterate0, currentFunction, gradient0,
-          effectiveBatchSize);
-      terminate |= Callback::Gradient(*this, function, iterate0, gradient0,
-        callbacks...);
+      if (IsLazySVRGUpdate<UpdatePolicyType>::value)
+      {
+        // A lazy update policy defers the dense part of the step, so the
+        // coordinates read by this batch (the support of its gradient at the
+        // snapshot) have to be brought up to date first.
+        function.Gradient(iterate0, currentFunction, gradient0,
+            effectiveBatchSize);
+        terminate |= Callback::Gradient(*this, function, iterate0, gradient0,
+          callbacks...);
+
+        LazyCatchUp(instPolicy, iterate, gradient0, stepSize);
+
+        function.Gradient(iterate, currentFunction, gradient,
+            effectiveBatchSize);
+        terminate |= Callback::Gradient(*this, function, iterate, gradient,
+          callbacks...);
+      }
+      else
+      {
+        function.Gradient(iterate, currentFunction, gradient,
+            effectiveBatchSize);
+        terminate |= Callback::Gradient(*this, function, iterate, gradient,
+          callbacks...);
+
+        function.Gradient(iterate0, currentFunction, gradient0,
+            effectiveBatchSize);
+        terminate |= Callback::Gradient(*this, function, iterate0, gradient0,
+          callbacks...);
+      }
 
       // Use the update policy to take a step.
-      instUpdatePolicy.As<InstUpdatePolicyType>().Update(iterate, fullGradient,
-          gradient, gradient0, effectiveBatchSize, stepSize);
+      instPolicy.Update(iterate, fullGradient, gradient, gradient0,
+          effectiveBatchSize, stepSize);
 
       terminate |= Callback::StepTaken(*this, function, iterate, callbacks...);
 
@@ -222,9 +258,8 @@ SVRGType<UpdatePolicyType, DecayPolicyType>::Optimize(
       f += effectiveBatchSize;
     }
 
-    // Update the learning rate if requested by the user.
-    instDecayPolicy.As<InstDecayPolicyType>().Update(iterate, iterate0,
-        gradient, fullGradient, numBatches, stepSize);
+    // Apply any updates the update policy deferred.
+    LazyFinalize(instPolicy, iterate, stepSize);
   }
 
   Info << "SVRG: maximum iterations (" << maxIterations << ") reached; "
@@ -0,0 +1,293 @@
+/**
+ * @file svrg_lazy_update.hpp
+ *
+ * Lazy (just-in-time) update for stochastic variance reduced gradient (SVRG)
+ * with sparse gradients.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_SVRG_SVRG_LAZY_UPDATE_HPP
+#define ENSMALLEN_SVRG_SVRG_LAZY_UPDATE_HPP
+
+namespace ens {
+
+/**
+ * Lazy update policy for Stochastic variance reduced gradient (SVRG), for
+ * dense iterates and sparse gradients.  Each inner SVRG step
+ *
+ *   x -= stepSize * (mu + lambda * x + (g - g0) / batchSize),
+ *
+ * with mu the full gradient at the snapshot and lambda an optional L2
+ * regularization strength, changes every coordinate of x, but outside the
+ * support of g and g0 the change only depends on mu and lambda.  This policy
+ * remembers for every coordinate the last step at which it was updated and
+ * applies the skipped steps in closed form when the coordinate is next read,
+ * or at the end of the epoch.  Each inner step then costs O(nnz) instead of
+ * O(n).
+ *
+ * The coordinates read by a batch are taken to be the support of the batch's
+ * gradient at the snapshot.  This holds for generalized linear models on
+ * sparse data, where the gradient of each example is a multiple of its
+ * feature vector.  The L2 term must not be part of the function itself, since
+ * its gradient would be dense; pass its strength to the constructor instead.
+ * Within an epoch the iterate passed to the StepTaken callbacks is only
+ * up-to-date on the coordinates touched so far.
+ */
+class SVRGLazyUpdate
+{
+ public:
+  /**
+   * Construct the lazy SVRG update policy.
+   *
+   * @param lambda Strength of the L2 regularization term
+   *     0.5 * lambda * ||x||^2 applied by the optimizer.
+   */
+  SVRGLazyUpdate(const double lambda = 0.0) : lambda(lambda)
+  { /* Do nothing. */ }
+
+  //! Get the L2 regularization strength.
+  double Lambda() const { return lambda; }
+  //! Modify the L2 regularization strength.
+  double& Lambda() { return lambda; }
+
+  /**
+   * The UpdatePolicyType policy classes must contain an internal 'Policy'
+   * template class with two template arguments: MatType and GradType.  This is
+   * instantiated at the start of the optimization.
+   */
+  template<typename MatType, typename GradType>
+  class Policy
+  {
+   public:
+    typedef typename MatType::elem_type ElemType;
+
+    /**
+     * This is called by the optimizer method before the start of the iteration
+     * update process.
+     *
+     * @param parent Instantiated parent class.
+     * @param rows Number of rows in the gradient matrix.
+     * @param cols Number of columns in the gradient matrix.
+     */
+    Policy(SVRGLazyUpdate& parent, const size_t rows, const size_t cols) :
+        parent(parent),
+        step(0)
+    {
+      static_assert(arma::is_arma_sparse_type<GradType>::value,
+          "SVRGLazyUpdate requires a sparse gradient type");
+
+      lastStep.zeros(rows * cols);
+    }
+
+    /**
+     * Start a new epoch with the given full gradient.
+     *
+     * @param fullGradient The computed full gradient.
+     */
+    void BeginEpoch(const GradType& fullGradient)
+    {
+      drift = MatType(fullGradient);
+      step = 0;
+      lastStep.zeros();
+    }
+
+    /**
+     * Bring the coordinates in the support of the given snapshot gradient up
+     * to date, so that the gradient at the iterate can be computed.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param gradient0 The gradient of the current batch at the snapshot.
+     * @param stepSize Step size to be used for the given iteration.
+     */
+    void CatchUp(MatType& iterate,
+                 const GradType& gradient0,
+                 const double stepSize)
+    {
+      const size_t rows = iterate.n_rows;
+      for (auto it = gradient0.begin(); it != gradient0.end(); ++it)
+        CatchUpCoordinate(iterate, it.row() + it.col() * rows, stepSize);
+    }
+
+    /**
+     * Update step for SVRG.  Only the coordinates in the support of the
+     * gradients are updated; all others are deferred.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param fullGradient The computed full gradient.
+     * @param gradient The current gradient matrix at time t.
+     * @param gradient0 The old gradient matrix at time t - 1.
+     * @param batchSize Batch size to be used for the given iteration.
+     * @param stepSize Step size to be used for the given iteration.
+     */
+    void Update(MatType& iterate,
+                const GradType& /* fullGradient */,
+                const GradType& gradient,
+                const GradType& gradient0,
+                const size_t batchSize,
+                const double stepSize)
+    {
+      const size_t rows = iterate.n_rows;
+      const ElemType scale = ElemType(1.0 / (double) batchSize);
+      const ElemType a = ElemType(stepSize);
+      const ElemType lambda = ElemType(parent.Lambda());
+      ElemType* x = iterate.memptr();
+      const ElemType* mu = drift.memptr();
+
+      // The coordinates in the support of gradient0 are already up to date.
+      // Both loops use the value of x from before this step in the L2 term.
+      for (auto it = gradient0.begin(); it != gradient0.end(); ++it)
+      {
+        const size_t i = it.row() + it.col() * rows;
+        x[i] -= a * (mu[i] + lambda * x[i] - scale * (*it));
+        lastStep[i] = step + 1;
+      }
+
+      for (auto it = gradient.begin(); it != gradient.end(); ++it)
+      {
+        const size_t i = it.row() + it.col() * rows;
+        if (lastStep[i] != step + 1)
+        {
+          CatchUpCoordinate(iterate, i, stepSize);
+          x[i] -= a * (mu[i] + lambda * x[i]);
+          lastStep[i] = step + 1;
+        }
+        x[i] -= a * scale * (*it);
+      }
+
+      ++step;
+    }
+
+    /**
+     * Apply all deferred updates at the end of the epoch.
+     *
+     * @param iterate Parameters that minimize the function.
+     * @param stepSize Step size used in the epoch.
+     */
+    void Finalize(MatType& iterate, const double stepSize)
+    {
+      for (size_t i = 0; i < iterate.n_elem; ++i)
+        CatchUpCoordinate(iterate, i, stepSize);
+
+      step = 0;
+      lastStep.zeros();
+    }
+
+   private:
+    /**
+     * Apply the steps the given coordinate missed since it was last updated.
+     * k steps of x <- (1 - stepSize * lambda) x - stepSize * mu sum up to
+     *
+     *   x <- c^k x - mu (1 - c^k) / lambda,   c = 1 - stepSize * lambda,
+     *
+     * or x <- x - k * stepSize * mu if lambda is 0.
+     */
+    void CatchUpCoordinate(MatType& iterate,
+                           const size_t i,
+                           const double stepSize)
+    {
+      const size_t k = step - lastStep[i];
+      if (k == 0)
+        return;
+
+      const double lambda = parent.Lambda();
+      if (lambda == 0.0)
+      {
+        iterate[i] -= ElemType(k * stepSize) * drift[i];
+      }
+      else
+      {
+        const double ck = std::pow(1.0 - stepSize * lambda, (double) k);
+        iterate[i] = ElemType(ck) * iterate[i] -
+            ElemType((1.0 - ck) / lambda) * drift[i];
+      }
+
+      lastStep[i] = step;
+    }
+
+    //! Instantiated parent class.
+    SVRGLazyUpdate& parent;
+
+    //! The dense full gradient of the current epoch.
+    MatType drift;
+
+    //! The number of inner steps taken in the current epoch.
+    size_t step;
+
+    //! The step up to which each coordinate has been updated.
+    arma::Col<size_t> lastStep;
+  };
+
+ private:
+  //! The L2 regularization strength.
+  double lambda;
+};
+
+/**
+ * If value == true, the update policy defers the dense part of the SVRG step
+ * and the optimizer has to call its BeginEpoch(), CatchUp() and Finalize()
+ * hooks.
+ */
+template<typename UpdatePolicyType>
+struct IsLazySVRGUpdate
+{
+  const static bool value = false;
+};
+
+template<>
+struct IsLazySVRGUpdate<SVRGLazyUpdate>
+{
+  const static bool value = true;
+};
+
+/**
+ * Forward the lazy update hooks to the instantiated update policy; these do
+ * nothing for policies that are not lazy.
+ */
+template<typename PolicyType, typename GradType>
+inline void LazyBeginEpoch(PolicyType& /* policy */,
+                           const GradType& /* fullGradient */)
+{ /* Do nothing. */ }
+
+template<typename MatType, typename GradType>
+inline void LazyBeginEpoch(SVRGLazyUpdate::Policy<MatType, GradType>& policy,
+                           const GradType& fullGradient)
+{
+  policy.BeginEpoch(fullGradient);
+}
+
+template<typename PolicyType, typename MatType, typename GradType>
+inline void LazyCatchUp(PolicyType& /* policy */,
+                        MatType& /* iterate */,
+                        const GradType& /* gradient0 */,
+                        const double /* stepSize */)
+{ /* Do nothing. */ }
+
+template<typename MatType, typename GradType>
+inline void LazyCatchUp(SVRGLazyUpdate::Policy<MatType, GradType>& policy,
+                        MatType& iterate,
+                        const GradType& gradient0,
+                        const double stepSize)
+{
+  policy.CatchUp(iterate, gradient0, stepSize);
+}
+
+template<typename PolicyType, typename MatType>
+inline void LazyFinalize(PolicyType& /* policy */,
+                         MatType& /* iterate */,
+                         const double /* stepSize */)
+{ /* Do nothing. */ }
+
+template<typename MatType, typename GradType>
+inline void LazyFinalize(SVRGLazyUpdate::Policy<MatType, GradType>& policy,
+                         MatType& iterate,
+                         const double stepSize)
+{
+  policy.Finalize(iterate, stepSize);
+}
+
+} // namespace ens
+
+#endif
@@ -61,9 +61,9 @@ class SVRGUpdate
                 const size_t batchSize,
                 const double stepSize)
     {
-      // Perform the vanilla SVRG update.
-      iterate -= stepSize * (fullGradient + (gradient - gradient0) /
-          (double) batchSize);
+      // Perform the vanilla SVRG update in a single pass.
+      VarianceReducedStep(iterate, fullGradient, gradient, gradient0,
+          1.0 / (double) batchSize, stepSize);
     }
   };
 };
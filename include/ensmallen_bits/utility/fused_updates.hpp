@@ -0,0 +1,286 @@
+/**
+ * @file fused_updates.hpp
+ *
+ * Fused single-pass update kernels for the inner loops of the variance reduced
+ * optimizers (SVRG, SARAH/SARAH+ and Katyusha) and their step size policies.
+ * Each kernel reads and writes every involved matrix exactly once and does not
+ * allocate.  For dense matrices this is done with a plain loop over the
+ * memory; for other types (e.g. sparse gradients) the equivalent Armadillo
+ * expressions are used.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef ENSMALLEN_UTILITY_FUSED_UPDATES_HPP
+#define ENSMALLEN_UTILITY_FUSED_UPDATES_HPP
+
+namespace ens {
+
+/**
+ * Take the variance reduced gradient step
+ *
+ *   iterate -= stepSize * (fullGradient + scale * (gradient - gradient0)).
+ *
+ * @param iterate Parameters to update.
+ * @param fullGradient Full gradient at the snapshot.
+ * @param gradient Stochastic gradient at the current iterate.
+ * @param gradient0 Stochastic gradient at the snapshot.
+ * @param scale Scale of the gradient difference (usually 1 / batchSize).
+ * @param stepSize Step size.
+ */
+template<typename MatType, typename GradType>
+inline void VarianceReducedStep(MatType& iterate,
+                                const GradType& fullGradient,
+                                const GradType& gradient,
+                                const GradType& gradient0,
+                                const double scale,
+                                const double stepSize)
+{
+  iterate -= stepSize * (fullGradient + scale * (gradient - gradient0));
+}
+
+//! Dense overload of VarianceReducedStep().
+template<typename ElemType>
+inline void VarianceReducedStep(arma::Mat<ElemType>& iterate,
+                                const arma::Mat<ElemType>& fullGradient,
+                                const arma::Mat<ElemType>& gradient,
+                                const arma::Mat<ElemType>& gradient0,
+                                const double scale,
+                                const double stepSize)
+{
+  ElemType* x = iterate.memptr();
+  const ElemType* fg = fullGradient.memptr();
+  const ElemType* g = gradient.memptr();
+  const ElemType* g0 = gradient0.memptr();
+  const ElemType s = ElemType(scale);
+  const ElemType a = ElemType(stepSize);
+
+  const size_t n = iterate.n_elem;
+  for (size_t i = 0; i < n; ++i)
+    x[i] -= a * (fg[i] + s * (g[i] - g0[i]));
+}
+
+/**
+ * Take the recursive (SARAH) gradient step
+ *
+ *   v += scale * (gradient - gradient0),
+ *   iterate -= stepSize * v,
+ *
+ * and return the norm of the updated v.
+ *
+ * @param iterate Parameters to update.
+ * @param v Recursive gradient estimate to update.
+ * @param gradient Stochastic gradient at the current iterate.
+ * @param gradient0 Stochastic gradient at the previous iterate.
+ * @param scale Scale of the gradient difference (usually 1 / batchSize).
+ * @param stepSize Step size.
+ * @return Norm of the updated v.
+ */
+template<typename MatType, typename GradType>
+inline double RecursiveGradientStep(MatType& iterate,
+                                    GradType& v,
+                                    const GradType& gradient,
+                                    const GradType& gradient0,
+                                    const double scale,
+                                    const double stepSize)
+{
+  v += scale * (gradient - gradient0);
+  iterate -= stepSize * v;
+  return arma::norm(v);
+}
+
+//! Dense overload of RecursiveGradientStep().
+template<typename ElemType>
+inline double RecursiveGradientStep(arma::Mat<ElemType>& iterate,
+                                    arma::Mat<ElemType>& v,
+                                    const arma::Mat<ElemType>& gradient,
+                                    const arma::Mat<ElemType>& gradient0,
+                                    const double scale,
+                                    const double stepSize)
+{
+  ElemType* x = iterate.memptr();
+  ElemType* vp = v.memptr();
+  const ElemType* g = gradient.memptr();
+  const ElemType* g0 = gradient0.memptr();
+  const ElemType s = ElemType(scale);
+  const ElemType a = ElemType(stepSize);
+
+  // Accumulate in double precision to match arma::norm() for float types.
+  double sqNorm = 0;
+  const size_t n = iterate.n_elem;
+  for (size_t i = 0; i < n; ++i)
+  {
+    vp[i] += s * (g[i] - g0[i]);
+    x[i] -= a * vp[i];
+    sqNorm += double(vp[i]) * double(vp[i]);
+  }
+
+  return std::sqrt(sqNorm);
+}
+
+/**
+ * Take the Katyusha inner step.  With the variance reduced gradient
+ * g = fullGradient + scale * (gradient - gradient0), this computes
+ *
+ *   y = iterate + wScale * w          (if proximal),
+ *   y = iterate - tau1 * alpha * g    (otherwise),
+ *   z -= alpha * g,
+ *   w += cw * iterate.
+ *
+ * @param iterate Current iterate.
+ * @param y Gradient step sequence to update.
+ * @param z Mirror step sequence to update.
+ * @param w Weighted sum of iterates to update.
+ * @param fullGradient Full gradient at the snapshot.
+ * @param gradient Stochastic gradient at the current iterate.
+ * @param gradient0 Stochastic gradient at the snapshot.
+ * @param scale Scale of the gradient difference (usually 1 / batchSize).
+ * @param alpha Mirror step size.
+ * @param tau1 Momentum parameter.
+ * @param proximal Whether to use the proximal (Option II) update for y.
+ * @param wScale Scale of w in the proximal update for y.
+ * @param cw Weight of the current iterate in w.
+ */
+template<typename MatType, typename GradType>
+inline void KatyushaStep(const MatType& iterate,
+                         MatType& y,
+                         MatType& z,
+                         MatType& w,
+                         const GradType& fullGradient,
+                         const GradType& gradient,
+                         const GradType& gradient0,
+                         const double scale,
+                         const double alpha,
+                         const double tau1,
+                         const bool proximal,
+                         const double wScale,
+                         const double cw)
+{
+  if (proximal)
+  {
+    y = iterate + wScale * w;
+    z -= alpha * (fullGradient + scale * (gradient - gradient0));
+  }
+  else
+  {
+    y = iterate - (tau1 * alpha) * (fullGradient + scale *
+        (gradient - gradient0));
+    z -= alpha * (fullGradient + scale * (gradient - gradient0));
+  }
+  w += cw * iterate;
+}
+
+//! Dense overload of KatyushaStep().
+template<typename ElemType>
+inline void KatyushaStep(const arma::Mat<ElemType>& iterate,
+                         arma::Mat<ElemType>& y,
+                         arma::Mat<ElemType>& z,
+                         arma::Mat<ElemType>& w,
+                         const arma::Mat<ElemType>& fullGradient,
+                         const arma::Mat<ElemType>& gradient,
+                         const arma::Mat<ElemType>& gradient0,
+                         const double scale,
+                         const double alpha,
+                         const double tau1,
+                         const bool proximal,
+                         const double wScale,
+                         const double cw)
+{
+  const ElemType* x = iterate.memptr();
+  ElemType* yp = y.memptr();
+  ElemType* zp = z.memptr();
+  ElemType* wp = w.memptr();
+  const ElemType* fg = fullGradient.memptr();
+  const ElemType* g = gradient.memptr();
+  const ElemType* g0 = gradient0.memptr();
+  const ElemType s = ElemType(scale);
+  const ElemType a = ElemType(alpha);
+  const ElemType ta = ElemType(tau1 * alpha);
+  const ElemType ws = ElemType(wScale);
+  const ElemType c = ElemType(cw);
+
+  const size_t n = iterate.n_elem;
+  if (proximal)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType gi = fg[i] + s * (g[i] - g0[i]);
+      yp[i] = x[i] + ws * wp[i];
+      zp[i] -= a * gi;
+      wp[i] += c * x[i];
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType gi = fg[i] + s * (g[i] - g0[i]);
+      yp[i] = x[i] - ta * gi;
+      zp[i] -= a * gi;
+      wp[i] += c * x[i];
+    }
+  }
+}
+
+/**
+ * Compute the inner products needed for Barzilai-Borwein step sizes in a
+ * single pass: with s = iterate - iterate0 and y = fullGradient -
+ * fullGradient0, this computes s^T s, s^T y and y^T y.
+ *
+ * @param iterate Current iterate.
+ * @param iterate0 Previous iterate.
+ * @param fullGradient Full gradient at the current iterate.
+ * @param fullGradient0 Full gradient at the previous iterate.
+ * @param ss Will be set to s^T s.
+ * @param sy Will be set to s^T y.
+ * @param yy Will be set to y^T y.
+ */
+template<typename MatType, typename GradType>
+inline void BarzilaiBorweinProducts(const MatType& iterate,
+                                    const MatType& iterate0,
+                                    const GradType& fullGradient,
+                                    const GradType& fullGradient0,
+                                    double& ss,
+                                    double& sy,
+                                    double& yy)
+{
+  const MatType s = iterate - iterate0;
+  const GradType y = fullGradient - fullGradient0;
+  ss = arma::accu(s % s);
+  sy = arma::accu(s % y);
+  yy = arma::accu(y % y);
+}
+
+//! Dense overload of BarzilaiBorweinProducts().
+template<typename ElemType>
+inline void BarzilaiBorweinProducts(const arma::Mat<ElemType>& iterate,
+                                    const arma::Mat<ElemType>& iterate0,
+                                    const arma::Mat<ElemType>& fullGradient,
+                                    const arma::Mat<ElemType>& fullGradient0,
+                                    double& ss,
+                                    double& sy,
+                                    double& yy)
+{
+  const ElemType* x = iterate.memptr();
+  const ElemType* x0 = iterate0.memptr();
+  const ElemType* g = fullGradient.memptr();
+  const ElemType* g0 = fullGradient0.memptr();
+
+  // Accumulate in double precision, as in RecursiveGradientStep().
+  ss = sy = yy = 0;
+  const size_t n = iterate.n_elem;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double si = double(x[i]) - double(x0[i]);
+    const double yi = double(g[i]) - double(g0[i]);
+    ss += si * si;
+    sy += si * yi;
+    yy += yi * yi;
+  }
+}
+
+} // namespace ens
+
+#endif
@@ -0,0 +1,33 @@
+/**
+ * @file ensmallen_instantiations.cpp
+ *
+ * Explicit instantiations of common optimizers for the abstract function types
+ * in ensmallen_bits/function/function_base.hpp.  Link against the resulting
+ * library and define ENS_USE_EXTERN_TEMPLATES to use them instead of compiling
+ * them in every translation unit.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <ensmallen.hpp>
+
+namespace ens {
+
+ENS_LBFGS_INSTANTIATIONS(template, arma::mat)
+ENS_LBFGS_INSTANTIATIONS(template, arma::fmat)
+
+ENS_GRADIENT_DESCENT_INSTANTIATIONS(template, arma::mat)
+ENS_GRADIENT_DESCENT_INSTANTIATIONS(template, arma::fmat)
+
+ENS_SGD_INSTANTIATIONS(template, arma::mat)
+ENS_SGD_INSTANTIATIONS(template, arma::fmat)
+
+ENS_ADAM_INSTANTIATIONS(template, arma::mat)
+ENS_ADAM_INSTANTIATIONS(template, arma::fmat)
+
+ENS_CMAES_INSTANTIATIONS(template, arma::mat)
+ENS_CMAES_INSTANTIATIONS(template, arma::fmat)
+
+} // namespace ens
@@ -108,3 +108,83 @@ TEST_CASE("GockenbachFunctionSpMatTest", "[AugLagrangianTest]")
   REQUIRE(coords(1) == Approx(-1.10778185).epsilon(1e-7));
   REQUIRE(coords(2) == Approx(0.015099932).epsilon(1e-5));
 }
+
+/**
+ * Make sure that the batches of an AugLagrangianSeparableFunction sum to the
+ * full augmented Lagrangian, and that amortized constraint terms are reused.
+ */
+TEST_CASE("AugLagrangianSeparableFunctionTest", "[AugLagrangianTest]")
+{
+  SeparableAugLagrangianTestFunction f(100);
+  AugLagrangianSeparableFunction<SeparableAugLagrangianTestFunction> augfunc(
+      f, arma::vec("0.5"), 10.0);
+
+  arma::mat coords("0.3; 0.2");
+  arma::mat gradient, batchGradient, sumGradient(2, 1, arma::fill::zeros);
+  augfunc.Gradient(coords, gradient);
+
+  double sum = 0.0;
+  for (size_t i = 0; i < f.NumFunctions(); i += 10)
+  {
+    sum += augfunc.Evaluate(coords, i, 10);
+    augfunc.Gradient(coords, i, batchGradient, 10);
+    sumGradient += batchGradient;
+  }
+
+  REQUIRE(sum == Approx(augfunc.Evaluate(coords)).epsilon(1e-10));
+  REQUIRE(sumGradient(0) == Approx(gradient(0)).epsilon(1e-10));
+  REQUIRE(sumGradient(1) == Approx(gradient(1)).epsilon(1e-10));
+
+  // With amortization, the constraint terms of the first batch are reused
+  // for the following batches, even if the coordinates change.
+  augfunc.ConstraintInterval() = 100;
+  arma::mat first, second, expected;
+  augfunc.Gradient(coords, 0, first, 10);
+  arma::mat moved("1.0; 1.0");
+  augfunc.Gradient(moved, 0, second, 10);
+  f.Gradient(moved, 0, expected, 10);
+  f.Gradient(coords, 0, batchGradient, 10);
+  REQUIRE(arma::approx_equal(second - expected, first - batchGradient,
+      "absdiff", 1e-10));
+
+  // Changing the multipliers invalidates the cache.
+  augfunc.Lambda()[0] = 1.0;
+  augfunc.Gradient(moved, 0, second, 10);
+  REQUIRE(!arma::approx_equal(second - expected, first - batchGradient,
+      "absdiff", 1e-10));
+}
+
+/**
+ * Tests the Augmented Lagrangian optimizer with SGD as the inner optimizer.
+ */
+TEST_CASE("AugLagrangianSGDTest", "[AugLagrangianTest]")
+{
+  SeparableAugLagrangianTestFunction f;
+  AugLagrangianType<StandardSGD> aug(4, 0.25, 10.0,
+      StandardSGD(0.1, 10, 50 * f.NumFunctions(), 1e-10, true));
+
+  arma::mat coords = f.GetInitialPoint();
+  aug.Optimize(f, coords);
+
+  REQUIRE(coords(0) == Approx(1.5).margin(0.05));
+  REQUIRE(coords(1) == Approx(-0.5).margin(0.05));
+  REQUIRE(std::abs(f.EvaluateConstraint(0, coords)) < 0.02);
+}
+
+/**
+ * Tests the Augmented Lagrangian optimizer with Adam as the inner optimizer
+ * and amortized constraint terms.
+ */
+TEST_CASE("AugLagrangianAdamAmortizedTest", "[AugLagrangianTest]")
+{
+  SeparableAugLagrangianTestFunction f;
+  AugLagrangianType<Adam> aug(4, 0.25, 10.0, Adam(0.01, 10, 0.9, 0.999, 1e-8,
+      50 * f.NumFunctions(), 1e-10, true), 10);
+
+  arma::mat coords = f.GetInitialPoint();
+  aug.Optimize(f, coords);
+
+  REQUIRE(coords(0) == Approx(1.5).margin(0.05));
+  REQUIRE(coords(1) == Approx(-0.5).margin(0.05));
+  REQUIRE(std::abs(f.EvaluateConstraint(0, coords)) < 0.02);
+}
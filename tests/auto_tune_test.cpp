@@ -0,0 +1,189 @@
+/**
+ * @file auto_tune_test.cpp
+ *
+ * Tests for the AutoTune optimizer wrapper.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+#include <cstdio>
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Make sure that AutoTune picks one of the candidate batch sizes and that the
+ * final optimization converges.
+ */
+TEST_CASE("AutoTuneSGDSphereTest", "[AutoTuneTest]")
+{
+  SphereFunction f(10);
+  StandardSGD sgd(0.1, 1, 500000, 1e-9, true);
+
+  std::vector<size_t> batchSizes = { 1, 2, 5, 10 };
+  AutoTune<StandardSGD> optimizer(sgd, batchSizes, std::vector<size_t>(),
+      100, 5.0);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const arma::mat start(coordinates);
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(std::find(batchSizes.begin(), batchSizes.end(),
+      optimizer.BestBatchSize()) != batchSizes.end());
+  REQUIRE(optimizer.BestThreadCount() >= 1);
+  REQUIRE(!optimizer.FromCache());
+
+  // The settings of the wrapped optimizer are restored after the warm-up.
+  REQUIRE(optimizer.Optimizer().MaxIterations() == 500000);
+
+  REQUIRE(result == Approx(0.0).margin(1e-5));
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Make sure that the choice is read back from the cache file.
+ */
+TEST_CASE("AutoTuneCacheTest", "[AutoTuneTest]")
+{
+  const std::string cacheFile = "auto_tune_test_cache.txt";
+  std::remove(cacheFile.c_str());
+
+  SphereFunction f(10);
+  StandardSGD sgd(0.1, 1, 500000, 1e-9, true);
+  AutoTune<StandardSGD> optimizer(sgd, { 1, 5 }, std::vector<size_t>(), 100,
+      5.0, true, cacheFile);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+  REQUIRE(!optimizer.FromCache());
+  const size_t batchSize = optimizer.BestBatchSize();
+  const size_t threadCount = optimizer.BestThreadCount();
+
+  AutoTune<StandardSGD> cached(sgd, { 1, 5 }, std::vector<size_t>(), 100,
+      5.0, true, cacheFile);
+  coordinates = f.GetInitialPoint();
+  const double result = cached.Optimize(f, coordinates);
+
+  REQUIRE(cached.FromCache());
+  REQUIRE(cached.BestBatchSize() == batchSize);
+  REQUIRE(cached.BestThreadCount() == threadCount);
+  REQUIRE(result == Approx(0.0).margin(1e-5));
+
+  // A problem of a different size must not use the cached choice.
+  SphereFunction g(20);
+  coordinates = g.GetInitialPoint();
+  cached.Optimize(g, coordinates);
+  REQUIRE(!cached.FromCache());
+
+  std::remove(cacheFile.c_str());
+}
+
+/**
+ * Make sure that AutoTune works with an optimizer without a batch size.
+ */
+TEST_CASE("AutoTuneLBFGSTest", "[AutoTuneTest]")
+{
+  RosenbrockFunction f;
+  AutoTune<L_BFGS> optimizer(L_BFGS(), std::vector<size_t>(),
+      std::vector<size_t>(), 10, 5.0, false);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(optimizer.BestBatchSize() == 0);
+  REQUIRE(result == Approx(0.0).margin(1e-5));
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-5));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-5));
+}
+
+/**
+ * Make sure that the warm-up trials do not leave state behind in the wrapped
+ * optimizer: with a kept L-BFGS history, the actual optimization must be the
+ * same as a fresh one.
+ */
+TEST_CASE("AutoTuneTrialStateTest", "[AutoTuneTest]")
+{
+  RosenbrockFunction f;
+  L_BFGS lbfgs;
+  lbfgs.ResetPolicy() = false;
+  AutoTune<L_BFGS> optimizer(lbfgs, std::vector<size_t>(),
+      std::vector<size_t>(), 10, 5.0, false);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = optimizer.Optimize(f, coordinates);
+
+  L_BFGS fresh(lbfgs);
+  arma::mat freshCoordinates = f.GetInitialPoint();
+  const double freshResult = fresh.Optimize(f, freshCoordinates);
+
+  REQUIRE(result == freshResult);
+  REQUIRE(arma::approx_equal(coordinates, freshCoordinates, "absdiff", 0.0));
+}
+
+/**
+ * A separable function whose evaluations fail.
+ */
+class ThrowingFunction
+{
+ public:
+  void Shuffle() { }
+
+  size_t NumFunctions() const { return 10; }
+
+  arma::mat GetInitialPoint() const { return arma::ones<arma::mat>(2, 1); }
+
+  double Evaluate(const arma::mat& /* coordinates */,
+                  const size_t /* begin */,
+                  const size_t /* batchSize */) const
+  {
+    throw std::runtime_error("ThrowingFunction::Evaluate()");
+  }
+
+  void Gradient(const arma::mat& /* coordinates */,
+                const size_t /* begin */,
+                arma::mat& /* gradient */,
+                const size_t /* batchSize */) const
+  {
+    throw std::runtime_error("ThrowingFunction::Gradient()");
+  }
+};
+
+/**
+ * Make sure that the settings of the wrapped optimizer are restored when it
+ * throws during the warm-up.
+ */
+TEST_CASE("AutoTuneThrowingOptimizerTest", "[AutoTuneTest]")
+{
+  ThrowingFunction f;
+  StandardSGD sgd(0.1, 3, 1000);
+  AutoTune<StandardSGD> optimizer(sgd, { 1, 5 }, std::vector<size_t>(), 100);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  REQUIRE_THROWS_AS(optimizer.Optimize(f, coordinates), std::runtime_error);
+
+  REQUIRE(optimizer.Optimizer().MaxIterations() == 1000);
+  REQUIRE(optimizer.Optimizer().BatchSize() == 3);
+}
+
+/**
+ * Make sure that an invalid number of warm-up iterations is rejected.
+ */
+TEST_CASE("AutoTuneInvalidTest", "[AutoTuneTest]")
+{
+  SphereFunction f(2);
+  AutoTune<StandardSGD> optimizer;
+  optimizer.WarmupIterations() = 0;
+
+  arma::mat coordinates = f.GetInitialPoint();
+  REQUIRE_THROWS_AS(optimizer.Optimize(f, coordinates),
+      std::invalid_argument);
+}
@@ -0,0 +1,166 @@
+/**
+ * @file bayesian_optimization_test.cpp
+ *
+ * Test file for the Bayesian optimization optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * A quadratic with its minimum at (0.3, -0.2).
+ */
+class ShiftedQuadraticFunction
+{
+ public:
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates) const
+  {
+    return std::pow(coordinates(0) - 0.3, 2) +
+        std::pow(coordinates(1) + 0.2, 2);
+  }
+};
+
+/**
+ * A function of one continuous and one categorical parameter, with its minimum
+ * at (0.5, 2).
+ */
+class MixedCategoricalFunction
+{
+ public:
+  double Evaluate(const arma::mat& coordinates) const
+  {
+    return std::pow(coordinates(0) - 0.5, 2) +
+        ((coordinates(1) == 2.0) ? 0.0 : 1.0);
+  }
+};
+
+/**
+ * The shifted quadratic, but the evaluation fails (returns NaN) when the first
+ * coordinate is larger than 0.8.
+ */
+class FailingQuadraticFunction
+{
+ public:
+  double Evaluate(const arma::mat& coordinates) const
+  {
+    if (coordinates(0) > 0.8)
+      return arma::datum::nan;
+
+    return std::pow(coordinates(0) - 0.3, 2) +
+        std::pow(coordinates(1) + 0.2, 2);
+  }
+};
+
+/**
+ * Make sure that Bayesian optimization finds the minimum of a quadratic with a
+ * small budget of evaluations.
+ */
+TEST_CASE("BayesianOptimizationQuadraticTest", "[BayesianOptimizationTest]")
+{
+  ShiftedQuadraticFunction f;
+  BayesianOptimization optimizer(40, -1.0, 1.0);
+
+  arma::mat coordinates("0.9; 0.9");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(0) == Approx(0.3).margin(0.1));
+  REQUIRE(coordinates(1) == Approx(-0.2).margin(0.1));
+}
+
+/**
+ * Make sure that Bayesian optimization with the upper confidence bound finds
+ * the minimum of a quadratic.
+ */
+TEST_CASE("BayesianOptimizationUCBQuadraticTest", "[BayesianOptimizationTest]")
+{
+  ShiftedQuadraticFunction f;
+  BayesianOptimizationUCB optimizer(40, -1.0, 1.0);
+
+  arma::mat coordinates("0.9; 0.9");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(0) == Approx(0.3).margin(0.1));
+  REQUIRE(coordinates(1) == Approx(-0.2).margin(0.1));
+}
+
+/**
+ * Make sure that batches proposed by local penalization find the minimum too.
+ */
+TEST_CASE("BayesianOptimizationBatchTest", "[BayesianOptimizationTest]")
+{
+  ShiftedQuadraticFunction f;
+  BayesianOptimization optimizer(48, -1.0, 1.0, 8, 4);
+
+  arma::mat coordinates("0.9; 0.9");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(0) == Approx(0.3).margin(0.1));
+  REQUIRE(coordinates(1) == Approx(-0.2).margin(0.1));
+}
+
+/**
+ * Make sure that Bayesian optimization handles categorical dimensions.
+ */
+TEST_CASE("BayesianOptimizationCategoricalTest", "[BayesianOptimizationTest]")
+{
+  MixedCategoricalFunction f;
+
+  std::vector<bool> categoricalDimensions = { false, true };
+  arma::Row<size_t> numCategories = { 0, 4 };
+  BayesianOptimization optimizer(40, -1.0, 1.0, 10, 1, 5, 0.2, 1e-6,
+      categoricalDimensions, numCategories);
+
+  arma::mat coordinates("0; 0");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(0) == Approx(0.5).margin(0.1));
+  REQUIRE(coordinates(1) == 2.0);
+}
+
+/**
+ * Make sure that infinite bounds are rejected.
+ */
+TEST_CASE("BayesianOptimizationInvalidBoundsTest",
+          "[BayesianOptimizationTest]")
+{
+  ShiftedQuadraticFunction f;
+  BayesianOptimization optimizer(40, -arma::datum::inf, 1.0);
+
+  arma::mat coordinates("0.9; 0.9");
+  REQUIRE_THROWS_AS(optimizer.Optimize(f, coordinates),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a failed first evaluation (at the starting point) is not
+ * returned as the best point.
+ */
+TEST_CASE("BayesianOptimizationFailedEvaluationTest",
+          "[BayesianOptimizationTest]")
+{
+  FailingQuadraticFunction f;
+  BayesianOptimization optimizer(40, -1.0, 1.0);
+
+  arma::mat coordinates("0.9; 0.9");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(std::isfinite(result));
+  REQUIRE(result == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(0) == Approx(0.3).margin(0.1));
+  REQUIRE(coordinates(1) == Approx(-0.2).margin(0.1));
+}
@@ -0,0 +1,133 @@
+/**
+ * @file bobyqa_test.cpp
+ *
+ * Test file for the BOBYQA optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Count the evaluations of the Rosenbrock function.
+ */
+class CountingRosenbrockFunction
+{
+ public:
+  CountingRosenbrockFunction() : evaluations(0) { }
+
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates)
+  {
+    ++evaluations;
+    return f.Evaluate(coordinates);
+  }
+
+  size_t evaluations;
+
+ private:
+  RosenbrockFunction f;
+};
+
+/**
+ * Test BOBYQA on the Rosenbrock function, and make sure that it only needs a
+ * few hundred evaluations.
+ */
+TEST_CASE("BOBYQARosenbrockFunctionTest", "[BOBYQATest]")
+{
+  CountingRosenbrockFunction f;
+  BOBYQA optimizer(2000, 0.5, 1e-8);
+
+  arma::mat coordinates("-1.2; 1");
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-8));
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-4));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-4));
+  REQUIRE(f.evaluations < 500);
+}
+
+/**
+ * Test BOBYQA on the Rosenbrock function using arma::fmat.
+ */
+TEST_CASE("BOBYQARosenbrockFunctionFMatTest", "[BOBYQATest]")
+{
+  RosenbrockFunction f;
+  BOBYQA optimizer(2000, 0.5, 1e-4);
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  optimizer.Optimize(f, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(0.01));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(0.01));
+}
+
+/**
+ * Test BOBYQA on the Colville function.
+ */
+TEST_CASE("BOBYQAColvilleFunctionTest", "[BOBYQATest]")
+{
+  ColvilleFunction f;
+  BOBYQA optimizer(5000, 0.5, 1e-8);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(1.0).epsilon(1e-4));
+}
+
+/**
+ * Test BOBYQA on the Rosenbrock function with an active upper bound; the
+ * solution is then (0.5, 0.25).
+ */
+TEST_CASE("BOBYQABoundConstrainedTest", "[BOBYQATest]")
+{
+  RosenbrockFunction f;
+  arma::mat lowerBound("-2; -2");
+  arma::mat upperBound("0.5; 2");
+  BOBYQA optimizer(3000, 0.5, 1e-8, lowerBound, upperBound);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(0.5).epsilon(1e-6));
+  REQUIRE(coordinates(1) == Approx(0.25).epsilon(1e-4));
+}
+
+/**
+ * Test BOBYQA with several geometry improving points evaluated together.
+ */
+TEST_CASE("BOBYQAParallelColvilleFunctionTest", "[BOBYQATest]")
+{
+  ColvilleFunction f;
+  BOBYQA optimizer(5000, 0.5, 1e-8, -arma::datum::inf, arma::datum::inf,
+      2);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(1.0).epsilon(1e-4));
+}
+
+/**
+ * Bounds that are too close to each other must be rejected.
+ */
+TEST_CASE("BOBYQAInvalidBoundsTest", "[BOBYQATest]")
+{
+  RosenbrockFunction f;
+  BOBYQA optimizer(100, 0.5, 1e-6, 0.0, 0.5);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  REQUIRE_THROWS_AS(optimizer.Optimize(f, coordinates), std::invalid_argument);
+}
@@ -489,6 +489,105 @@ TEST_CASE("EarlyStopAtMinLossCallbackTest", "[CallbacksTest]")
   REQUIRE(coordinates(2) == Approx(0.0).margin(1e-7));
 }
 
+/**
+ * Make sure the EarlyStopAtValidationLoss callback will stop the optimization
+ * process and restore the coordinates with the best held-out loss.
+ */
+TEST_CASE("EarlyStopAtValidationLossCallbackTest", "[CallbacksTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+  LogisticRegression<> validation(testData, testResponses, 0.5);
+
+  // Instantiate the optimizer with a number of iterations that will take a
+  // long time to finish.
+  StandardSGD s(0.0003, 1, 2000000000, -10);
+
+  EarlyStopAtValidationLoss<LogisticRegression<>> cb(validation, 0, 3);
+  arma::mat coordinates = lr.GetInitialPoint();
+  s.Optimize(lr, coordinates, cb);
+
+  REQUIRE(cb.Evaluations() > 3);
+  REQUIRE(validation.Evaluate(coordinates, 0, validation.NumFunctions()) /
+      validation.NumFunctions() == Approx(cb.BestObjective()).epsilon(1e-7));
+
+  const double acc = lr.ComputeAccuracy(testData, testResponses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+}
+
+/**
+ * Make sure the EarlyStopAtValidationLoss callback will stop the optimization
+ * process when the held-out loss is estimated on a subsample.
+ */
+TEST_CASE("EarlyStopAtValidationLossSubsampleCallbackTest", "[CallbacksTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+  LogisticRegression<> validation(testData, testResponses, 0.5);
+
+  StandardSGD s(0.0003, 1, 2000000000, -10);
+
+  // Evaluate 100 held-out points every 500 steps, averaging the last three
+  // estimates and requiring an improvement of one standard error.
+  EarlyStopAtValidationLoss<LogisticRegression<>> cb(validation, 500, 5, 100,
+      3, 1.0);
+  arma::mat coordinates = lr.GetInitialPoint();
+  s.Optimize(lr, coordinates, cb);
+
+  REQUIRE(cb.Evaluations() > 5);
+  REQUIRE(arma::approx_equal(coordinates, cb.BestCoordinates(), "absdiff",
+      1e-10));
+
+  const double acc = lr.ComputeAccuracy(testData, testResponses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+}
+
+// A held-out function whose loss is always NaN, like after a diverged run.
+class NaNValidationFunction
+{
+ public:
+  size_t NumFunctions() const { return 10; }
+
+  double Evaluate(const arma::mat& /* coordinates */,
+                  const size_t /* begin */,
+                  const size_t /* batchSize */) const
+  {
+    return arma::datum::nan;
+  }
+};
+
+/**
+ * Make sure the EarlyStopAtValidationLoss callback does not overwrite the
+ * coordinates if no held-out estimate was ever finite.
+ */
+TEST_CASE("EarlyStopAtValidationLossNaNCallbackTest", "[CallbacksTest]")
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+  const size_t rows = coordinates.n_rows;
+  const size_t cols = coordinates.n_cols;
+
+  StandardSGD s(0.0003, 1, 2000000000, -10);
+
+  NaNValidationFunction validation;
+  EarlyStopAtValidationLoss<NaNValidationFunction> cb(validation, 100, 3);
+  s.Optimize(f, coordinates, cb);
+
+  REQUIRE(cb.Evaluations() == 3);
+  REQUIRE(cb.BestCoordinates().is_empty());
+  REQUIRE(coordinates.n_rows == rows);
+  REQUIRE(coordinates.n_cols == cols);
+  REQUIRE(coordinates.is_finite());
+}
+
 /**
  * Make sure the PrintLoss callback will print the loss to the specified
  * output stream.
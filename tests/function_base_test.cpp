@@ -0,0 +1,135 @@
+/**
+ * @file function_base_test.cpp
+ *
+ * Tests for optimizing functions through the abstract function base classes.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * A DifferentiableFunctionBase that forwards to the given function.
+ */
+template<typename FunctionType, typename MatType>
+class DifferentiableAdapter : public DifferentiableFunctionBase<MatType>
+{
+ public:
+  typedef typename MatType::elem_type ElemType;
+
+  DifferentiableAdapter(const FunctionType& function) : function(function) { }
+
+  ElemType Evaluate(const MatType& coordinates) override
+  {
+    return function.Evaluate(coordinates);
+  }
+
+  void Gradient(const MatType& coordinates, MatType& gradient) override
+  {
+    function.Gradient(coordinates, gradient);
+  }
+
+  FunctionType function;
+};
+
+/**
+ * A SeparableFunctionBase that forwards to the given function.
+ */
+template<typename FunctionType, typename MatType>
+class SeparableAdapter : public SeparableFunctionBase<MatType>
+{
+ public:
+  typedef typename MatType::elem_type ElemType;
+
+  SeparableAdapter(const FunctionType& function) : function(function) { }
+
+  size_t NumFunctions() const override { return function.NumFunctions(); }
+
+  void Shuffle() override { function.Shuffle(); }
+
+  ElemType Evaluate(const MatType& coordinates,
+                    const size_t begin,
+                    const size_t batchSize) override
+  {
+    return function.Evaluate(coordinates, begin, batchSize);
+  }
+
+  void Gradient(const MatType& coordinates,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize) override
+  {
+    function.Gradient(coordinates, begin, gradient, batchSize);
+  }
+
+  FunctionType function;
+};
+
+/**
+ * Make sure that L-BFGS can optimize a DifferentiableFunctionBase.
+ */
+TEST_CASE("FunctionBaseLBFGSTest", "[FunctionBaseTest]")
+{
+  RosenbrockFunction rosenbrock;
+  DifferentiableAdapter<RosenbrockFunction, arma::mat> f(rosenbrock);
+  DifferentiableFunctionBase<arma::mat>& base = f;
+
+  L_BFGS lbfgs;
+  arma::mat coordinates = f.function.GetInitialPoint();
+  const double result = lbfgs.Optimize(base, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-5));
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-5));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-5));
+}
+
+/**
+ * Make sure that GradientDescent can optimize a DifferentiableFunctionBase
+ * with arma::fmat.
+ */
+TEST_CASE("FunctionBaseGradientDescentFMatTest", "[FunctionBaseTest]")
+{
+  GDTestFunction gdTest;
+  DifferentiableAdapter<GDTestFunction, arma::fmat> f(gdTest);
+  DifferentiableFunctionBase<arma::fmat>& base = f;
+
+  GradientDescent s(0.01, 5000000, 1e-9);
+  arma::fmat coordinates = f.function.GetInitialPoint<arma::fmat>();
+  s.Optimize(base, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(1e-2));
+  REQUIRE(coordinates(2) == Approx(0.0).margin(1e-2));
+}
+
+/**
+ * Make sure that Adam and CMA-ES can optimize a SeparableFunctionBase.
+ */
+TEST_CASE("FunctionBaseSeparableTest", "[FunctionBaseTest]")
+{
+  SeparableAdapter<SphereFunction, arma::mat> f(SphereFunction(2));
+  SeparableFunctionBase<arma::mat>& base = f;
+
+  Adam adam(0.5, 2, 0.7, 0.999, 1e-8, 500000, 1e-3, false);
+  arma::mat coordinates = f.function.GetInitialPoint();
+  adam.Optimize(base, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(0.0).margin(0.1));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(0.1));
+
+  CMAES<> cmaes(0, -10, 10, 32, 200, -1);
+  coordinates = f.function.GetInitialPoint();
+  cmaes.Optimize(base, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(0.0).margin(0.003));
+  REQUIRE(coordinates(1) == Approx(0.0).margin(0.003));
+}
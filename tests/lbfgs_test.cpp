@@ -12,6 +12,7 @@
 
 #include <ensmallen.hpp>
 #include "catch.hpp"
+#include "test_function_tools.hpp"
 
 using namespace ens;
 using namespace ens::test;
@@ -180,3 +181,114 @@ TEST_CASE("RosenbrockWoodFunctionTest", "[LBFGSTest]")
     REQUIRE((coords(row, 1)) == Approx(1.0).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that reusing the curvature history of a previous call gives the
+ * same solution as a cold start, on a sequence of logistic regression problems
+ * with decreasing regularization.
+ */
+TEST_CASE("LBFGSWarmStartTest", "[LBFGSTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+
+  LogisticRegressionFunction<> f(shuffledData, shuffledResponses, 1.0);
+
+  L_BFGS warm;
+  warm.ResetPolicy() = false;
+  arma::mat warmCoords = f.InitialPoint();
+  warm.Optimize(f, warmCoords);
+
+  for (size_t k = 0; k < 3; ++k)
+  {
+    f.Lambda() *= 0.5;
+    const double warmObjective = warm.Optimize(f, warmCoords);
+
+    L_BFGS cold;
+    arma::mat coldCoords = f.InitialPoint();
+    const double coldObjective = cold.Optimize(f, coldCoords);
+
+    REQUIRE(warmObjective == Approx(coldObjective).epsilon(1e-5));
+    for (size_t j = 0; j < coldCoords.n_elem; ++j)
+      REQUIRE(warmCoords(j) == Approx(coldCoords(j)).margin(1e-2));
+  }
+}
+
+// An ill-conditioned ridge-regularized quadratic that counts its evaluations.
+class CountingQuadraticFunction
+{
+ public:
+  CountingQuadraticFunction(const size_t dimensions) :
+      diagonal(arma::logspace<arma::vec>(0, 3, dimensions)),
+      linear(dimensions, arma::fill::ones),
+      lambda(1.0),
+      evaluations(0)
+  { }
+
+  double EvaluateWithGradient(const arma::mat& x, arma::mat& gradient)
+  {
+    ++evaluations;
+    gradient = (diagonal + lambda) % x - linear;
+    return 0.5 * arma::dot(x, (diagonal + lambda) % x) -
+        arma::dot(linear, x);
+  }
+
+  double Evaluate(const arma::mat& x)
+  {
+    arma::mat gradient;
+    return EvaluateWithGradient(x, gradient);
+  }
+
+  void Gradient(const arma::mat& x, arma::mat& gradient)
+  {
+    EvaluateWithGradient(x, gradient);
+  }
+
+  arma::vec diagonal;
+  arma::vec linear;
+  double lambda;
+  size_t evaluations;
+};
+
+/**
+ * Make sure that the curvature history of the previous call is actually
+ * reused: starting from the same point, the warm started solve of a nearby
+ * problem must need fewer evaluations than a cold one.
+ */
+TEST_CASE("LBFGSWarmStartHistoryTest", "[LBFGSTest]")
+{
+  CountingQuadraticFunction f(50);
+
+  // Solve the first problem, keeping the history.
+  L_BFGS lbfgs(50);
+  lbfgs.ResetPolicy() = false;
+  arma::mat first(50, 1, arma::fill::zeros);
+  lbfgs.Optimize(f, first);
+
+  f.lambda = 0.9;
+
+  L_BFGS cold(50);
+  arma::mat coldCoords(first);
+  f.evaluations = 0;
+  cold.Optimize(f, coldCoords);
+  const size_t coldEvaluations = f.evaluations;
+
+  L_BFGS cleared(lbfgs);
+  arma::mat warmCoords(first);
+  f.evaluations = 0;
+  lbfgs.Optimize(f, warmCoords);
+  const size_t warmEvaluations = f.evaluations;
+
+  REQUIRE(warmEvaluations < coldEvaluations);
+  for (size_t i = 0; i < warmCoords.n_elem; ++i)
+    REQUIRE(warmCoords(i) == Approx(coldCoords(i)).margin(1e-5));
+
+  // Without the history, the solve is the same as a cold one.
+  cleared.ClearHistory();
+  arma::mat clearedCoords(first);
+  f.evaluations = 0;
+  cleared.Optimize(f, clearedCoords);
+  REQUIRE(f.evaluations == coldEvaluations);
+}
@@ -58,3 +58,114 @@ TEST_CASE("FuncFWFMatTest", "[LineSearchTest]")
   REQUIRE((x2(1) - 0.2) == Approx(0.0).margin(1e-5));
   REQUIRE((x2(2) - 0.3) == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * A function that forwards to FuncSq, but does not expose its least squares
+ * form, so that the line search uses the secant method.
+ */
+class GenericFuncSq
+{
+ public:
+  GenericFuncSq(FuncSq& f) : f(f) { }
+
+  double Evaluate(const arma::mat& coords) { return f.Evaluate(coords); }
+
+  void Gradient(const arma::mat& coords, arma::mat& gradient)
+  {
+    f.Gradient(coords, gradient);
+  }
+
+ private:
+  FuncSq& f;
+};
+
+/**
+ * Test the closed-form line search path with FuncSq, and make sure it agrees
+ * with the secant method on the same problem.
+ */
+TEST_CASE("FuncSqClosedFormTest", "[LineSearchTest]")
+{
+  mat A = randu<mat>(10, 3);
+  vec b = randu<vec>(10);
+  FuncSq f(A, b);
+
+  mat x1 = zeros<mat>(3, 1);
+  mat x2 = ones<mat>(3, 1);
+
+  LineSearch s(100000, 1e-10);
+  const double result = s.Optimize(f, x1, x2);
+
+  // The minimizer of 0.5 * ||A (gamma * 1) - b||^2 over gamma in [0, 1].
+  const vec a1 = A * ones<vec>(3);
+  double gamma = dot(a1, b) / dot(a1, a1);
+  gamma = std::min(std::max(gamma, 0.0), 1.0);
+
+  REQUIRE(result == Approx(0.5 * dot(gamma * a1 - b, gamma * a1 - b)));
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(x2(i) == Approx(gamma).margin(1e-10));
+
+  // The secant method finds the same point.
+  GenericFuncSq g(f);
+  mat x3 = ones<mat>(3, 1);
+  const double secantResult = s.Optimize(g, x1, x3);
+
+  REQUIRE(secantResult == Approx(result).epsilon(1e-6));
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(x3(i) == Approx(x2(i)).margin(1e-6));
+}
+
+/**
+ * A ridge regression objective, 0.5 * ||Ax - b||^2 + 0.5 * mu * ||x||^2, that
+ * provides MatrixA() and Vectorb() but is not a pure least squares function.
+ */
+class RidgeFuncSq
+{
+ public:
+  RidgeFuncSq(const arma::mat& A, const arma::vec& b, const double mu) :
+      A(A), b(b), mu(mu) { }
+
+  double Evaluate(const arma::mat& coords)
+  {
+    const arma::vec r = A * coords - b;
+    return 0.5 * dot(r, r) + 0.5 * mu * accu(square(coords));
+  }
+
+  void Gradient(const arma::mat& coords, arma::mat& gradient)
+  {
+    gradient = A.t() * (A * coords - b) + mu * coords;
+  }
+
+  const arma::mat& MatrixA() const { return A; }
+  const arma::vec& Vectorb() const { return b; }
+
+ private:
+  arma::mat A;
+  arma::vec b;
+  double mu;
+};
+
+/**
+ * Make sure that functions with MatrixA() and Vectorb() that do not opt in to
+ * the least squares form use the secant method.
+ */
+TEST_CASE("RidgeFuncSqLineSearchTest", "[LineSearchTest]")
+{
+  mat A = randu<mat>(10, 3);
+  vec b = randu<vec>(10);
+  const double mu = 5.0;
+  RidgeFuncSq f(A, b, mu);
+
+  mat x1 = zeros<mat>(3, 1);
+  mat x2 = ones<mat>(3, 1);
+
+  LineSearch s(100000, 1e-10);
+  s.Optimize(f, x1, x2);
+
+  // The minimizer of 0.5 * ||A (gamma * 1) - b||^2 + 1.5 * mu * gamma^2.
+  const vec a1 = A * ones<vec>(3);
+  double gamma = dot(a1, b) / (dot(a1, a1) + 3 * mu);
+  gamma = std::min(std::max(gamma, 0.0), 1.0);
+
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(x2(i) == Approx(gamma).margin(1e-6));
+}
@@ -246,6 +246,62 @@ TEST_CASE("ErdosRenyiRandomGraphMaxCutSDP", "[LRSDPTest]")
   REQUIRE(finalValue == Approx(-3672.7).epsilon(1e-3));
 }
 
+/**
+ * Solve the same max-cut SDP as above, but start with rank 2 and let LRSDP
+ * adapt the rank.
+ */
+TEST_CASE("ErdosRenyiRandomGraphMaxCutRankAdaptiveSDP", "[LRSDPTest]")
+{
+  // Load the edges.
+  arma::mat edges;
+
+  if (edges.load("data/erdosrenyi-n100.csv", arma::csv_ascii) == false)
+  {
+    FAIL("couldn't load data");
+    return;
+  }
+
+  edges = edges.t();
+
+  arma::sp_mat laplacian;
+  CreateSparseGraphLaplacian(edges, laplacian);
+
+  float r = 0.5 + sqrt(0.25 + 2 * edges.n_cols);
+  if (ceil(r) > laplacian.n_rows)
+    r = laplacian.n_rows;
+
+  // Initialize coordinates to a feasible point of rank 2.
+  arma::mat coordinates(laplacian.n_rows, 2);
+  coordinates.zeros();
+  for (size_t i = 0; i < coordinates.n_rows; ++i)
+  {
+    coordinates(i, i % coordinates.n_cols) = 1.;
+  }
+
+  LRSDP<SDP<arma::sp_mat>> maxcut(laplacian.n_rows, 0, coordinates);
+  maxcut.SDP().C() = laplacian;
+  maxcut.SDP().C() *= -1.; // need to minimize the negative
+  maxcut.SDP().SparseB().ones(laplacian.n_rows);
+  for (size_t i = 0; i < laplacian.n_rows; ++i)
+  {
+    maxcut.SDP().SparseA()[i].zeros(laplacian.n_rows, laplacian.n_rows);
+    maxcut.SDP().SparseA()[i](i, i) = 1.;
+  }
+  maxcut.MaxRank() = ceil(r);
+
+  const double finalValue = maxcut.Optimize(coordinates);
+  const arma::mat rrt = coordinates * trans(coordinates);
+
+  REQUIRE(coordinates.n_cols <= maxcut.MaxRank());
+  for (size_t i = 0; i < laplacian.n_rows; ++i)
+  {
+    REQUIRE(rrt(i, i) == Approx(1.0).epsilon(1e-5));
+  }
+
+  // Final value taken by solving with Mosek
+  REQUIRE(finalValue == Approx(-3672.7).epsilon(1e-3));
+}
+
 /*
  * Test a nuclear norm minimization SDP.
  *
@@ -0,0 +1,141 @@
+/**
+ * @file memoized_function_test.cpp
+ *
+ * Tests for the MemoizedFunction wrapper.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * The squared norm, counting its evaluations.
+ */
+class CountingSquaredFunction
+{
+ public:
+  CountingSquaredFunction() : evaluations(0) { }
+
+  double Evaluate(const arma::mat& coordinates)
+  {
+    ++evaluations;
+    return arma::accu(arma::square(coordinates));
+  }
+
+  size_t evaluations;
+};
+
+/**
+ * Make sure that repeated points are answered from the cache.
+ */
+TEST_CASE("MemoizedFunctionHitTest", "[MemoizedFunctionTest]")
+{
+  CountingSquaredFunction f;
+  MemoizedFunction<CountingSquaredFunction> memoized(f);
+
+  arma::mat a("1; 2");
+  arma::mat b("3; 4");
+  REQUIRE(memoized.Evaluate(a) == Approx(5.0));
+  REQUIRE(memoized.Evaluate(b) == Approx(25.0));
+  REQUIRE(memoized.Evaluate(a) == Approx(5.0));
+  REQUIRE(memoized.Evaluate(b) == Approx(25.0));
+
+  REQUIRE(f.evaluations == 2);
+  REQUIRE(memoized.Hits() == 2);
+  REQUIRE(memoized.Misses() == 2);
+  REQUIRE(memoized.HitRate() == Approx(0.5));
+  REQUIRE(memoized.Size() == 2);
+
+  // The same elements in another shape are another point.
+  arma::mat c("1 2");
+  memoized.Evaluate(c);
+  REQUIRE(f.evaluations == 3);
+
+  memoized.Clear();
+  REQUIRE(memoized.Size() == 0);
+  REQUIRE(memoized.Hits() == 0);
+  memoized.Evaluate(a);
+  REQUIRE(f.evaluations == 4);
+}
+
+/**
+ * Make sure that the least recently used entry is dropped when the cache is
+ * full.
+ */
+TEST_CASE("MemoizedFunctionEvictionTest", "[MemoizedFunctionTest]")
+{
+  CountingSquaredFunction f;
+  MemoizedFunction<CountingSquaredFunction> memoized(f, 2);
+
+  arma::mat a("1"), b("2"), c("3");
+  memoized.Evaluate(a);
+  memoized.Evaluate(b);
+  memoized.Evaluate(a); // Now b is the least recently used entry.
+  memoized.Evaluate(c); // Drops b.
+  REQUIRE(memoized.Size() == 2);
+  REQUIRE(f.evaluations == 3);
+
+  memoized.Evaluate(a);
+  REQUIRE(f.evaluations == 3);
+  memoized.Evaluate(b);
+  REQUIRE(f.evaluations == 4);
+}
+
+/**
+ * Make sure that points that round to the same multiple of the tolerance share
+ * one entry.
+ */
+TEST_CASE("MemoizedFunctionToleranceTest", "[MemoizedFunctionTest]")
+{
+  CountingSquaredFunction f;
+  MemoizedFunction<CountingSquaredFunction> memoized(f, 100, 1e-3);
+
+  arma::mat a("1.0; -2.0");
+  arma::mat b("1.0002; -2.0001");
+  arma::mat c("1.002; -2.0");
+  memoized.Evaluate(a);
+  REQUIRE(memoized.Evaluate(b) == Approx(5.0));
+  REQUIRE(f.evaluations == 1);
+  memoized.Evaluate(c);
+  REQUIRE(f.evaluations == 2);
+
+  // Without tolerance, -0 and +0 are the same point.
+  CountingSquaredFunction g;
+  MemoizedFunction<CountingSquaredFunction> exact(g);
+  arma::mat zero("0.0"), negativeZero("-0.0");
+  exact.Evaluate(zero);
+  exact.Evaluate(negativeZero);
+  REQUIRE(g.evaluations == 1);
+}
+
+/**
+ * Make sure that an optimizer can use the wrapper in place of the function:
+ * running GridSearch twice evaluates every grid point once.
+ */
+TEST_CASE("MemoizedFunctionGridSearchTest", "[MemoizedFunctionTest]")
+{
+  CountingSquaredFunction f;
+  MemoizedFunction<CountingSquaredFunction> memoized(f);
+
+  std::vector<bool> categoricalDimensions(2, true);
+  arma::Row<size_t> numCategories("4 5");
+
+  GridSearch optimizer;
+  arma::mat params;
+  optimizer.Optimize(memoized, params, categoricalDimensions, numCategories);
+  optimizer.Optimize(memoized, params, categoricalDimensions, numCategories);
+
+  REQUIRE(f.evaluations == 20);
+  REQUIRE(memoized.Hits() == 20);
+  REQUIRE(params(0) == 0);
+  REQUIRE(params(1) == 0);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file nelder_mead_test.cpp
+ *
+ * Test file for the Nelder-Mead optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Test the Nelder-Mead optimizer on the Rosenbrock function.
+ */
+TEST_CASE("NelderMeadRosenbrockFunctionTest", "[NelderMeadTest]")
+{
+  RosenbrockFunction f;
+  NelderMead optimizer(10000, 1e-15);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double result = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-8));
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-3));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-3));
+}
+
+/**
+ * Test the Nelder-Mead optimizer on the Rosenbrock function using arma::fmat.
+ */
+TEST_CASE("NelderMeadRosenbrockFunctionFMatTest", "[NelderMeadTest]")
+{
+  RosenbrockFunction f;
+  NelderMead optimizer(10000, 1e-10);
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  optimizer.Optimize(f, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(0.01));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(0.01));
+}
+
+/**
+ * Test the non-adaptive Nelder-Mead optimizer on the Sphere function.
+ */
+TEST_CASE("NelderMeadStandardSphereFunctionTest", "[NelderMeadTest]")
+{
+  SphereFunction f(4);
+  NelderMead optimizer(10000, 1e-15, 0.05, false);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(0.0).margin(1e-4));
+}
+
+/**
+ * Test the parallel Nelder-Mead optimizer, moving three vertices at a time, on
+ * the Sphere function.
+ */
+TEST_CASE("NelderMeadParallelSphereFunctionTest", "[NelderMeadTest]")
+{
+  SphereFunction f(10);
+  NelderMead optimizer(100000, 1e-15, 0.05, true, 3);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * The number of vertices moved at once is capped at half the dimension, so a
+ * large numParallel must still work.
+ */
+TEST_CASE("NelderMeadParallelCappedTest", "[NelderMeadTest]")
+{
+  GeneralizedRosenbrockFunction f(4);
+  NelderMead optimizer(100000, 1e-15, 0.05, true, 10);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  for (size_t i = 0; i < coordinates.n_elem; ++i)
+    REQUIRE(coordinates(i) == Approx(1.0).epsilon(1e-3));
+}
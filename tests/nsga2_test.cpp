@@ -0,0 +1,139 @@
+/**
+ * @file nsga2_test.cpp
+ *
+ * Test file for the NSGA-II multi-objective optimizer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Three objectives: the squared distances to the corners of the triangle
+ * (0, 0), (1, 0), (0, 1), which is the Pareto set.
+ */
+class TriangleFunction
+{
+ public:
+  template<typename MatType>
+  arma::Col<typename MatType::elem_type> Evaluate(const MatType& coordinates)
+      const
+  {
+    arma::Col<typename MatType::elem_type> objectives(3);
+    objectives(0) = std::pow(coordinates(0), 2) + std::pow(coordinates(1), 2);
+    objectives(1) = std::pow(coordinates(0) - 1, 2) +
+        std::pow(coordinates(1), 2);
+    objectives(2) = std::pow(coordinates(0), 2) +
+        std::pow(coordinates(1) - 1, 2);
+    return objectives;
+  }
+};
+
+/**
+ * Make sure that NSGA-II finds the Pareto set of Schaffer function N.1, and
+ * that it covers the whole set.
+ */
+TEST_CASE("NSGA2SchafferN1Test", "[NSGA2Test]")
+{
+  SchafferFunctionN1 f;
+  NSGA2 optimizer(50, 100, 0.9, 0.1, 20.0, -1000.0, 1000.0);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  const arma::mat& paretoSet = optimizer.ParetoSet();
+  const arma::mat& paretoFront = optimizer.ParetoFront();
+  REQUIRE(paretoSet.n_rows == 1);
+  REQUIRE(paretoFront.n_rows == 2);
+  REQUIRE(paretoFront.n_cols == paretoSet.n_cols);
+  REQUIRE(paretoSet.n_cols >= 25);
+
+  REQUIRE(paretoSet.min() >= -0.1);
+  REQUIRE(paretoSet.max() <= 2.1);
+  REQUIRE(paretoSet.min() <= 0.1);
+  REQUIRE(paretoSet.max() >= 1.9);
+
+  // The starting point is replaced by the member with the smallest sum of the
+  // objectives, which is near x = 1.
+  REQUIRE(coordinates(0) == Approx(1.0).margin(0.2));
+}
+
+/**
+ * Make sure that NSGA-II works with arma::fmat.
+ */
+TEST_CASE("NSGA2SchafferN1FMatTest", "[NSGA2Test]")
+{
+  SchafferFunctionN1 f;
+  NSGA2 optimizer(50, 100, 0.9, 0.1, 20.0, -1000.0, 1000.0);
+
+  arma::fmat coordinates = f.GetInitialPoint<arma::fmat>();
+  optimizer.Optimize(f, coordinates);
+
+  const arma::mat& paretoSet = optimizer.ParetoSet();
+  REQUIRE(paretoSet.min() >= -0.1);
+  REQUIRE(paretoSet.max() <= 2.1);
+}
+
+/**
+ * Make sure that the Pareto front of the Fonseca-Fleming function is found:
+ * every point of the front must lie near the true (concave) front.
+ */
+TEST_CASE("NSGA2FonsecaFlemingTest", "[NSGA2Test]")
+{
+  FonsecaFlemingFunction f;
+  NSGA2 optimizer(50, 300, 0.9, 0.1, 20.0, -4.0, 4.0);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  optimizer.Optimize(f, coordinates);
+
+  // On the true front, x = (t, t, t) with |t| <= 1 / sqrt(3), so f_2 follows
+  // from f_1.
+  const double s = 1.0 / std::sqrt(3.0);
+  const arma::mat& paretoFront = optimizer.ParetoFront();
+  REQUIRE(paretoFront.n_cols >= 25);
+  for (size_t i = 0; i < paretoFront.n_cols; ++i)
+  {
+    const double f1 = std::min(paretoFront(0, i), 1.0 - 1e-12);
+    const double t = std::max(s - std::sqrt(-std::log(1.0 - f1) / 3.0), -s);
+    const double f2 = 1.0 - std::exp(-3.0 * std::pow(t + s, 2.0));
+    REQUIRE(paretoFront(1, i) == Approx(f2).margin(0.1));
+  }
+}
+
+/**
+ * Make sure that the general non-dominated sorting (three objectives) works:
+ * each corner of the triangle must be found.
+ */
+TEST_CASE("NSGA2ThreeObjectivesTest", "[NSGA2Test]")
+{
+  TriangleFunction f;
+  NSGA2 optimizer(60, 200, 0.9, 0.1, 20.0, -2.0, 2.0);
+
+  arma::mat coordinates("3; 3");
+  optimizer.Optimize(f, coordinates);
+
+  const arma::mat& paretoSet = optimizer.ParetoSet();
+  const arma::mat& paretoFront = optimizer.ParetoFront();
+  REQUIRE(paretoFront.n_rows == 3);
+  for (size_t m = 0; m < 3; ++m)
+    REQUIRE(paretoFront.row(m).min() <= 1e-3);
+
+  // Nearly all of the front must be within the triangle.
+  size_t inside = 0;
+  for (size_t i = 0; i < paretoSet.n_cols; ++i)
+  {
+    if (paretoSet(0, i) >= -0.05 && paretoSet(1, i) >= -0.05 &&
+        paretoSet(0, i) + paretoSet(1, i) <= 1.05)
+      ++inside;
+  }
+  REQUIRE(inside >= 0.6 * paretoSet.n_cols);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file numerical_gradient_function_test.cpp
+ *
+ * Tests for the NumericalGradientFunction and
+ * NumericalSeparableGradientFunction wrappers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace arma;
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * The Rosenbrock function, with only Evaluate().  It is written with plain
+ * arithmetic, so that it can also be evaluated at complex points.
+ */
+class EvaluateOnlyRosenbrockFunction
+{
+ public:
+  template<typename MatType>
+  typename MatType::elem_type Evaluate(const MatType& coordinates) const
+  {
+    typedef typename MatType::elem_type ElemType;
+    const ElemType a = coordinates(1) - coordinates(0) * coordinates(0);
+    const ElemType b = ElemType(1) - coordinates(0);
+    return ElemType(100) * a * a + b * b;
+  }
+};
+
+/**
+ * Compare the gradient of each scheme with the exact gradient.
+ */
+TEST_CASE("NumericalGradientAccuracyTest", "[NumericalGradientFunctionTest]")
+{
+  EvaluateOnlyRosenbrockFunction f;
+  RosenbrockFunction exact;
+
+  arma::mat coordinates("-1.2; 1.0");
+  arma::mat expected;
+  exact.Gradient(coordinates, expected);
+
+  arma::mat gradient;
+  NumericalGradientFunction<EvaluateOnlyRosenbrockFunction, ForwardDifference>
+      forward(f);
+  forward.Gradient(coordinates, gradient);
+  REQUIRE(gradient.n_rows == 2);
+  REQUIRE(gradient.n_cols == 1);
+  for (size_t i = 0; i < 2; ++i)
+    REQUIRE(gradient(i) == Approx(expected(i)).epsilon(1e-5));
+
+  NumericalGradientFunction<EvaluateOnlyRosenbrockFunction> central(f);
+  const double objective = central.EvaluateWithGradient(coordinates, gradient);
+  REQUIRE(objective == Approx(exact.Evaluate(coordinates)));
+  for (size_t i = 0; i < 2; ++i)
+    REQUIRE(gradient(i) == Approx(expected(i)).epsilon(1e-8));
+
+  NumericalGradientFunction<EvaluateOnlyRosenbrockFunction, ComplexStep>
+      complexStep(f);
+  complexStep.Gradient(coordinates, gradient);
+  for (size_t i = 0; i < 2; ++i)
+    REQUIRE(gradient(i) == Approx(expected(i)).epsilon(1e-13));
+}
+
+/**
+ * Make sure that L-BFGS can minimize a function that only has Evaluate().
+ */
+TEST_CASE("NumericalGradientLBFGSTest", "[NumericalGradientFunctionTest]")
+{
+  EvaluateOnlyRosenbrockFunction f;
+  NumericalGradientFunction<EvaluateOnlyRosenbrockFunction> g(f);
+
+  L_BFGS lbfgs;
+  arma::mat coordinates("-1.2; 1.0");
+  const double result = lbfgs.Optimize(g, coordinates);
+
+  REQUIRE(result == Approx(0.0).margin(1e-8));
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-4));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-4));
+}
+
+/**
+ * Make sure that the complex step works with arma::fmat.
+ */
+TEST_CASE("NumericalGradientComplexStepFMatTest",
+          "[NumericalGradientFunctionTest]")
+{
+  EvaluateOnlyRosenbrockFunction f;
+  NumericalGradientFunction<EvaluateOnlyRosenbrockFunction, ComplexStep> g(f);
+
+  L_BFGS lbfgs;
+  arma::fmat coordinates("-1.2; 1.0");
+  lbfgs.Optimize(g, coordinates);
+
+  REQUIRE(coordinates(0) == Approx(1.0).epsilon(1e-2));
+  REQUIRE(coordinates(1) == Approx(1.0).epsilon(1e-2));
+}
+
+/**
+ * Make sure that the separable wrapper differentiates the requested batch, and
+ * that SGD can use it.
+ */
+TEST_CASE("NumericalSeparableGradientSGDTest",
+          "[NumericalGradientFunctionTest]")
+{
+  GeneralizedRosenbrockFunction f(10);
+  NumericalSeparableGradientFunction<GeneralizedRosenbrockFunction> g(f);
+  REQUIRE(g.NumFunctions() == f.NumFunctions());
+
+  arma::mat coordinates = f.GetInitialPoint();
+  arma::mat expected, gradient;
+  f.Gradient(coordinates, 3, expected, 1);
+  g.Gradient(coordinates, 3, gradient, 1);
+  REQUIRE(gradient.n_elem == expected.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    REQUIRE(gradient(i) == Approx(expected(i)).epsilon(1e-7).margin(1e-7));
+
+  VanillaUpdate vanillaUpdate;
+  StandardSGD s(0.001, 1, 0, 1e-12, true, vanillaUpdate, NoDecay(), true,
+      true);
+  s.Optimize(g, coordinates);
+
+  for (size_t j = 0; j < 10; ++j)
+    REQUIRE(coordinates(j) == Approx(1.0).epsilon(1e-3));
+}
@@ -142,6 +142,37 @@ TEST_CASE("ParallelSGDGeneralizedRosenbrockSpMatTest", "[ParallelSGDTest]")
   }
 }
 
+/**
+ * Make sure that parallel SGD can train a softmax classifier with the sampled
+ * softmax objective.
+ */
+TEST_CASE("ParallelSGDSampledSoftmaxTest", "[ParallelSGDTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  SoftmaxTestData(data, labels, 50, 5000);
+
+  SampledSoftmaxFunction f(data, labels, 50, 10, 0.0);
+
+  const size_t threads = omp_get_max_threads();
+  ConstantStep decayPolicy(0.01);
+  ParallelSGD<ConstantStep> s(50, std::ceil((float) f.NumFunctions() /
+      threads), -1, true, decayPolicy);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double initialObjective = f.ExactEvaluate(coordinates);
+  s.Optimize(f, coordinates);
+
+  // The objective returned by ParallelSGD is a sampled estimate.
+  REQUIRE(f.ExactEvaluate(coordinates) < 0.1 * initialObjective);
+
+  arma::Row<size_t> predictions;
+  f.Classify(data, coordinates, predictions);
+  const double accuracy = arma::accu(predictions == labels) /
+      (double) labels.n_elem;
+  REQUIRE(accuracy > 0.9);
+}
+
 #endif
 
 /**
@@ -53,6 +53,57 @@ TEST_CASE("LBestPSOSphereFunctionFMatTest", "[PSOTest]")
     REQUIRE(coords(j) <= 1e-3);
 }
 
+/**
+ * Test the gbest PSO optimizer on the Sphere Function.
+ */
+TEST_CASE("GBestPSOSphereFunctionTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  GBestPSO s;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  s.Optimize(f, coords);
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * Test the von Neumann PSO optimizer on the Sphere Function.
+ */
+TEST_CASE("VonNeumannPSOSphereFunctionTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  VonNeumannPSO s;
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  s.Optimize(f, coords);
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
+/**
+ * Test the PSO optimizer with velocity clamping on the Sphere Function.
+ */
+TEST_CASE("LBestPSOVelocityClampingSphereFunctionTest", "[PSOTest]")
+{
+  SphereFunction f(4);
+  LBestPSO s(64, 1.0, 1.0, 3000, 350, 1e-10, 2.05, 2.05, LBestUpdate(0.5));
+
+  arma::mat coords = f.GetInitialPoint<arma::mat>();
+  s.Optimize(f, coords);
+
+  double finalValue = f.Evaluate(coords);
+  REQUIRE(finalValue <= 1e-5);
+  for (size_t j = 0; j < 4; ++j)
+    REQUIRE(coords(j) <= 1e-3);
+}
+
 /**
  * Test the PSO optimizer on the Rosenbrock Function.  Use arma::mat.
  */
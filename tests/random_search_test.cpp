@@ -0,0 +1,126 @@
+/**
+ * @file random_search_test.cpp
+ *
+ * Test file for the RandomSearch optimizer and its samplers.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Make sure the unscrambled Sobol sequence starts with the known points.
+ */
+TEST_CASE("SobolSamplerFirstPointsTest", "[RandomSearchTest]")
+{
+  SobolSampler sampler(false);
+  sampler.Reset(2, 4);
+
+  arma::mat points(2, 4);
+  sampler.Sample(points);
+
+  const arma::mat expected = { { 0.0, 0.5, 0.75, 0.25 },
+                               { 0.0, 0.5, 0.25, 0.75 } };
+  REQUIRE(arma::approx_equal(points, expected, "absdiff", 1e-12));
+}
+
+/**
+ * Make sure that the first 2^m points of the scrambled Sobol sequence put
+ * exactly one point in each interval of width 2^-m on every axis, even when
+ * they are drawn in several batches.
+ */
+TEST_CASE("SobolSamplerStratificationTest", "[RandomSearchTest]")
+{
+  SobolSampler sampler;
+  sampler.Reset(10, 16);
+
+  arma::mat first(10, 5), second(10, 11);
+  sampler.Sample(first);
+  sampler.Sample(second);
+  const arma::mat points = arma::join_rows(first, second);
+
+  for (size_t d = 0; d < 10; ++d)
+  {
+    const arma::uvec bins = arma::sort(arma::conv_to<arma::uvec>::from(
+        arma::floor(16 * points.row(d).t())));
+    REQUIRE(arma::all(bins == arma::regspace<arma::uvec>(0, 15)));
+  }
+}
+
+/**
+ * Make sure that a Latin hypercube design puts exactly one point in each
+ * interval on every axis.
+ */
+TEST_CASE("LatinHypercubeSamplerStratificationTest", "[RandomSearchTest]")
+{
+  LatinHypercubeSampler sampler;
+  sampler.Reset(3, 20);
+
+  arma::mat points(3, 20);
+  sampler.Sample(points);
+
+  for (size_t d = 0; d < 3; ++d)
+  {
+    const arma::uvec bins = arma::sort(arma::conv_to<arma::uvec>::from(
+        arma::floor(20 * points.row(d).t())));
+    REQUIRE(arma::all(bins == arma::regspace<arma::uvec>(0, 19)));
+  }
+}
+
+/**
+ * Run the given kind of random search on the Booth function and make sure a
+ * point close to the minimum is found.
+ */
+template<typename OptimizerType>
+void BoothFunctionTest()
+{
+  BoothFunction f;
+  OptimizerType optimizer(4000, -10.0, 10.0, 100);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double objective = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(objective < 1.0);
+  REQUIRE(f.Evaluate(coordinates) == Approx(objective));
+  REQUIRE(arma::all(arma::vectorise(arma::abs(coordinates)) <= 10.0));
+}
+
+TEST_CASE("RandomSearchBoothFunctionTest", "[RandomSearchTest]")
+{
+  BoothFunctionTest<RandomSearch>();
+}
+
+TEST_CASE("LatinHypercubeSearchBoothFunctionTest", "[RandomSearchTest]")
+{
+  BoothFunctionTest<LatinHypercubeSearch>();
+}
+
+TEST_CASE("SobolSearchBoothFunctionTest", "[RandomSearchTest]")
+{
+  BoothFunctionTest<SobolSearch>();
+}
+
+/**
+ * Make sure that the L-BFGS refinement finds the minimum of the Booth
+ * function.
+ */
+TEST_CASE("RandomSearchRefinementTest", "[RandomSearchTest]")
+{
+  BoothFunction f;
+  SobolSearch optimizer(256, -10.0, 10.0, 64, 3);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double objective = optimizer.Optimize(f, coordinates);
+
+  REQUIRE(objective == Approx(0.0).margin(1e-5));
+  REQUIRE(coordinates(0) == Approx(1.0).margin(1e-3));
+  REQUIRE(coordinates(1) == Approx(3.0).margin(1e-3));
+}
@@ -0,0 +1,143 @@
+/**
+ * @file regularization_path_test.cpp
+ *
+ * Test the regularization path driver.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Make sure that the warm started L-BFGS path over a logistic regression
+ * problem gives the same solutions as independent fits.
+ */
+TEST_CASE("RegularizationPathLBFGSLogisticRegressionTest",
+    "[RegularizationPathTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+
+  LogisticRegression<> lr(shuffledData, shuffledResponses);
+  const arma::vec lambdas = RegularizationPath<>::LogGrid(10.0, 20, 1e-3);
+
+  RegularizationPath<> path;
+  arma::mat coordinates = lr.GetInitialPoint();
+  std::vector<arma::mat> solutions;
+  const arma::vec objectives = path.Optimize(lr, lambdas, coordinates,
+      solutions);
+
+  RegularizationPath<> independent(L_BFGS(), 1, false);
+  arma::mat independentCoordinates = lr.GetInitialPoint();
+  std::vector<arma::mat> independentSolutions;
+  const arma::vec independentObjectives = independent.Optimize(lr, lambdas,
+      independentCoordinates, independentSolutions);
+
+  REQUIRE(solutions.size() == lambdas.n_elem);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    REQUIRE(objectives[i] == Approx(independentObjectives[i]).epsilon(1e-5));
+
+    lr.Lambda() = lambdas[i];
+    REQUIRE(lr.Evaluate(solutions[i]) == Approx(objectives[i]).epsilon(1e-8));
+  }
+
+  // The iterate holds the solution for the smallest strength.
+  CheckMatrices(coordinates, solutions[lambdas.n_elem - 1]);
+
+  // The least regularized model classifies the data well.
+  const double acc = lr.ComputeAccuracy(testData, testResponses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+}
+
+/**
+ * Compute a Lasso path with ScreenedSCD, sequentially and in parallel
+ * segments, and make sure every solution is optimal.
+ */
+TEST_CASE("RegularizationPathScreenedSCDLassoTest", "[RegularizationPathTest]")
+{
+  const size_t features = 200;
+  const size_t points = 100;
+  arma::mat predictors(features, points, arma::fill::randn);
+  predictors.each_col() /= arma::sqrt(arma::sum(arma::square(predictors), 1) /
+      points);
+  arma::rowvec coefficients(features, arma::fill::zeros);
+  coefficients.subvec(0, 2) = arma::rowvec("2.0 -1.0 1.5");
+  const arma::rowvec responses = coefficients * predictors +
+      0.1 * arma::randn<arma::rowvec>(points);
+
+  LassoFunction f(predictors, responses);
+
+  // Visit the grid in increasing order; the driver sorts it.
+  const arma::vec lambdas = arma::flipud(RegularizationPath<ScreenedSCD>::
+      LogGrid(f.LambdaMax(), 15, 0.05));
+
+  ScreenedSCD scd(1.0, 1.0, 0, 1e-8);
+  RegularizationPath<ScreenedSCD> path(scd);
+  arma::mat coordinates = f.GetInitialPoint();
+  std::vector<arma::mat> solutions;
+  const arma::vec objectives = path.Optimize(f, lambdas, coordinates,
+      solutions);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    REQUIRE(f.DualityGap(solutions[i], lambdas[i]) <= 1e-8);
+    REQUIRE(objectives[i] == Approx(f.Evaluate(solutions[i]) + lambdas[i] *
+        arma::accu(arma::abs(solutions[i]))).epsilon(1e-8));
+  }
+
+  // The largest strength is the last one, and its solution is zero.
+  REQUIRE(arma::accu(arma::abs(solutions[lambdas.n_elem - 1])) ==
+      Approx(0.0).margin(1e-10));
+  CheckMatrices(coordinates, solutions[0]);
+
+  // Solving in parallel segments gives the same path.
+  path.NumSegments() = 4;
+  arma::mat parallelCoordinates = f.GetInitialPoint();
+  std::vector<arma::mat> parallelSolutions;
+  const arma::vec parallelObjectives = path.Optimize(f, lambdas,
+      parallelCoordinates, parallelSolutions);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+    REQUIRE(parallelObjectives[i] == Approx(objectives[i]).epsilon(1e-6));
+}
+
+/**
+ * Make sure that the path works with the SGD family, keeping the Adam moments
+ * across solves.
+ */
+TEST_CASE("RegularizationPathAdamLogisticRegressionTest",
+    "[RegularizationPathTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+  LogisticRegressionTestData(data, testData, shuffledData, responses,
+      testResponses, shuffledResponses);
+
+  LogisticRegression<> lr(shuffledData, shuffledResponses);
+  const arma::vec lambdas = RegularizationPath<Adam>::LogGrid(1.0, 5, 0.1);
+
+  RegularizationPath<Adam> path;
+  arma::mat coordinates = lr.GetInitialPoint();
+  std::vector<arma::mat> solutions;
+  path.Optimize(lr, lambdas, coordinates, solutions);
+
+  // The optimizer given to the driver is not modified.
+  REQUIRE(path.Optimizer().ResetPolicy() == true);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    const double acc = lr.ComputeAccuracy(testData, testResponses,
+        solutions[i]);
+    REQUIRE(acc == Approx(100.0).epsilon(0.006)); // 0.6% error tolerance.
+  }
+}
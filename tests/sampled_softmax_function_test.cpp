@@ -0,0 +1,86 @@
+/**
+ * @file sampled_softmax_function_test.cpp
+ *
+ * Tests for the sampled softmax function and its alias table sampler.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+#include "test_function_tools.hpp"
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Make sure that the alias table samples from the given distribution.
+ */
+TEST_CASE("AliasTableTest", "[SampledSoftmaxFunctionTest]")
+{
+  AliasTable table(arma::vec("1.0 2.0 3.0 4.0 0.0"));
+
+  arma::vec counts(5, arma::fill::zeros);
+  const size_t samples = 100000;
+  for (size_t i = 0; i < samples; ++i)
+    counts[table.Sample()] += 1.0;
+  counts /= samples;
+
+  REQUIRE(counts[0] == Approx(0.1).margin(0.01));
+  REQUIRE(counts[1] == Approx(0.2).margin(0.01));
+  REQUIRE(counts[2] == Approx(0.3).margin(0.01));
+  REQUIRE(counts[3] == Approx(0.4).margin(0.01));
+  REQUIRE(counts[4] == 0.0);
+}
+
+/**
+ * Train a softmax classifier with the sampled softmax objective and sparse
+ * gradients, and make sure that it classifies the training data well.
+ */
+TEST_CASE("SampledSoftmaxSGDTest", "[SampledSoftmaxFunctionTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  SoftmaxTestData(data, labels, 50, 5000);
+
+  SampledSoftmaxFunction f(data, labels, 50, 10, 0.0);
+
+  arma::mat coordinates = f.GetInitialPoint();
+  const double initialObjective = f.ExactEvaluate(coordinates);
+
+  StandardSGD s(0.01, 10, 20 * data.n_cols, -1, true);
+  s.Optimize<SampledSoftmaxFunction, arma::mat, arma::sp_mat>(f,
+      coordinates);
+
+  REQUIRE(f.ExactEvaluate(coordinates) < 0.1 * initialObjective);
+
+  arma::Row<size_t> predictions;
+  f.Classify(data, coordinates, predictions);
+  const double accuracy = arma::accu(predictions == labels) /
+      (double) labels.n_elem;
+  REQUIRE(accuracy > 0.9);
+}
+
+/**
+ * Make sure that the whole-function objective is a sampled estimate that is
+ * close to the exact objective when many classes are sampled.
+ */
+TEST_CASE("SampledSoftmaxEvaluateTest", "[SampledSoftmaxFunctionTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  SoftmaxTestData(data, labels, 20, 2000);
+
+  SampledSoftmaxFunction f(data, labels, 20, 5000, 0.01);
+  const arma::mat parameters = 0.1 * arma::randn<arma::mat>(20, data.n_rows);
+
+  const double exact = f.ExactEvaluate(parameters);
+  REQUIRE(f.Evaluate(parameters) == Approx(exact).epsilon(0.05));
+
+  // With few sampled classes, the estimate is stochastic but still finite.
+  f.NumSampled() = 2;
+  REQUIRE(std::isfinite(f.Evaluate(parameters)));
+}
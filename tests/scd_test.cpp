@@ -263,3 +263,167 @@ TEST_CASE("SoftmaxRegressionFunctionPartialGradientTest", "[SCDTest]")
     CheckMatrices(arma::mat(gradient.col(j)), arma::mat(fGrad.col(j)));
   }
 }
+
+// Create a synthetic Lasso problem with normalized features (so that a step
+// size of 1 minimizes exactly along each coordinate) and a sparse solution.
+static void CreateLassoProblem(arma::mat& predictors,
+                               arma::rowvec& responses,
+                               const size_t features = 300,
+                               const size_t points = 100)
+{
+  predictors.randn(features, points);
+  predictors.each_col() /= arma::sqrt(arma::sum(arma::square(predictors), 1) /
+      points);
+
+  arma::rowvec coefficients(features, arma::fill::zeros);
+  coefficients.subvec(0, 4) = arma::rowvec("3.0 -2.0 1.5 -1.0 2.5");
+  responses = coefficients * predictors +
+      0.1 * arma::randn<arma::rowvec>(points);
+}
+
+// Check the KKT conditions of the L1-regularized problem.
+static void CheckLassoKKT(const LassoFunction& f,
+                          const arma::mat& coordinates,
+                          const double lambda)
+{
+  arma::mat gradient;
+  f.Gradient(coordinates, gradient);
+  for (size_t j = 0; j < f.NumFeatures(); ++j)
+  {
+    if (coordinates(0, j) == 0.0)
+    {
+      REQUIRE(std::abs(gradient(0, j)) <= lambda + 1e-3);
+    }
+    else
+    {
+      const double sign = (coordinates(0, j) > 0.0) ? 1.0 : -1.0;
+      REQUIRE(gradient(0, j) == Approx(-lambda * sign).margin(1e-3));
+    }
+  }
+}
+
+/**
+ * Make sure that ScreenedSCD finds the same Lasso solution with and without
+ * screening, and that the screening rules discard features.
+ */
+TEST_CASE("ScreenedSCDLassoTest", "[SCDTest]")
+{
+  arma::mat predictors;
+  arma::rowvec responses;
+  CreateLassoProblem(predictors, responses);
+
+  LassoFunction f(predictors, responses);
+  const double lambda = 0.1 * f.LambdaMax();
+
+  ScreenedSCD screened(lambda, 1.0, 0, 1e-8);
+  arma::mat screenedIterate = f.GetInitialPoint();
+  const double screenedObjective = screened.Optimize(f, screenedIterate);
+
+  ScreenedSCD plain(lambda, 1.0, 0, 1e-8, 10, false, false);
+  arma::mat plainIterate = f.GetInitialPoint();
+  const double plainObjective = plain.Optimize(f, plainIterate);
+
+  REQUIRE(screenedObjective == Approx(plainObjective).epsilon(1e-5));
+  REQUIRE(f.DualityGap(screenedIterate, lambda) <= 1e-8);
+  CheckLassoKKT(f, screenedIterate, lambda);
+  for (size_t j = 0; j < f.NumFeatures(); ++j)
+    REQUIRE(screenedIterate(0, j) == Approx(plainIterate(0, j)).margin(1e-3));
+
+  // Most of the features are zero, so they should have been screened out.
+  REQUIRE(screened.NumDiscarded() > f.NumFeatures() / 2);
+  REQUIRE(screened.WorkingSetSize() < f.NumFeatures() / 2);
+  REQUIRE(plain.NumDiscarded() == 0);
+  REQUIRE(plain.WorkingSetSize() == f.NumFeatures());
+}
+
+/**
+ * Solve a sequence of elastic net problems with decreasing penalties and warm
+ * starts, so that the sequential strong rule is used.
+ */
+TEST_CASE("ScreenedSCDElasticNetWarmStartTest", "[SCDTest]")
+{
+  arma::mat predictors;
+  arma::rowvec responses;
+  CreateLassoProblem(predictors, responses);
+
+  // With the L2 penalty, the exact coordinate step is 1 / (1 + l2).
+  const double l2 = 0.1;
+  LassoFunction f(predictors, responses, l2);
+
+  ScreenedSCD s(f.LambdaMax(), 1.0 / (1.0 + l2), 0, 1e-8);
+  arma::mat iterate = f.GetInitialPoint();
+
+  // At lambda_max, the solution is zero.
+  s.Optimize(f, iterate);
+  REQUIRE(arma::accu(arma::abs(iterate)) == Approx(0.0).margin(1e-10));
+
+  for (size_t k = 1; k <= 5; ++k)
+  {
+    s.Lambda() *= 0.6;
+    s.Optimize(f, iterate);
+    REQUIRE(s.PreviousLambda() == s.Lambda());
+    REQUIRE(f.DualityGap(iterate, s.Lambda()) <= 1e-8);
+    CheckLassoKKT(f, iterate, s.Lambda());
+  }
+
+  // The solution for the final penalty should not be trivially zero.
+  REQUIRE(arma::accu(iterate != 0) > 0);
+}
+
+/**
+ * A callback that counts the calls to its Gradient() hook.
+ */
+class GradientCountCallback
+{
+ public:
+  GradientCountCallback() : calls(0) { }
+
+  template<typename OptimizerType, typename FunctionType, typename MatType,
+           typename GradType>
+  void Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const GradType& /* gradient */)
+  {
+    ++calls;
+  }
+
+  size_t calls;
+};
+
+/**
+ * Make sure that ScreenedSCD passes the partial gradients to the callbacks.
+ */
+TEST_CASE("ScreenedSCDGradientCallbackTest", "[SCDTest]")
+{
+  arma::mat predictors;
+  arma::rowvec responses;
+  CreateLassoProblem(predictors, responses);
+
+  LassoFunction f(predictors, responses);
+  ScreenedSCD s(0.1 * f.LambdaMax(), 1.0, 1000, 1e-8);
+  arma::mat iterate = f.GetInitialPoint();
+
+  GradientCountCallback callback;
+  s.Optimize(f, iterate, callback);
+  REQUIRE(callback.calls > 0);
+}
+
+/**
+ * Make sure that ScreenedSCD terminates when the working set is empty, even if
+ * the tolerance cannot be reached.
+ */
+TEST_CASE("ScreenedSCDEmptyWorkingSetTest", "[SCDTest]")
+{
+  arma::mat predictors;
+  arma::rowvec responses;
+  CreateLassoProblem(predictors, responses);
+
+  LassoFunction f(predictors, responses);
+  ScreenedSCD s(2.0 * f.LambdaMax(), 1.0, 0, -1.0);
+  arma::mat iterate = f.GetInitialPoint();
+
+  s.Optimize(f, iterate);
+  REQUIRE(s.WorkingSetSize() == 0);
+  REQUIRE(arma::accu(arma::abs(iterate)) == 0.0);
+}
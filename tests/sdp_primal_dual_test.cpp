@@ -282,6 +282,24 @@ TEST_CASE("SmallMaxCutSdp","[SdpPrimalDualTest]")
   SolveMaxCutPositiveSDP(sdp);
 }
 
+TEST_CASE("SmallMaxCutSdpIterativeSchur", "[SdpPrimalDualTest]")
+{
+  auto sdp = ConstructMaxCutSDPFromLaplacian("data/r10.txt");
+
+  arma::mat X, Z;
+  arma::mat ysparse, ydense;
+  ydense.set_size(0);
+
+  // Strictly feasible starting point.
+  X.eye(sdp.N(), sdp.N());
+  ysparse = -1.1 * arma::vec(arma::sum(arma::abs(sdp.C()), 0).t());
+  Z = -arma::diagmat(ysparse) + sdp.C();
+
+  PrimalDualSolver<> solver(1000, 0.99, 1e-7, 1e-7, 1e-7, 100, 1e-12);
+  solver.Optimize(sdp, X, ysparse, ydense, Z);
+  REQUIRE(CheckKKT(sdp, X, ysparse, ydense, Z) == true);
+}
+
 // This test is deprecated and can be removed in ensmallen 2.10.0.
 TEST_CASE("DeprecatedSmallLovaszThetaSdp", "[SdpPrimalDualTest]")
 {
@@ -582,3 +600,143 @@ TEST_CASE("CorrelationCoeffToySdp","[SdpPrimalDualTest]")
   REQUIRE(success == true);
   REQUIRE(obj == Approx(2 * (-0.978)).epsilon(1e-5));
 }
+
+/**
+ * Make sure that the matrix-free application of the symmetric Kronecker
+ * operator gives the same result as the explicitly formed operator.
+ */
+TEST_CASE("SymKronIdApplyTest", "[SdpPrimalDualTest]")
+{
+  const size_t n = 6;
+  arma::mat a = arma::randu<arma::mat>(n, n);
+  a = a + a.t();
+  arma::mat x = arma::randu<arma::mat>(n, n);
+  x = x + x.t();
+
+  arma::mat op, sx, expected, result;
+  math::SymKronId(a, op);
+  math::Svec(x, sx);
+  expected = op * sx;
+
+  math::SymKronIdApply(a, sx, result);
+  REQUIRE(result.n_elem == expected.n_elem);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(result(i) == Approx(expected(i)).epsilon(1e-7).margin(1e-10));
+
+  // Smat() should invert Svec().
+  arma::mat xRecovered;
+  math::Smat(sx, xRecovered);
+  REQUIRE(arma::abs(xRecovered - x).max() == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Make sure that the cached-eigendecomposition Lyapunov solver gives the same
+ * solutions as arma::syl(), both for single and batched right-hand sides.
+ */
+TEST_CASE("LyapunovSolverTest", "[SdpPrimalDualTest]")
+{
+  const size_t n = 8;
+  const size_t k = 5;
+  arma::mat a = arma::randu<arma::mat>(n, n);
+  a = a * a.t() + n * arma::eye<arma::mat>(n, n);
+
+  LyapunovSolver<> lyapunov;
+  REQUIRE(lyapunov.Factorize(a) == true);
+
+  arma::cube h(n, n, k);
+  for (size_t i = 0; i < k; ++i)
+  {
+    h.slice(i) = arma::randu<arma::mat>(n, n);
+    h.slice(i) = h.slice(i) + h.slice(i).t();
+  }
+
+  arma::cube x = h;
+  lyapunov.SolveBatch(x);
+
+  for (size_t i = 0; i < k; ++i)
+  {
+    arma::mat expected, single;
+    arma::syl(expected, a, a, arma::mat(-h.slice(i)));
+    lyapunov.Solve(single, h.slice(i));
+
+    REQUIRE(arma::abs(single - expected).max() == Approx(0.0).margin(1e-8));
+    REQUIRE(arma::abs(x.slice(i) - expected).max() ==
+        Approx(0.0).margin(1e-8));
+  }
+}
+
+/**
+ * Make sure that the ADMM solver finds the same max-cut SDP objective as the
+ * primal-dual solver, with a feasible and PSD solution.
+ */
+TEST_CASE("ADMMSmallMaxCutSdp", "[SdpPrimalDualTest]")
+{
+  auto sdp = ConstructMaxCutSDPFromLaplacian("data/r10.txt");
+
+  arma::mat X, Z, ysparse, ydense;
+  ydense.set_size(0);
+  X.eye(sdp.N(), sdp.N());
+  ysparse = -1.1 * arma::vec(arma::sum(arma::abs(sdp.C()), 0).t());
+  Z = -arma::diagmat(ysparse) + sdp.C();
+  PrimalDualSolver<> primalDual;
+  const double expected = primalDual.Optimize(sdp, X, ysparse, ydense, Z);
+
+  ADMMSolver solver(20000, 1e-7);
+  arma::mat admmX = arma::eye<arma::mat>(sdp.N(), sdp.N());
+  const double objective = solver.Optimize(sdp, admmX);
+
+  REQUIRE(objective == Approx(expected).epsilon(1e-4));
+  REQUIRE(arma::abs(admmX.diag() - 1.0).max() == Approx(0.0).margin(1e-4));
+
+  arma::vec evals = arma::eig_sym(admmX);
+  REQUIRE(evals.min() >= -1e-6);
+}
+
+/**
+ * Make sure that partial projections with a warm started subspace iteration
+ * give the same solution as full eigendecompositions on a low-rank problem.
+ */
+TEST_CASE("ADMMLowRankProjectionMaxCutSdp", "[SdpPrimalDualTest]")
+{
+  UndirectedGraph g;
+  UndirectedGraph::ErdosRenyiRandomGraph(g, 40, 0.2, true);
+  auto sdp = ConstructMaxCutSDPFromGraph(g);
+
+  ADMMSolver full(20000, 1e-6);
+  arma::mat fullX = arma::eye<arma::mat>(sdp.N(), sdp.N());
+  const double expected = full.Optimize(sdp, fullX);
+
+  // The rank of the max-cut SDP solution is at most sqrt(2 n).
+  ADMMSolver partial(20000, 1e-6, 1.0, 1.6, true, 10);
+  arma::mat partialX = arma::eye<arma::mat>(sdp.N(), sdp.N());
+  const double objective = partial.Optimize(sdp, partialX);
+
+  REQUIRE(objective == Approx(expected).epsilon(1e-3));
+  REQUIRE(arma::abs(partialX.diag() - 1.0).max() == Approx(0.0).margin(1e-3));
+}
+
+/**
+ * Warm starting the ADMM solver from its own solution should converge in far
+ * fewer iterations; invalid parameters should throw.
+ */
+TEST_CASE("ADMMWarmStartSdp", "[SdpPrimalDualTest]")
+{
+  auto sdp = ConstructMaxCutSDPFromLaplacian("data/r10.txt");
+
+  ADMMSolver solver(20000, 1e-6);
+  arma::mat X = arma::eye<arma::mat>(sdp.N(), sdp.N());
+  arma::mat Z = arma::zeros<arma::mat>(sdp.N(), sdp.N());
+  arma::mat ysparse, ydense;
+  const double objective = solver.Optimize(sdp, X, ysparse, ydense, Z);
+  const size_t coldIterations = solver.Iterations();
+
+  REQUIRE(ysparse.n_elem == sdp.NumSparseConstraints());
+  REQUIRE(ydense.n_elem == 0);
+
+  const double warmObjective = solver.Optimize(sdp, X, ysparse, ydense, Z);
+  REQUIRE(warmObjective == Approx(objective).epsilon(1e-4));
+  REQUIRE(solver.Iterations() < coldIterations);
+
+  solver.Relaxation() = 2.0;
+  REQUIRE_THROWS_AS(solver.Optimize(sdp, X), std::invalid_argument);
+}
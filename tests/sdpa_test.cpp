@@ -0,0 +1,245 @@
+/**
+ * @file sdpa_test.cpp
+ *
+ * Test the SDPA reader and writer.
+ *
+ * ensmallen is free software; you may redistribute it and/or modify it under
+ * the terms of the 3-clause BSD license.  You should have received a copy of
+ * the 3-clause BSD license along with ensmallen.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include <ensmallen.hpp>
+#include "catch.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+using namespace ens;
+using namespace ens::test;
+
+/**
+ * Names of files in the temporary directory; the files are removed when the
+ * object goes out of scope (even if a test fails).
+ */
+class TemporaryFiles
+{
+ public:
+  ~TemporaryFiles()
+  {
+    for (size_t i = 0; i < files.size(); ++i)
+      std::remove(files[i].c_str());
+  }
+
+  //! Return the path of the given file in the temporary directory.
+  std::string operator()(const std::string& name)
+  {
+    const char* dir = std::getenv("TMPDIR");
+    if (dir == NULL)
+      dir = std::getenv("TEMP");
+    if (dir == NULL)
+      dir = std::getenv("TMP");
+#ifdef _WIN32
+    const std::string directory = (dir == NULL) ? "." : dir;
+#else
+    const std::string directory = (dir == NULL) ? "/tmp" : dir;
+#endif
+
+    files.push_back(directory + "/ensmallen_" + name);
+    return files.back();
+  }
+
+ private:
+  std::vector<std::string> files;
+};
+
+// Check that two SDPs with sparse constraints are the same.
+static void CheckSameSDP(const SDP<arma::sp_mat>& a,
+                         const SDP<arma::sp_mat>& b)
+{
+  REQUIRE(a.N() == b.N());
+  REQUIRE(a.NumSparseConstraints() == b.NumSparseConstraints());
+  REQUIRE(a.NumDenseConstraints() == 0);
+  REQUIRE(b.NumDenseConstraints() == 0);
+
+  REQUIRE(arma::abs(arma::mat(a.C() - b.C())).max() ==
+      Approx(0.0).margin(1e-12));
+  REQUIRE(arma::abs(a.SparseB() - b.SparseB()).max() ==
+      Approx(0.0).margin(1e-12));
+  for (size_t i = 0; i < a.NumSparseConstraints(); ++i)
+  {
+    REQUIRE(arma::abs(arma::mat(a.SparseA()[i] - b.SparseA()[i])).max() ==
+        Approx(0.0).margin(1e-12));
+  }
+}
+
+/**
+ * Save a random SDP, load it back, and make sure nothing changed.
+ */
+TEST_CASE("SDPARoundTripTest", "[SDPATest]")
+{
+  const size_t n = 12;
+  SDP<arma::sp_mat> sdp(n, 20, 0);
+  sdp.C() = arma::sprandu<arma::sp_mat>(n, n, 0.3);
+  sdp.C() += sdp.C().t();
+  for (size_t i = 0; i < sdp.NumSparseConstraints(); ++i)
+  {
+    sdp.SparseA()[i] = arma::sprandn<arma::sp_mat>(n, n, 0.2);
+    sdp.SparseA()[i] += sdp.SparseA()[i].t();
+  }
+  sdp.SparseB().randn();
+
+  TemporaryFiles tmp;
+  const std::string filename = tmp("sdpa_round_trip.dat-s");
+  SaveSDPA(filename, sdp);
+
+  SDP<arma::sp_mat> loaded;
+  LoadSDPA(filename, loaded);
+  CheckSameSDP(sdp, loaded);
+}
+
+/**
+ * Make sure that comments, separators, blocks (including diagonal blocks) and
+ * the sign of the objective are handled.
+ */
+TEST_CASE("SDPABlockStructureTest", "[SDPATest]")
+{
+  TemporaryFiles tmp;
+  const std::string filename = tmp("sdpa_blocks.dat-s");
+  {
+    std::ofstream out(filename.c_str());
+    out << "\"Two blocks: a 2 x 2 block and a diagonal block of size 2.\"\n"
+        << "* another comment\n"
+        << "2 = mDIM\n"
+        << "2 = nBLOCK\n"
+        << "{2, -2}\n"
+        << "{1.5, -2}\n"
+        << "0 1 1 2 3.0\n"
+        << "0 2 2 2 -1.0\n"
+        << "1 1 1 1 1.0\n"
+        << "1 2 1 1 4.0\n"
+        << "2 1 2 1 0.5\n"
+        << "2 1 2 1 0.25\n";
+  }
+
+  SDP<arma::sp_mat> sdp;
+  LoadSDPA(filename, sdp);
+
+  REQUIRE(sdp.N() == 4);
+  REQUIRE(sdp.NumSparseConstraints() == 2);
+  REQUIRE(sdp.SparseB()[0] == Approx(1.5));
+  REQUIRE(sdp.SparseB()[1] == Approx(-2.0));
+
+  // C is -F0, and symmetric.
+  REQUIRE(sdp.C()(0, 1) == Approx(-3.0));
+  REQUIRE(sdp.C()(1, 0) == Approx(-3.0));
+  REQUIRE(sdp.C()(3, 3) == Approx(1.0));
+  REQUIRE(sdp.C().n_nonzero == 3);
+
+  // The diagonal block starts after the first block.
+  REQUIRE(sdp.SparseA()[0](0, 0) == Approx(1.0));
+  REQUIRE(sdp.SparseA()[0](2, 2) == Approx(4.0));
+
+  // Entries of the lower triangle are moved to the upper triangle and mirrored,
+  // and repeated entries are summed.
+  REQUIRE(sdp.SparseA()[1](0, 1) == Approx(0.75));
+  REQUIRE(sdp.SparseA()[1](1, 0) == Approx(0.75));
+  REQUIRE(sdp.SparseA()[1].n_nonzero == 2);
+
+  // Entries outside of a diagonal block are invalid.
+  const std::string invalid = tmp("sdpa_invalid.dat-s");
+  {
+    std::ofstream out(invalid.c_str());
+    out << "1\n1\n-2\n1.0\n1 1 1 2 1.0\n";
+  }
+  REQUIRE_THROWS_AS(LoadSDPA(invalid, sdp), std::runtime_error);
+  REQUIRE_THROWS_AS(LoadSDPA(tmp("sdpa_does_not_exist.dat-s"), sdp),
+      std::runtime_error);
+}
+
+/**
+ * Make sure that the binary cache gives the same SDP as the SDPA file.
+ */
+TEST_CASE("SDPACacheTest", "[SDPATest]")
+{
+  arma::mat edges;
+  if (!edges.load("data/johnson8-4-4.csv", arma::csv_ascii))
+    FAIL("couldn't load data");
+  const SDP<arma::sp_mat> sdp = CreateLovaszThetaSDP(edges.t());
+
+  TemporaryFiles tmp;
+  const std::string filename = tmp("sdpa_cache.dat-s");
+  const std::string cacheFilename = tmp("sdpa_cache.bin");
+  SaveSDPA(filename, sdp);
+  std::remove(cacheFilename.c_str());
+
+  // The first load writes the cache, the second one reads it.
+  SDP<arma::sp_mat> parsed, cached;
+  LoadSDPA(filename, parsed, cacheFilename);
+  REQUIRE(std::ifstream(cacheFilename.c_str()).good());
+  LoadSDPA(filename, cached, cacheFilename);
+
+  CheckSameSDP(sdp, parsed);
+  CheckSameSDP(sdp, cached);
+
+  // Changing a coefficient without changing the size of the file must
+  // invalidate the cache.
+  const std::string small = tmp("sdpa_cache_small.dat-s");
+  const std::string smallCache = tmp("sdpa_cache_small.bin");
+  std::remove(smallCache.c_str());
+  {
+    std::ofstream out(small.c_str());
+    out << "1\n1\n2\n1.0\n0 1 1 1 0.5\n1 1 1 1 1.0\n";
+  }
+  SDP<arma::sp_mat> first, second;
+  LoadSDPA(small, first, smallCache);
+  REQUIRE(first.C()(0, 0) == Approx(-0.5));
+  {
+    std::ofstream out(small.c_str());
+    out << "1\n1\n2\n1.0\n0 1 1 1 0.7\n1 1 1 1 1.0\n";
+  }
+  LoadSDPA(small, second, smallCache);
+  REQUIRE(second.C()(0, 0) == Approx(-0.7));
+}
+
+/**
+ * Emit the max-cut and Lovasz-Theta SDPs of the graphs in data/ as SDPA files,
+ * and make sure they can be read back and solved.
+ */
+TEST_CASE("SDPAGraphProblemsTest", "[SDPATest]")
+{
+  TemporaryFiles tmp;
+  const std::string graphs[] = { "erdosrenyi-n100", "johnson8-4-4" };
+  for (size_t g = 0; g < 2; ++g)
+  {
+    arma::mat edges;
+    if (!edges.load("data/" + graphs[g] + ".csv", arma::csv_ascii))
+      FAIL("couldn't load data");
+    edges = edges.t();
+
+    const SDP<arma::sp_mat> maxCut = CreateMaxCutSDP(edges);
+    const SDP<arma::sp_mat> lovasz = CreateLovaszThetaSDP(edges);
+    const std::string maxCutFilename = tmp(graphs[g] + "-maxcut.dat-s");
+    const std::string lovaszFilename = tmp(graphs[g] + "-lovasz.dat-s");
+    SaveSDPA(maxCutFilename, maxCut);
+    SaveSDPA(lovaszFilename, lovasz);
+
+    SDP<arma::sp_mat> loaded;
+    LoadSDPA(maxCutFilename, loaded);
+    CheckSameSDP(maxCut, loaded);
+    LoadSDPA(lovaszFilename, loaded);
+    CheckSameSDP(lovasz, loaded);
+  }
+
+  // The Lovasz-Theta SDP of johnson8-4-4 has objective -14 (see
+  // lrsdp_test.cpp).
+  SDP<arma::sp_mat> sdp;
+  LoadSDPA(tmp("johnson8-4-4-lovasz.dat-s"), sdp);
+
+  arma::mat X, Z, ysparse, ydense;
+  sdp.GetInitialPoints(X, ysparse, ydense, Z);
+  PrimalDualSolver<> solver;
+  const double objective = solver.Optimize(sdp, X, ysparse, ydense, Z);
+  REQUIRE(objective == Approx(-14.0).epsilon(1e-3));
+}
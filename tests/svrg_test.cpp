@@ -79,6 +79,34 @@ TEST_CASE("SVRGBBLogisticRegressionTest", "[SVRGTest]")
   }
 }
 
+/**
+ * Run SVRG_BB with alternating BB1/BB2 step sizes on logistic regression and
+ * make sure the results are acceptable.
+ */
+TEST_CASE("SVRGBBAlternateLogisticRegressionTest", "[SVRGTest]")
+{
+  arma::mat data, testData, shuffledData;
+  arma::Row<size_t> responses, testResponses, shuffledResponses;
+
+  LogisticRegressionTestData(data, testData, shuffledData,
+      responses, testResponses, shuffledResponses);
+
+  SVRG_BB optimizer(0.005, 40, 300, 0, 1e-5, true, SVRGUpdate(),
+      BarzilaiBorweinDecay(0.1, 1e-7, true, 1e-4));
+  LogisticRegression<> lr(shuffledData, shuffledResponses, 0.5);
+
+  arma::mat coordinates = lr.GetInitialPoint();
+  optimizer.Optimize(lr, coordinates);
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(data, responses, coordinates);
+  REQUIRE(acc == Approx(100.0).epsilon(0.015)); // 1.5% error tolerance.
+
+  const double testAcc = lr.ComputeAccuracy(testData, testResponses,
+      coordinates);
+  REQUIRE(testAcc == Approx(100.0).epsilon(0.015)); // 1.5% error tolerance.
+}
+
 /**
  * Run SVRG on logistic regression and make sure the results are acceptable.
  * Use arma::fmat.
@@ -213,3 +241,84 @@ TEST_CASE("SVRGBBLogisticRegressionSpMatTest", "[SVRGTest]")
 }
 
 #endif
+
+/**
+ * Least squares test function with sparse examples, 0.5 * (a_i^T x - b_i)^2 +
+ * 0.5 * lambda * ||x||^2 for each example a_i, whose gradient is sparse if
+ * lambda is 0.
+ */
+class SparseLeastSquaresTestFunction
+{
+ public:
+  SparseLeastSquaresTestFunction(const arma::sp_mat& a,
+                                 const arma::vec& b,
+                                 const double lambda) :
+      a(a), b(b), lambda(lambda)
+  { }
+
+  size_t NumFunctions() const { return a.n_cols; }
+
+  // The tests below visit the examples in order.
+  void Shuffle() { }
+
+  double Evaluate(const arma::mat& x,
+                  const size_t begin,
+                  const size_t batchSize) const
+  {
+    double objective = 0.5 * lambda * batchSize * arma::dot(x, x);
+    for (size_t i = begin; i < begin + batchSize; ++i)
+    {
+      const double r = arma::dot(x, a.col(i)) - b(i);
+      objective += 0.5 * r * r;
+    }
+    return objective;
+  }
+
+  template<typename GradType>
+  void Gradient(const arma::mat& x,
+                const size_t begin,
+                GradType& gradient,
+                const size_t batchSize) const
+  {
+    gradient.zeros(x.n_rows, x.n_cols);
+    for (size_t i = begin; i < begin + batchSize; ++i)
+      gradient += (arma::dot(x, a.col(i)) - b(i)) * a.col(i);
+
+    if (lambda > 0.0)
+      gradient += GradType(lambda * batchSize * x);
+  }
+
+ private:
+  const arma::sp_mat& a;
+  const arma::vec& b;
+  double lambda;
+};
+
+/**
+ * Make sure that SVRG with lazy updates and sparse gradients takes the same
+ * steps as SVRG with dense updates, with and without L2 regularization.
+ */
+TEST_CASE("SVRGLazyUpdateSparseGradientTest", "[SVRGTest]")
+{
+  const arma::sp_mat a = arma::sprandu<arma::sp_mat>(100, 500, 0.05);
+  const arma::vec b = arma::randn<arma::vec>(500);
+
+  for (const double lambda : { 0.0, 0.1 })
+  {
+    // The tolerance is negative so that both optimizers run all iterations.
+    SVRG denseOptimizer(0.01, 10, 5, 0, -1.0, false);
+    SparseLeastSquaresTestFunction denseFunction(a, b, lambda);
+    arma::mat denseCoordinates(100, 1, arma::fill::zeros);
+    denseOptimizer.Optimize(denseFunction, denseCoordinates);
+
+    SVRGLazy lazyOptimizer(0.01, 10, 5, 0, -1.0, false,
+        SVRGLazyUpdate(lambda));
+    SparseLeastSquaresTestFunction sparseFunction(a, b, 0.0);
+    arma::mat lazyCoordinates(100, 1, arma::fill::zeros);
+    lazyOptimizer.Optimize<SparseLeastSquaresTestFunction, arma::mat,
+        arma::sp_mat>(sparseFunction, lazyCoordinates);
+
+    REQUIRE(arma::approx_equal(denseCoordinates, lazyCoordinates, "absdiff",
+        1e-8));
+  }
+}
@@ -79,6 +79,33 @@ inline void LogisticRegressionTestData(MatType& data,
   }
 }
 
+/**
+ * Create a dataset of well-separated Gaussian clusters, one per class, for
+ * softmax classifiers.  A constant feature of 1 is appended to each point, so
+ * that the weights of a linear classifier include an intercept.
+ *
+ * @param data Matrix object to store the data into.
+ * @param labels Row object to store the labels into.
+ * @param numClasses Number of classes.
+ * @param numPoints Number of points.
+ */
+inline void SoftmaxTestData(arma::mat& data,
+                            arma::Row<size_t>& labels,
+                            const size_t numClasses,
+                            const size_t numPoints)
+{
+  const arma::mat centers = 10.0 * arma::randn<arma::mat>(5, numClasses);
+
+  data.set_size(6, numPoints);
+  labels.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    labels(i) = i % numClasses;
+    data.submat(0, i, 4, i) = centers.col(labels(i)) + arma::randn(5);
+    data(5, i) = 1.0;
+  }
+}
+
 // Check the values of two matrices.
 template<typename MatType>
 inline void CheckMatrices(const MatType& a,